@@ -48,6 +48,8 @@ endif()
 if( MSVC )
     # C4201: anonymous structs/unions
     set( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} /W4 /MP /wd4201 /experimental:external /external:W0 /external:templates-" )
+    # the trigonometry tables in core/angle.h are evaluated at compile time
+    set( CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} /constexpr:steps10000000" )
 
     string( REPLACE "/Ob0" "/Ob1" CMAKE_CXX_FLAGS_DEBUG "${CMAKE_CXX_FLAGS_DEBUG}" )
     set( CMAKE_CXX_FLAGS_DEBUG "${CMAKE_CXX_FLAGS_DEBUG} /RTC1" )
@@ -0,0 +1,32 @@
+struct AnimatedTile {
+    vec4 uv12;
+    vec4 uv34;
+    float textureIndex;
+    float _pad[3];
+};
+
+layout(std430, binding=6) readonly restrict buffer b_animatedTiles {
+    AnimatedTile animatedTiles[];
+};
+
+vec3 get_tex_coord()
+{
+    if (a_animatedTile <= 0) {
+        return vec3(a_texCoord.xy, a_texCoord.z + a_textureIndex);
+    }
+
+    int idx = int(a_animatedTile) - 1;
+    AnimatedTile tile = animatedTiles[idx / 4];
+    vec2 uvs[4] = vec2[4](tile.uv12.xy, tile.uv12.zw, tile.uv34.xy, tile.uv34.zw);
+    return vec3(uvs[idx % 4], tile.textureIndex);
+}
+
+vec4 get_quad_uv12()
+{
+    return a_animatedTile <= 0 ? a_quadUv12 : animatedTiles[(int(a_animatedTile) - 1) / 4].uv12;
+}
+
+vec4 get_quad_uv34()
+{
+    return a_animatedTile <= 0 ? a_quadUv34 : animatedTiles[(int(a_animatedTile) - 1) / 4].uv34;
+}
@@ -1,4 +1,5 @@
 #include "vtx_input.glsl"
+#include "animated_tiles.glsl"
 #include "transform_interface.glsl"
 #include "camera_interface.glsl"
 
@@ -6,13 +7,13 @@
 
 void main()
 {
-    gpi.texCoord = a_texCoord;
+    gpi.texCoord = get_tex_coord();
     gpi.color = a_color;
 
     #ifdef SKELETAL
-    vec4 vtx = camera.viewProjection * modelTransform.m * boneTransform.m[int(a_boneIndex)] * vec4(a_position, 1);
+    vec4 vtx = camera.viewProjection * get_model_matrix() * boneTransform.m[int(a_boneIndex)] * vec4(a_position, 1);
     #else
-    vec4 vtx = camera.viewProjection * modelTransform.m * vec4(a_position, 1);
+    vec4 vtx = camera.viewProjection * get_model_matrix() * vec4(a_position, 1);
     #endif
     vtx.z = (vtx.z / vtx.w + 1/512.0) * vtx.w;// depth offset
     gl_Position = vtx;
@@ -1,8 +1,11 @@
-#include "vtx_input.glsl"
 #include "transform_interface.glsl"
 #include "time_uniform.glsl"
 #include "noise.glsl"
 
+layout(location=1) uniform vec3 u_bboxMin;
+layout(location=2) uniform vec3 u_cells;
+layout(location=3) uniform float u_spacing;
+
 out DustVSInterface {
     float alpha;
     float size;
@@ -11,10 +14,30 @@ out DustVSInterface {
 const float MaxLifetime = 8;
 const float MaxDistance = 256;
 
+// https://jcgt.org/published/0009/03/02/
+uvec3 pcg3d(uvec3 v)
+{
+    v = v * 1664525u + 1013904223u;
+    v.x += v.y * v.z;
+    v.y += v.z * v.x;
+    v.z += v.x * v.y;
+    v ^= v >> 16u;
+    v.x += v.y * v.z;
+    v.y += v.z * v.x;
+    v.z += v.x * v.y;
+    return v;
+}
+
 void main()
 {
-    vec3 n = snoise3(a_position.xyz);
-    vec3 n2 = snoise3(a_position.zxy);
+    // one particle per lattice cell, jittered within its cell
+    ivec3 cells = ivec3(u_cells);
+    ivec3 cell = ivec3(gl_VertexID % cells.x, (gl_VertexID / cells.x) % cells.y, gl_VertexID / (cells.x * cells.y));
+    vec3 jitter = vec3(pcg3d(uvec3(cell))) / 4294967296.0 - 0.5;
+    vec3 base = u_bboxMin + (vec3(cell) + 0.5 + jitter) * u_spacing;
+
+    vec3 n = snoise3(base.xyz);
+    vec3 n2 = snoise3(base.zxy);
 
     float randS = pow(0.5, 0.5 * n.y + 1) * pow(0.5, 1 - (0.5 * n.y + 1));
     vs.size = 0.5 + randS*4;
@@ -23,12 +46,12 @@ void main()
 
     float t = mod(TimeSeconds, particleMaxLifetime);
     float t0 = TimeSeconds - t;
-    vec3 pnoise = snoise3(a_position.xyz + vec3(t0*3, t0*2, t0));
-    vec3 normal = snoise3(a_position.zyx + pnoise);
-    float distance = snoise3(a_position.zyx - pnoise).x * MaxDistance;
+    vec3 pnoise = snoise3(base.xyz + vec3(t0*3, t0*2, t0));
+    vec3 normal = snoise3(base.zyx + pnoise);
+    float distance = snoise3(base.zyx - pnoise).x * MaxDistance;
 
     float lifetime = t / particleMaxLifetime;
     vs.alpha = clamp(min(lifetime, 1.0-lifetime) * 3.0, 0.0, 1.0) * 0.3;
-    vec3 pos = a_position + normal * distance * (t+pnoise.y) / particleMaxLifetime;
-    gl_Position = modelTransform.m * vec4(pos, 1);
+    vec3 pos = base + normal * distance * (t+pnoise.y) / particleMaxLifetime;
+    gl_Position = get_model_matrix() * vec4(pos, 1);
 }
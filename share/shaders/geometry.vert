@@ -1,18 +1,23 @@
 #include "vtx_input.glsl"
+#include "animated_tiles.glsl"
 #include "transform_interface.glsl"
 #include "geometry_pipeline_interface.glsl"
 #include "camera_interface.glsl"
 
 #include "util.glsl"
 
+layout(std430, binding=5) readonly restrict buffer b_quadVertices {
+    vec4 quadVertices[];
+};
+
 void main()
 {
     #ifdef SKELETAL
-    mat4 mm = modelTransform.m * boneTransform.m[int(a_boneIndex)];
+    mat4 mm = get_model_matrix() * boneTransform.m[int(a_boneIndex)];
     #elif SPRITEMODE == 3
     mat4 mm = a_modelMatrix;
     #else
-    mat4 mm = modelTransform.m;
+    mat4 mm = get_model_matrix();
     #endif
     mat4 mv = camera.view * mm;
 
@@ -31,7 +36,7 @@ void main()
     gpi.vertexPos = mvPos.xyz;
     gpi.vertexPosWorld = vec3(mm * vec4(a_position, 1.0));
     gl_Position = camera.projection * mvPos;
-    gpi.texCoord = a_texCoord;
+    gpi.texCoord = get_tex_coord();
     #ifndef ROOM_SHADOWING
     gpi.color = gpi.texCoord.z >= 0 ? a_color : toLinear(a_color);
     #else
@@ -58,23 +63,27 @@ void main()
     }
 
     {
-        gpi.isQuad = a_isQuad;
-
-        mat4 mvp = camera.projection * mv;
+        gpi.isQuad = a_quadIndex;
 
-        vec4 tmp = mvp * vec4(a_quadVert1, 1);
-        gpi.quadVerts[0] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert2, 1);
-        gpi.quadVerts[1] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert3, 1);
-        gpi.quadVerts[2] = vec3(tmp.xy / tmp.w, tmp.w);
-        tmp = mvp * vec4(a_quadVert4, 1);
-        gpi.quadVerts[3] = vec3(tmp.xy / tmp.w, tmp.w);
+        if (a_quadIndex > 0) {
+            mat4 mvp = camera.projection * mv;
+            int quadBase = (int(a_quadIndex) - 1) * 4;
+            for (int i=0; i<4; ++i)
+            {
+                vec4 tmp = mvp * vec4(quadVertices[quadBase + i].xyz, 1);
+                gpi.quadVerts[i] = vec3(tmp.xy / tmp.w, tmp.w);
+            }
+        }
+        else {
+            gpi.quadVerts = vec3[4](vec3(0), vec3(0), vec3(0), vec3(0));
+        }
 
-        gpi.quadUvs[0] = a_quadUv12.xy;
-        gpi.quadUvs[1] = a_quadUv12.zw;
-        gpi.quadUvs[2] = a_quadUv34.xy;
-        gpi.quadUvs[3] = a_quadUv34.zw;
+        vec4 quadUv12 = get_quad_uv12();
+        vec4 quadUv34 = get_quad_uv34();
+        gpi.quadUvs[0] = quadUv12.xy;
+        gpi.quadUvs[1] = quadUv12.zw;
+        gpi.quadUvs[2] = quadUv34.xy;
+        gpi.quadUvs[3] = quadUv34.zw;
     }
 
         #if SPRITEMODE == 3
@@ -3,16 +3,18 @@
 #include "geometry_pipeline_interface.glsl"
 #include "camera_interface.glsl"
 
+layout(location=11) uniform int u_boneCount;
+
 void main()
 {
-    mat4 mm = modelTransform.m * boneTransform.m[int(a_boneIndex)];
+    mat4 mm = get_model_matrix() * boneTransform.m[gl_InstanceID * u_boneCount + int(a_boneIndex)];
     mat4 mv = camera.view * mm;
 
     vec4 mvPos = mv * vec4(a_position, 1.0);
     gpi.vertexPos = mvPos.xyz;
     gpi.vertexPosWorld = vec3(mm * vec4(a_position, 1.0));
     gl_Position = camera.projection * mvPos;
-    gpi.texCoord = a_texCoord;
+    gpi.texCoord = vec3(a_texCoord.xy, a_texCoord.z + a_textureIndex);
     gpi.color = a_color;
 
     gpi.vertexNormalWorld = normalize(mat3(mm) * a_normal);
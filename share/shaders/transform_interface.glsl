@@ -1,6 +1,13 @@
-layout(std140, binding=0) uniform Transform {
-    mat4 m;
-} modelTransform;
+layout(std430, binding=7) readonly restrict buffer Transform {
+    mat4 m[];
+} modelTransforms;
+
+uniform uint u_transformIndex;
+
+mat4 get_model_matrix()
+{
+    return modelTransforms.m[u_transformIndex];
+}
 
 #ifdef SKELETAL
 layout(std140) readonly restrict buffer BoneTransform {
@@ -1,17 +1,22 @@
 #include "ui_pipeline_interface.glsl"
 
 layout(bindless_sampler) uniform sampler2DArray u_input;
+layout(bindless_sampler) uniform sampler2D u_glyphs;
 layout(location=0) out vec4 out_color;
 
 void main()
 {
     if (upi.texCoord.z >= 0) {
-        out_color = texture(u_input, upi.texCoord);
+        out_color = texture(u_input, upi.texCoord) * upi.alpha;
+    }
+    else if (upi.texCoord.z < -1.5) {
+        // glyph atlas coverage, the color is passed as a uniform gradient
+        out_color = upi.topLeft * texture(u_glyphs, upi.texCoord.xy).r;
     }
     else {
+        // corner colors are already premultiplied
         vec4 top = mix(upi.topLeft, upi.topRight, upi.texCoord.x);
         vec4 bottom = mix(upi.bottomLeft, upi.bottomRight, upi.texCoord.x);
         out_color = mix(top, bottom, upi.texCoord.y);
     }
-    out_color *= upi.alpha;
 }
@@ -7,11 +7,12 @@ layout(location=3) in vec3 a_texCoord;
 
 layout(location=4) in float a_boneIndex;
 
-layout(location=5) in float a_isQuad;
-layout(location=6) in vec3 a_quadVert1;
-layout(location=7) in vec3 a_quadVert2;
-layout(location=8) in vec3 a_quadVert3;
-layout(location=9) in vec3 a_quadVert4;
+// 1-based index into b_quadVertices, 0 if the vertex isn't part of a distorted quad
+layout(location=5) in float a_quadIndex;
+// added to a_texCoord.z by vertex layouts that store the texture index separately
+layout(location=6) in float a_textureIndex;
+// 1 + 4 * slot + corner of the tile in b_animatedTiles, 0 if the vertex isn't part of an animated tile
+layout(location=7) in float a_animatedTile;
 layout(location=10) in vec4 a_quadUv12;
 layout(location=11) in vec4 a_quadUv34;
 
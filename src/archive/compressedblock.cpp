@@ -0,0 +1,85 @@
+#include "compressedblock.h"
+
+#include <array>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+// --- boost must be included before these, otherwise linking on (at least) windows fails
+#include <archive.h>
+#include <archive_entry.h>
+
+namespace
+{
+la_ssize_t appendToVector(archive* /*a*/, void* clientData, const void* buffer, size_t length)
+{
+  auto& dst = *static_cast<std::vector<uint8_t>*>(clientData);
+  const auto* src = static_cast<const uint8_t*>(buffer);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  dst.insert(dst.end(), src, src + length);
+  return gsl::narrow<la_ssize_t>(length);
+}
+} // namespace
+
+std::vector<uint8_t> compressXz(const gsl::span<const uint8_t>& data)
+{
+  std::vector<uint8_t> result;
+
+  const gsl::not_null<archive*> a{archive_write_new()};
+  const auto freeArchive = gsl::finally(
+    [&a]()
+    {
+      archive_write_free(a.get());
+    });
+  gsl_Assert(archive_write_set_format_raw(a.get()) == ARCHIVE_OK);
+  gsl_Assert(archive_write_add_filter_xz(a.get()) == ARCHIVE_OK);
+  // blocks are small, so a high preset would only waste memory on the dictionary
+  gsl_Assert(archive_write_set_options(a.get(), "compression-level=2") == ARCHIVE_OK);
+  gsl_Assert(archive_write_set_bytes_per_block(a.get(), 0) == ARCHIVE_OK);
+  gsl_Assert(archive_write_open(a.get(), &result, nullptr, &appendToVector, nullptr) == ARCHIVE_OK);
+
+  const gsl::not_null<archive_entry*> entry{archive_entry_new()};
+  const auto freeEntry = gsl::finally(
+    [&entry]()
+    {
+      archive_entry_free(entry.get());
+    });
+  archive_entry_copy_pathname(entry.get(), "data");
+  archive_entry_set_size(entry.get(), gsl::narrow<la_int64_t>(data.size()));
+  archive_entry_set_filetype(entry.get(), AE_IFREG);
+  gsl_Assert(archive_write_header(a.get(), entry.get()) == ARCHIVE_OK);
+  gsl_Assert(archive_write_data(a.get(), data.data(), data.size()) == gsl::narrow<la_ssize_t>(data.size()));
+  gsl_Assert(archive_write_close(a.get()) == ARCHIVE_OK);
+
+  return result;
+}
+
+std::vector<uint8_t> decompressBlock(const gsl::span<const uint8_t>& data)
+{
+  const gsl::not_null<archive*> a{archive_read_new()};
+  const auto freeArchive = gsl::finally(
+    [&a]()
+    {
+      archive_read_free(a.get());
+    });
+  gsl_Assert(archive_read_support_filter_all(a.get()) == ARCHIVE_OK);
+  gsl_Assert(archive_read_support_format_raw(a.get()) == ARCHIVE_OK);
+  if(archive_read_open_memory(a.get(), data.data(), data.size()) != ARCHIVE_OK)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to open compressed block"));
+
+  archive_entry* entry = nullptr;
+  if(archive_read_next_header(a.get(), &entry) != ARCHIVE_OK)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to read compressed block header"));
+
+  std::vector<uint8_t> result;
+  std::array<uint8_t, 8192> buffer{};
+  while(true)
+  {
+    const auto read = archive_read_data(a.get(), buffer.data(), buffer.size());
+    if(read == 0)
+      break;
+    if(read < 0)
+      BOOST_THROW_EXCEPTION(std::runtime_error("Failed to decompress block"));
+    result.insert(result.end(), buffer.begin(), std::next(buffer.begin(), read));
+  }
+
+  return result;
+}
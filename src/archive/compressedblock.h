@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <gsl/gsl-lite.hpp>
+#include <vector>
+
+// compresses a memory block into a raw xz stream
+[[nodiscard]] extern std::vector<uint8_t> compressXz(const gsl::span<const uint8_t>& data);
+
+// decompresses a raw stream created by compressXz; throws on malformed input
+[[nodiscard]] extern std::vector<uint8_t> decompressBlock(const gsl::span<const uint8_t>& data);
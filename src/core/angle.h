@@ -4,7 +4,9 @@
 #include "serialization/serialization_fwd.h"
 #include "units.h"
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <glm/ext/scalar_constants.hpp>
@@ -22,14 +24,124 @@ class World;
 
 namespace core
 {
+namespace detail
+{
+/*
+ * The trigonometric functions use tables over the native angle domain, an angle's 32 bit storage being a fraction of
+ * a full rotation. The tables are evaluated at compile time and interpolated with integer arithmetic, which makes the
+ * results bit-identical across compilers and CPUs.
+ */
+
+//! Number of table segments per quarter rotation, as a power of two.
+constexpr uint32_t TrigTableBits = 10;
+constexpr uint32_t TrigTableSegments = 1u << TrigTableBits;
+//! A quarter rotation in angle storage units, and the fixed point scale of the table values.
+constexpr uint32_t QuarterRotation = 1u << 30u;
+//! One more entry than needed, so that interpolation never needs a bounds check.
+using TrigTable = std::array<int32_t, TrigTableSegments + 2>;
+
+[[nodiscard]] constexpr double sinSeries(const double x) noexcept
+{
+  double term = x;
+  double sum = x;
+  for(int n = 1; n < 16; ++n)
+  {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+//! Euler's series, converging quickly for @p x in 0..1.
+[[nodiscard]] constexpr double atanSeries(const double x) noexcept
+{
+  const double y = x * x / (1 + x * x);
+  double term = x / (1 + x * x);
+  double sum = term;
+  for(int n = 1; n < 48; ++n)
+  {
+    term *= y * (2 * n) / (2 * n + 1);
+    sum += term;
+  }
+  return sum;
+}
+
+//! sin(x) for x in 0..90 degrees, scaled to QuarterRotation.
+[[nodiscard]] constexpr TrigTable makeSinTable() noexcept
+{
+  TrigTable table{};
+  for(size_t i = 0; i < table.size(); ++i)
+  {
+    const double x = static_cast<double>(i) / TrigTableSegments * glm::pi<double>() / 2;
+    table[i] = static_cast<int32_t>(sinSeries(x) * QuarterRotation + 0.5);
+  }
+  return table;
+}
+
+//! atan(x) for x in 0..1, in angle storage units.
+[[nodiscard]] constexpr TrigTable makeAtanTable() noexcept
+{
+  TrigTable table{};
+  for(size_t i = 0; i < table.size(); ++i)
+  {
+    const double x = static_cast<double>(i) / TrigTableSegments;
+    table[i] = static_cast<int32_t>(atanSeries(x) / glm::pi<double>() * 2 * QuarterRotation + 0.5);
+  }
+  return table;
+}
+
+inline constexpr TrigTable SinTable = makeSinTable();
+inline constexpr TrigTable AtanTable = makeAtanTable();
+
+//! Interpolates @p table at @p x, which is in 0..QuarterRotation.
+[[nodiscard]] constexpr int64_t interpolate(const TrigTable& table, const uint32_t x) noexcept
+{
+  constexpr uint32_t FractionBits = 30u - TrigTableBits;
+  const auto index = x >> FractionBits;
+  const auto fraction = static_cast<int64_t>(x & ((1u << FractionBits) - 1u));
+  const int64_t a = table[index];
+  const int64_t b = table[index + 1];
+  return a + (((b - a) * fraction) >> FractionBits);
+}
+
+//! @param value An angle in storage units, wrapping around at a full rotation.
+[[nodiscard]] inline float sin(const uint32_t value) noexcept
+{
+  // the top two bits select the quadrant
+  const auto quadrant = value >> 30u;
+  auto x = value & (QuarterRotation - 1u);
+  if((quadrant & 1u) != 0)
+    x = QuarterRotation - x;
+  const auto result = static_cast<float>(interpolate(SinTable, x)) / static_cast<float>(QuarterRotation);
+  return (quadrant & 2u) != 0 ? -result : result;
+}
+} // namespace detail
+
 [[nodiscard]] inline Angle angleFromRad(const float r)
 {
   return Angle{gsl::narrow_cast<Angle::type>(r / 2 / glm::pi<float>() * FullRotation * AngleStorageScale)};
 }
 
+//! Equivalent to angleFromRad(std::atan2(dx, dz)), except that it returns 0_deg for any signed zeros.
 [[nodiscard]] inline Angle angleFromAtan(const float dx, const float dz)
 {
-  return angleFromRad(std::atan2(dx, dz));
+  const auto ax = std::abs(dx);
+  const auto az = std::abs(dz);
+  if(ax == 0 && az == 0)
+    return Angle{0};
+
+  // reduce to the first octant, measured from +Z towards +X
+  const bool swapped = ax > az;
+  const auto t = swapped ? az / ax : ax / az;
+  const auto x = static_cast<uint32_t>(t * static_cast<float>(detail::QuarterRotation));
+  auto angle = static_cast<uint32_t>(detail::interpolate(detail::AtanTable, x));
+  if(swapped)
+    angle = detail::QuarterRotation - angle;
+  if(dz < 0)
+    angle = 2 * detail::QuarterRotation - angle;
+  if(dx < 0)
+    angle = 0u - angle;
+  return Angle{static_cast<Angle::type>(angle)};
 }
 
 [[nodiscard]] inline Angle angleFromDegrees(const float value)
@@ -39,7 +151,7 @@ namespace core
 
 [[nodiscard]] inline Angle angleFromAtan(const Length& dx, const Length& dz)
 {
-  return angleFromRad(std::atan2(dx.get<float>(), dz.get<float>()));
+  return angleFromAtan(dx.get<float>(), dz.get<float>());
 }
 
 [[nodiscard]] constexpr float toDegrees(const Angle& a) noexcept
@@ -59,12 +171,12 @@ namespace core
 
 [[nodiscard]] inline float sin(const Angle& a) noexcept
 {
-  return std::sin(toRad(a));
+  return detail::sin(static_cast<uint32_t>(a.get()));
 }
 
 [[nodiscard]] inline float cos(const Angle& a) noexcept
 {
-  return std::cos(toRad(a));
+  return detail::sin(static_cast<uint32_t>(a.get()) + detail::QuarterRotation);
 }
 
 [[nodiscard]] inline Angle abs(const Angle& a)
@@ -4,6 +4,10 @@
 #include "boundingbox.h"
 
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 
 namespace core
 {
@@ -44,6 +48,108 @@ BOOST_AUTO_TEST_CASE(test_angle_axis_with_margin)
   BOOST_CHECK(!core::axisFromAngle(-40_deg, 10_deg).has_value());
 }
 
+namespace
+{
+//! The difference between two angles in storage units, wrapping around at a full rotation.
+int64_t angleDistance(const core::Angle& a, const core::Angle& b)
+{
+  return std::abs(static_cast<int64_t>(static_cast<int32_t>(static_cast<uint32_t>(a.get() - b.get()))));
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_angle_sin_cos_exact_values)
+{
+  BOOST_CHECK_EQUAL(core::sin(0_deg), 0.0f);
+  BOOST_CHECK_EQUAL(core::sin(90_deg), 1.0f);
+  BOOST_CHECK_EQUAL(core::sin(-90_deg), -1.0f);
+  BOOST_CHECK_EQUAL(core::sin(-180_deg), 0.0f);
+  BOOST_CHECK_EQUAL(core::cos(0_deg), 1.0f);
+  BOOST_CHECK_EQUAL(core::cos(90_deg), 0.0f);
+  BOOST_CHECK_EQUAL(core::cos(-180_deg), -1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_angle_sin_cos_accuracy)
+{
+  // every angle unit, with a varying fraction
+  for(uint32_t i = 0; i < 65536; ++i)
+  {
+    const core::Angle a{static_cast<core::Angle::type>((i << 16u) | ((i * 40503u) & 0xffffu))};
+    const auto rad = static_cast<double>(static_cast<uint32_t>(a.get())) / 4294967296.0 * 2 * glm::pi<double>();
+    BOOST_REQUIRE_SMALL(static_cast<double>(core::sin(a)) - std::sin(rad), 5e-7);
+    BOOST_REQUIRE_SMALL(static_cast<double>(core::cos(a)) - std::cos(rad), 5e-7);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_angle_atan_exact_values)
+{
+  BOOST_CHECK_EQUAL(core::angleFromAtan(0.0f, 1.0f), 0_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(1.0f, 1.0f), 45_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(1.0f, 0.0f), 90_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(1.0f, -1.0f), 135_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(0.0f, -1.0f), -180_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(-1.0f, -1.0f), -135_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(-1.0f, 0.0f), -90_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(-1.0f, 1.0f), -45_deg);
+  BOOST_CHECK_EQUAL(core::angleFromAtan(0.0f, 0.0f), 0_deg);
+}
+
+BOOST_AUTO_TEST_CASE(test_angle_atan_accuracy)
+{
+  // a 64th of an angle unit
+  static constexpr int64_t Tolerance = 1024;
+  for(int dx = -1024; dx <= 1024; dx += 7)
+  {
+    for(int dz = -1024; dz <= 1024; dz += 5)
+    {
+      if(dx == 0 && dz == 0)
+        continue;
+
+      const auto expected = core::angleFromRad(std::atan2(static_cast<float>(dx), static_cast<float>(dz)));
+      BOOST_REQUIRE_LE(angleDistance(core::angleFromAtan(dx * 1_len, dz * 1_len), expected), Tolerance);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_angle_trig_benchmark)
+{
+  // not a correctness test; run with --log_level=message to see the timings
+  static constexpr uint32_t Iterations = 1u << 22u;
+  using Clock = std::chrono::high_resolution_clock;
+
+  const auto measure = [](const auto& fn)
+  {
+    volatile float sink = 0;
+    const auto start = Clock::now();
+    for(uint32_t i = 0; i < Iterations; ++i)
+      sink = sink + fn(core::Angle{static_cast<core::Angle::type>(i * 2654435761u)});
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  };
+
+  const auto tableSin = measure(
+    [](const core::Angle& a)
+    {
+      return core::sin(a);
+    });
+  const auto stdSin = measure(
+    [](const core::Angle& a)
+    {
+      return std::sin(core::toRad(a));
+    });
+  const auto tableAtan = measure(
+    [](const core::Angle& a)
+    {
+      return core::toAu(core::angleFromAtan(core::sin(a), 0.5f));
+    });
+  const auto stdAtan = measure(
+    [](const core::Angle& a)
+    {
+      return core::toAu(core::angleFromRad(std::atan2(core::sin(a), 0.5f)));
+    });
+
+  BOOST_TEST_MESSAGE("sin: table " << tableSin << " us, std " << stdSin << " us");
+  BOOST_TEST_MESSAGE("atan2 (incl. table sin): table " << tableAtan << " us, std " << stdAtan << " us");
+}
+
 BOOST_AUTO_TEST_CASE(test_interval_construction)
 {
   core::Interval<int> i1{};
@@ -184,11 +184,25 @@ int main(int argc, char** argv)
     mode = Mode::Game;
   };
 
+  auto findNextLevelFilepath = [&engine, &gameflow](size_t index) -> std::optional<std::filesystem::path>
+  {
+    for(; index < gameflow.getLevelSequence().size(); ++index)
+    {
+      if(const auto path = gameflow.getLevelSequence().at(index)->getLevelFilepath())
+        return engine.getAssetDataPath() / *path;
+    }
+    return std::nullopt;
+  };
+
   std::shared_ptr<engine::Player> player;
   std::shared_ptr<engine::Player> levelStartPlayer;
 
   while(true)
   {
+    // the next level is read in the background when the current item leaves the engine mostly idle
+    engine.getLevelPrefetcher().setNext(mode == Mode::Game ? findNextLevelFilepath(levelSequenceIndex + 1)
+                                                           : std::nullopt);
+
     std::pair<engine::RunResult, std::optional<size_t>> runResult;
     switch(mode)
     {
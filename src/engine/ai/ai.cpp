@@ -12,8 +12,7 @@
 #include "engine/objects/aiagent.h"
 #include "engine/objects/laraobject.h"
 #include "engine/objects/objectstate.h"
-#include "engine/script/reflection.h"
-#include "engine/script/scriptengine.h"
+#include "engine/script/objectinfo.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/box.h"
 #include "engine/world/world.h"
@@ -22,6 +21,7 @@
 #include "serialization/quantity.h"
 #include "serialization/serialization.h"
 #include "util/helpers.h"
+#include "util/random.h"
 
 #include <exception>
 #include <map>
@@ -59,14 +59,15 @@ std::optional<ai::Mood>
 std::optional<ai::Mood> getNewNonViolentMood(const EnemyLocation& enemyLocation,
                                              const ai::CreatureInfo& creatureInfo,
                                              bool isHit,
-                                             bool hasTargetBox)
+                                             bool hasTargetBox,
+                                             util::RandomStream& random)
 {
   switch(creatureInfo.mood)
   {
   case Mood::Bored:
     [[fallthrough]];
   case Mood::Stalk:
-    if(isHit && (util::rand15() < 2048 || !enemyLocation.canReachEnemyZone()))
+    if(isHit && (random.rand15() < 2048 || !enemyLocation.canReachEnemyZone()))
     {
       return Mood::Escape;
     }
@@ -83,7 +84,7 @@ std::optional<ai::Mood> getNewNonViolentMood(const EnemyLocation& enemyLocation,
     }
     break;
   case Mood::Attack:
-    if(isHit && (util::rand15() < 2048 || !enemyLocation.canReachEnemyZone()))
+    if(isHit && (random.rand15() < 2048 || !enemyLocation.canReachEnemyZone()))
     {
       return Mood::Escape;
     }
@@ -93,7 +94,7 @@ std::optional<ai::Mood> getNewNonViolentMood(const EnemyLocation& enemyLocation,
     }
     break;
   case Mood::Escape:
-    if(enemyLocation.canReachEnemyZone() && util::rand15() < 256)
+    if(enemyLocation.canReachEnemyZone() && random.rand15() < 256)
     {
       return Mood::Stalk;
     }
@@ -103,8 +104,12 @@ std::optional<ai::Mood> getNewNonViolentMood(const EnemyLocation& enemyLocation,
   return std::nullopt;
 }
 
-std::optional<ai::Mood> getNewMood(
-  const EnemyLocation& enemyLocation, const ai::CreatureInfo& creatureInfo, bool isHit, bool violent, bool hasTargetBox)
+std::optional<ai::Mood> getNewMood(const EnemyLocation& enemyLocation,
+                                   const ai::CreatureInfo& creatureInfo,
+                                   bool isHit,
+                                   bool violent,
+                                   bool hasTargetBox,
+                                   util::RandomStream& random)
 {
   if(violent)
   {
@@ -112,17 +117,18 @@ std::optional<ai::Mood> getNewMood(
   }
   else
   {
-    return getNewNonViolentMood(enemyLocation, creatureInfo, isHit, hasTargetBox);
+    return getNewNonViolentMood(enemyLocation, creatureInfo, isHit, hasTargetBox, random);
   }
 }
 } // namespace
 
-void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocation, const bool violent)
+void updateMood(objects::AIAgent& aiAgent, const EnemyLocation& enemyLocation, const bool violent)
 {
   if(aiAgent.getCreatureInfo() == nullptr)
     return;
 
   CreatureInfo& creatureInfo = *aiAgent.getCreatureInfo();
+  auto& random = aiAgent.getWorld().getRandomStreams().ai;
   auto newTargetBox = creatureInfo.pathFinder.getTargetBox();
   if(creatureInfo.pathFinder.isUnreachable(aiAgent.m_state.getCurrentBox()))
   {
@@ -143,7 +149,7 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
   if(lara.isDead())
     creatureInfo.mood = Mood::Bored;
   else if(auto newMood
-          = getNewMood(enemyLocation, creatureInfo, aiAgent.m_state.is_hit, violent, newTargetBox != nullptr))
+          = getNewMood(enemyLocation, creatureInfo, aiAgent.m_state.is_hit, violent, newTargetBox != nullptr, random))
     creatureInfo.mood = *newMood;
 
   if(originalMood != creatureInfo.mood)
@@ -151,7 +157,7 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
     if(originalMood == Mood::Attack)
     {
       gsl_Assert(creatureInfo.pathFinder.getTargetBox() != nullptr);
-      creatureInfo.pathFinder.setRandomSearchTarget(gsl::not_null{creatureInfo.pathFinder.getTargetBox()});
+      creatureInfo.pathFinder.setRandomSearchTarget(gsl::not_null{creatureInfo.pathFinder.getTargetBox()}, random);
     }
     newTargetBox = nullptr;
   }
@@ -159,13 +165,7 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
   switch(creatureInfo.mood)
   {
   case Mood::Attack:
-    if(util::rand15() >= aiAgent.getWorld()
-                           .getEngine()
-                           .getScriptEngine()
-                           .getGameflow()
-                           .getObjectInfos()
-                           .at(aiAgent.m_state.type.get_as<TR1ItemId>())
-                           ->target_update_chance)
+    if(random.rand15() >= aiAgent.getWorld().getObjectInfo(aiAgent.m_state.type).target_update_chance)
       break;
 
     creatureInfo.pathFinder.target = lara.m_state.location.position;
@@ -179,20 +179,20 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
     break;
   case Mood::Bored:
   {
-    const auto box = creatureInfo.pathFinder.getRandomBox();
+    const auto box = creatureInfo.pathFinder.getRandomBox(random);
     if(!aiAgent.isInsideZoneButNotInBox(enemyLocation.zoneId, *box))
       break;
 
     if(aiAgent.m_state.isStalkBox(aiAgent.getWorld(), *box))
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
       creatureInfo.mood = Mood::Stalk;
     }
     else if(newTargetBox == nullptr)
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
     }
     break;
   }
@@ -201,19 +201,19 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
     if(newTargetBox != nullptr && aiAgent.m_state.isStalkBox(aiAgent.getWorld(), *newTargetBox))
       break;
 
-    const auto box = creatureInfo.pathFinder.getRandomBox();
+    const auto box = creatureInfo.pathFinder.getRandomBox(random);
     if(!aiAgent.isInsideZoneButNotInBox(enemyLocation.zoneId, *box))
       break;
 
     if(aiAgent.m_state.isStalkBox(aiAgent.getWorld(), *box))
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
     }
     else if(newTargetBox == nullptr)
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
       if(!enemyLocation.canReachEnemyZone())
       {
         creatureInfo.mood = Mood::Bored;
@@ -223,19 +223,19 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
   }
   case Mood::Escape:
   {
-    const auto box = creatureInfo.pathFinder.getRandomBox();
+    const auto box = creatureInfo.pathFinder.getRandomBox(random);
     if(!aiAgent.isInsideZoneButNotInBox(enemyLocation.zoneId, *box) || newTargetBox != nullptr)
       break;
 
     if(aiAgent.m_state.isEscapeBox(aiAgent.getWorld(), *box))
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
     }
     else if(enemyLocation.canReachEnemyZone() && aiAgent.m_state.isStalkBox(aiAgent.getWorld(), *box))
     {
       newTargetBox = box;
-      creatureInfo.pathFinder.setRandomSearchTarget(box);
+      creatureInfo.pathFinder.setRandomSearchTarget(box, random);
       creatureInfo.mood = Mood::Stalk;
     }
     break;
@@ -245,12 +245,15 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
   if(creatureInfo.pathFinder.getTargetBox() == nullptr)
   {
     newTargetBox = aiAgent.m_state.getCurrentBox();
-    creatureInfo.pathFinder.setRandomSearchTarget(aiAgent.m_state.getCurrentBox());
+    creatureInfo.pathFinder.setRandomSearchTarget(aiAgent.m_state.getCurrentBox(), random);
   }
   if(newTargetBox != nullptr)
     creatureInfo.pathFinder.setTargetBox(gsl::not_null{newTargetBox});
-  creatureInfo.pathFinder.calculateTarget(
-    aiAgent.getWorld(), creatureInfo.target, aiAgent.m_state.location.position, aiAgent.m_state.getCurrentBox());
+  creatureInfo.pathFinder.calculateTarget(aiAgent.getWorld(),
+                                          creatureInfo.target,
+                                          aiAgent.m_state.location.position,
+                                          aiAgent.m_state.getCurrentBox(),
+                                          random);
 }
 
 std::unique_ptr<CreatureInfo> create(const serialization::TypeId<std::unique_ptr<CreatureInfo>>&,
@@ -307,9 +310,7 @@ EnemyLocation::EnemyLocation(objects::AIAgent& aiAgent)
                        || aiAgent.getCreatureInfo()->pathFinder.isUnreachable(aiAgentBox);
   }
 
-  const gsl::not_null objectInfo{aiAgent.getWorld().getEngine().getScriptEngine().getGameflow().getObjectInfos().at(
-    aiAgent.m_state.type.get_as<TR1ItemId>())};
-  const core::Length pivotLength{objectInfo->pivot_length};
+  const core::Length pivotLength{aiAgent.getWorld().getObjectInfo(aiAgent.m_state.type).pivot_length};
   const auto toLara = lara.m_state.location.position
                       - (aiAgent.m_state.location.position + util::pitch(pivotLength, aiAgent.m_state.rotation.Y));
   const auto angleToLara = core::angleFromAtan(toLara.X, toLara.Z);
@@ -329,7 +330,7 @@ CreatureInfo::CreatureInfo(const world::World& world,
                            const core::TypeId& type,
                            const gsl::not_null<const world::Box*>& initialBox)
 {
-  auto objectInfo = *world.getEngine().getScriptEngine().getGameflow().getObjectInfos().at(type.get_as<TR1ItemId>());
+  const auto& objectInfo = world.getObjectInfo(type);
   pathFinder.step = core::Length{objectInfo.step_limit};
   pathFinder.drop = core::Length{objectInfo.drop_limit};
   pathFinder.fly = core::Length{objectInfo.fly_limit};
@@ -105,5 +105,5 @@ std::unique_ptr<CreatureInfo> create(const serialization::TypeId<std::unique_ptr
 
 void serialize(std::unique_ptr<CreatureInfo>& data, const serialization::Serializer<world::World>& ser);
 
-void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocation, bool violent);
+void updateMood(objects::AIAgent& aiAgent, const EnemyLocation& enemyLocation, bool violent);
 } // namespace engine::ai
@@ -14,6 +14,7 @@
 #include "serialization/vector.h"
 #include "serialization/vector_element.h"
 #include "util/helpers.h"
+#include "util/random.h"
 
 #include <algorithm>
 #include <boost/assert.hpp>
@@ -39,7 +40,8 @@ template<typename T>
 bool PathFinder::calculateTarget(const world::World& world,
                                  core::TRVec& moveTarget,
                                  const core::TRVec& startPos,
-                                 const gsl::not_null<const world::Box*>& startBox)
+                                 const gsl::not_null<const world::Box*>& startBox,
+                                 util::RandomStream& random)
 {
   Expects(m_targetBox != nullptr);
   Expects(m_targetBox->xInterval.contains(target.X));
@@ -211,7 +213,7 @@ bool PathFinder::calculateTarget(const world::World& world,
   if(moveDirs & (CanMoveZPos | CanMoveZNeg))
   {
     const auto range = here->zInterval.size() - 2 * Margin;
-    moveTarget.Z = util::rand15(range) + here->zInterval.min + Margin;
+    moveTarget.Z = random.rand15(range) + here->zInterval.min + Margin;
   }
   else if(!detour)
   {
@@ -223,7 +225,7 @@ bool PathFinder::calculateTarget(const world::World& world,
   if(moveDirs & (CanMoveXPos | CanMoveXNeg))
   {
     const auto range = here->xInterval.size() - 2 * Margin;
-    moveTarget.X = util::rand15(range) + here->xInterval.min + Margin;
+    moveTarget.X = random.rand15(range) + here->xInterval.min + Margin;
   }
   else if(!detour)
   {
@@ -377,12 +379,12 @@ bool PathFinder::canVisit(const world::Box& box) const noexcept
   return true;
 }
 
-void PathFinder::setRandomSearchTarget(const gsl::not_null<const world::Box*>& box)
+void PathFinder::setRandomSearchTarget(const gsl::not_null<const world::Box*>& box, util::RandomStream& random)
 {
   const auto xSize = box->xInterval.size() - 2 * Margin;
-  target.X = util::rand15(xSize) + box->xInterval.min + Margin;
+  target.X = random.rand15(xSize) + box->xInterval.min + Margin;
   const auto zSize = box->zInterval.size() - 2 * Margin;
-  target.Z = util::rand15(zSize) + box->zInterval.min + Margin;
+  target.Z = random.rand15(zSize) + box->zInterval.min + Margin;
   if(isFlying())
   {
     target.Y = box->floor - 384_len;
@@ -409,9 +411,9 @@ void PathFinder::setTargetBox(const gsl::not_null<const world::Box*>& box)
   m_edges.clear();
 }
 
-const gsl::not_null<const world::Box*>& PathFinder::getRandomBox() const
+const gsl::not_null<const world::Box*>& PathFinder::getRandomBox(util::RandomStream& random) const
 {
   Expects(!m_boxes.empty());
-  return m_boxes[util::rand15(m_boxes.size())];
+  return m_boxes[random.rand15(m_boxes.size())];
 }
 } // namespace engine::ai
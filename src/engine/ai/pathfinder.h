@@ -19,6 +19,11 @@ class World;
 struct Box;
 } // namespace engine::world
 
+namespace util
+{
+class RandomStream;
+}
+
 namespace engine::ai
 {
 struct PathFinder
@@ -44,12 +49,13 @@ struct PathFinder
 
   core::TRVec target;
 
-  void setRandomSearchTarget(const gsl::not_null<const world::Box*>& box);
+  void setRandomSearchTarget(const gsl::not_null<const world::Box*>& box, util::RandomStream& random);
 
   bool calculateTarget(const world::World& world,
                        core::TRVec& moveTarget,
                        const core::TRVec& startPos,
-                       const gsl::not_null<const world::Box*>& startBox);
+                       const gsl::not_null<const world::Box*>& startBox,
+                       util::RandomStream& random);
 
   void setTargetBox(const gsl::not_null<const world::Box*>& box);
 
@@ -64,7 +70,7 @@ struct PathFinder
     return it != m_reachable.end() && !it->second;
   }
 
-  [[nodiscard]] const gsl::not_null<const world::Box*>& getRandomBox() const;
+  [[nodiscard]] const gsl::not_null<const world::Box*>& getRandomBox(util::RandomStream& random) const;
 
   [[nodiscard]] const world::Box* getNextPathBox(const gsl::not_null<const world::Box*>& box) const
   {
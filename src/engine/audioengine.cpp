@@ -206,20 +206,20 @@ std::shared_ptr<audio::Voice> AudioEngine::playSoundEffect(const core::SoundEffe
   }
 
   const auto soundEffect = soundEffectIt->second;
-  if(soundEffect->chance != 0 && util::rand15() > soundEffect->chance)
+  if(soundEffect->chance != 0 && m_world.getRandomStreams().audio.rand15() > soundEffect->chance)
     return nullptr;
 
   size_t sample = soundEffect->sample.get();
   if(soundEffect->getSampleCount() > 1)
-    sample += util::rand15(soundEffect->getSampleCount());
+    sample += m_world.getRandomStreams().audio.rand15(soundEffect->getSampleCount());
 
   float pitch = 1;
   if(soundEffect->useRandomPitch())
-    pitch = 0.9f + util::rand15(0.2f);
+    pitch = 0.9f + m_world.getRandomStreams().audio.rand15(0.2f);
 
   float volume = std::clamp(static_cast<float>(soundEffect->volume) / 0x7fff, 0.0f, 1.0f);
   if(soundEffect->useRandomVolume())
-    volume -= util::rand15(0.25f);
+    volume -= m_world.getRandomStreams().audio.rand15(0.25f);
   if(volume <= 0)
     return nullptr;
 
@@ -0,0 +1,114 @@
+#include "cameracollisioncache.h"
+
+#include "heightinfo.h"
+#include "objectmanager.h"
+#include "objects/object.h"
+#include "objects/objectstate.h"
+#include "raycast.h"
+#include "world/world.h"
+
+#include <algorithm>
+
+namespace engine
+{
+namespace
+{
+bool isSameLocation(const Location& a, const Location& b)
+{
+  return a.room == b.room && a.position == b.position;
+}
+} // namespace
+
+void CameraCollisionCache::beginFrame(const world::World& world)
+{
+  m_newPatchStates.clear();
+  for(const auto& [id, object] : world.getObjectManager().getObjects())
+  {
+    if(object->patchesHeights())
+      m_newPatchStates.emplace_back(
+        PatchState{object.get().get(), object->m_state.location.position, object->m_state.current_anim_state});
+  }
+
+  if(m_sectorsRevision != world.getSectorsRevision() || m_newPatchStates != m_patchStates)
+  {
+    clear();
+    m_sectorsRevision = world.getSectorsRevision();
+    std::swap(m_patchStates, m_newPatchStates);
+    return;
+  }
+
+  std::swap(m_previous, m_current);
+  m_current.clear();
+}
+
+CameraCollisionCache::Heights CameraCollisionCache::getHeights(Location& location, const ObjectManager& objectManager)
+{
+  const auto find = [&location](const std::vector<HeightsEntry>& entries)
+  {
+    return std::find_if(entries.begin(),
+                        entries.end(),
+                        [&location](const HeightsEntry& entry)
+                        {
+                          return entry.room == location.room && entry.position == location.position
+                                 && entry.skipSteepSlants == HeightInfo::skipSteepSlants;
+                        });
+  };
+
+  if(const auto it = find(m_current.heights); it != m_current.heights.end())
+  {
+    location.room = it->updatedRoom;
+    return it->heights;
+  }
+
+  if(const auto it = find(m_previous.heights); it != m_previous.heights.end())
+  {
+    m_current.heights.emplace_back(*it);
+    location.room = it->updatedRoom;
+    return it->heights;
+  }
+
+  const auto room = location.room;
+  const auto sector = location.updateRoom();
+  const Heights heights{sector,
+                        HeightInfo::fromFloor(sector, location.position, objectManager.getObjects()).y,
+                        HeightInfo::fromCeiling(sector, location.position, objectManager.getObjects()).y};
+  m_current.heights.emplace_back(
+    HeightsEntry{room, location.position, HeightInfo::skipSteepSlants, location.room, heights});
+  return heights;
+}
+
+std::pair<bool, Location> CameraCollisionCache::raycastLineOfSight(const Location& start,
+                                                                   const core::TRVec& goal,
+                                                                   const ObjectManager& objectManager)
+{
+  const auto find = [&start, &goal](const std::vector<RaycastEntry>& entries)
+  {
+    return std::find_if(entries.begin(),
+                        entries.end(),
+                        [&start, &goal](const RaycastEntry& entry)
+                        {
+                          return isSameLocation(entry.start, start) && entry.goal == goal
+                                 && entry.skipSteepSlants == HeightInfo::skipSteepSlants;
+                        });
+  };
+
+  if(const auto it = find(m_current.raycasts); it != m_current.raycasts.end())
+    return it->result;
+
+  if(const auto it = find(m_previous.raycasts); it != m_previous.raycasts.end())
+  {
+    m_current.raycasts.emplace_back(*it);
+    return it->result;
+  }
+
+  auto result = engine::raycastLineOfSight(start, goal, objectManager);
+  m_current.raycasts.emplace_back(RaycastEntry{start, goal, HeightInfo::skipSteepSlants, result});
+  return result;
+}
+
+void CameraCollisionCache::clear()
+{
+  m_current.clear();
+  m_previous.clear();
+}
+} // namespace engine
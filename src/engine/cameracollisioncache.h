@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/id.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "location.h"
+
+#include <cstddef>
+#include <gsl/gsl-lite.hpp>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace engine::world
+{
+class World;
+struct Room;
+struct Sector;
+} // namespace engine::world
+
+namespace engine
+{
+class ObjectManager;
+
+namespace objects
+{
+class Object;
+}
+
+/**
+ * Caches the floor, ceiling and line of sight queries of the camera.
+ *
+ * As long as the camera and its target don't move, the camera issues the exact same queries every frame. Results are
+ * kept for the current and the previous frame, and all of them are dropped when sectors change (doors, blocks, flip
+ * maps), or when an object patching floor or ceiling heights (bridges, trapdoors, collapsible floors) moves or changes
+ * its animation state.
+ */
+class CameraCollisionCache final
+{
+public:
+  struct Heights
+  {
+    gsl::not_null<const world::Sector*> sector;
+    core::Length floor;
+    core::Length ceiling;
+  };
+
+  //! Must be called before the queries of a frame.
+  void beginFrame(const world::World& world);
+
+  //! Updates the room of @p location, and returns its sector with the floor and ceiling heights at its position.
+  [[nodiscard]] Heights getHeights(Location& location, const ObjectManager& objectManager);
+
+  [[nodiscard]] std::pair<bool, Location>
+    raycastLineOfSight(const Location& start, const core::TRVec& goal, const ObjectManager& objectManager);
+
+  void clear();
+
+private:
+  struct HeightsEntry
+  {
+    gsl::not_null<const world::Room*> room;
+    core::TRVec position;
+    bool skipSteepSlants;
+    gsl::not_null<const world::Room*> updatedRoom;
+    Heights heights;
+  };
+
+  struct RaycastEntry
+  {
+    Location start;
+    core::TRVec goal;
+    bool skipSteepSlants;
+    std::pair<bool, Location> result;
+  };
+
+  struct Frame
+  {
+    std::vector<HeightsEntry> heights;
+    std::vector<RaycastEntry> raycasts;
+
+    void clear()
+    {
+      heights.clear();
+      raycasts.clear();
+    }
+  };
+
+  //! The state of an object which patches floor or ceiling heights.
+  struct PatchState
+  {
+    const objects::Object* object;
+    core::TRVec position;
+    core::AnimStateId animState;
+
+    [[nodiscard]] bool operator==(const PatchState& rhs) const
+    {
+      return object == rhs.object && position == rhs.position && animState == rhs.animState;
+    }
+  };
+
+  Frame m_current;
+  Frame m_previous;
+  std::optional<size_t> m_sectorsRevision;
+  std::vector<PatchState> m_patchStates;
+  std::vector<PatchState> m_newPatchStates;
+};
+} // namespace engine
@@ -1,5 +1,6 @@
 #include "cameracontroller.h"
 
+#include "cameracollisioncache.h"
 #include "core/boundingbox.h"
 #include "core/genericvec.h"
 #include "core/interval.h"
@@ -68,12 +69,10 @@ void freeLookClamp(core::Length& goalX,
   }
 }
 
-bool isVerticallyOutsideRoom(Location location, const ObjectManager& objectManager)
+bool isVerticallyOutsideRoom(Location location, CameraCollisionCache& cache, const ObjectManager& objectManager)
 {
-  const auto sector = location.updateRoom();
-  const auto floor = HeightInfo::fromFloor(sector, location.position, objectManager.getObjects()).y;
-  const auto ceiling = HeightInfo::fromCeiling(sector, location.position, objectManager.getObjects()).y;
-  return location.position.Y >= floor || location.position.Y <= ceiling;
+  const auto heights = cache.getHeights(location, objectManager);
+  return location.position.Y >= heights.floor || location.position.Y <= heights.ceiling;
 }
 
 void clampToCorners(const core::Area& targetHorizontalDistanceSq,
@@ -156,9 +155,10 @@ using ClampCallback = void(core::Length& goalX,
 Location clampBox(const Location& start,
                   const core::TRVec& goal,
                   const std::function<ClampCallback>& callback,
+                  CameraCollisionCache& cache,
                   const ObjectManager& objectManager)
 {
-  auto result = raycastLineOfSight(start, goal, objectManager).second;
+  auto result = cache.raycastLineOfSight(start, goal, objectManager).second;
   const auto startSector = gsl::not_null{start.room->getSectorByAbsolutePosition(start.position)};
   auto box = startSector->box;
   if(const auto goalSector = gsl::not_null{result.room->getSectorByAbsolutePosition(result.position)};
@@ -185,9 +185,14 @@ Location clampBox(const Location& start,
 
   core::TRVec testPos = result.position;
 
-  const auto testPosInvalid = [&testPos, &result, &objectManager]
+  const auto testPosInvalid = [&testPos, &result, &cache, &objectManager]
   {
-    return isVerticallyOutsideRoom(Location{result.room, testPos}, objectManager);
+    return isVerticallyOutsideRoom(Location{result.room, testPos}, cache, objectManager);
+  };
+  const auto testBox = [&testPos, &result, &cache, &objectManager]
+  {
+    Location location{result.room, testPos};
+    return cache.getHeights(location, objectManager).sector->box;
   };
 
   alignMin(testPos.Z);
@@ -196,8 +201,8 @@ Location clampBox(const Location& start,
   const bool invalidMinZ = testPosInvalid();
   if(!invalidMinZ)
   {
-    if(const auto testBox = Location{result.room, testPos}.updateRoom()->box)
-      minZ = std::min(minZ, testBox->zInterval.min);
+    if(const auto tmp = testBox())
+      minZ = std::min(minZ, tmp->zInterval.min);
   }
   minZ += core::QuarterSectorSize;
 
@@ -208,8 +213,8 @@ Location clampBox(const Location& start,
   const bool invalidMaxZ = testPosInvalid();
   if(!invalidMaxZ)
   {
-    if(const auto testBox = Location{result.room, testPos}.updateRoom()->box)
-      maxZ = std::max(maxZ, testBox->zInterval.max);
+    if(const auto tmp = testBox())
+      maxZ = std::max(maxZ, tmp->zInterval.max);
   }
   maxZ -= core::QuarterSectorSize;
 
@@ -220,8 +225,8 @@ Location clampBox(const Location& start,
   const bool invalidMinX = testPosInvalid();
   if(!invalidMinX)
   {
-    if(const auto testBox = Location{result.room, testPos}.updateRoom()->box)
-      minX = std::max(minX, testBox->xInterval.min);
+    if(const auto tmp = testBox())
+      minX = std::max(minX, tmp->xInterval.min);
   }
   minX += core::QuarterSectorSize;
 
@@ -232,8 +237,8 @@ Location clampBox(const Location& start,
   const bool invalidMaxX = testPosInvalid();
   if(!invalidMaxX)
   {
-    if(const auto testBox = Location{result.room, testPos}.updateRoom()->box)
-      maxX = std::max(maxX, testBox->xInterval.max);
+    if(const auto tmp = testBox())
+      maxX = std::max(maxX, tmp->xInterval.max);
   }
   maxX -= core::QuarterSectorSize;
 
@@ -428,6 +433,8 @@ std::unordered_set<const world::Portal*> CameraController::update()
     return tracePortals();
   }
 
+  m_collisionCache.beginFrame(*m_world);
+
   if(m_modifier != CameraModifier::AllowSteepSlants)
     HeightInfo::skipSteepSlants = true;
 
@@ -525,9 +532,7 @@ std::unordered_set<const world::Portal*> CameraController::update()
     }
 
     m_lookAt.room = focusedObject->m_state.location.room;
-    const auto sector = m_lookAt.updateRoom();
-    if(HeightInfo::fromFloor(sector, m_lookAt.position, m_world->getObjectManager().getObjects()).y
-       < m_lookAt.position.Y)
+    if(m_collisionCache.getHeights(m_lookAt, m_world->getObjectManager()).floor < m_lookAt.position.Y)
       HeightInfo::skipSteepSlants = false;
 
     if(m_mode == CameraMode::Chase || m_modifier == CameraModifier::Chase)
@@ -557,7 +562,7 @@ void CameraController::handleFixedCamera()
   Expects(m_fixedCameraId >= 0);
 
   const auto& camera = m_world->getCameraSinks().at(m_fixedCameraId);
-  auto [success, goal] = raycastLineOfSight(m_lookAt, camera.position, m_world->getObjectManager());
+  auto [success, goal] = m_collisionCache.raycastLineOfSight(m_lookAt, camera.position, m_world->getObjectManager());
   if(!success)
   {
     moveIntoBox(goal, core::QuarterSectorSize);
@@ -586,12 +591,12 @@ core::Length CameraController::moveIntoBox(Location& goal, const core::Length& m
   {
     const auto narrowed = sector->box->zInterval.narrowed(margin);
     if(goal.position.Z < narrowed.min
-       && isVerticallyOutsideRoom(goal.moved(0_len, 0_len, -margin), m_world->getObjectManager()))
+       && isVerticallyOutsideRoom(goal.moved(0_len, 0_len, -margin), m_collisionCache, m_world->getObjectManager()))
     {
       goal.position.Z = narrowed.min;
     }
     else if(goal.position.Z > narrowed.max
-            && isVerticallyOutsideRoom(goal.moved(0_len, 0_len, margin), m_world->getObjectManager()))
+            && isVerticallyOutsideRoom(goal.moved(0_len, 0_len, margin), m_collisionCache, m_world->getObjectManager()))
     {
       goal.position.Z = narrowed.max;
     }
@@ -600,12 +605,12 @@ core::Length CameraController::moveIntoBox(Location& goal, const core::Length& m
   {
     const auto narrowed = sector->box->xInterval.narrowed(margin);
     if(goal.position.X < narrowed.min
-       && isVerticallyOutsideRoom(goal.moved(-margin, 0_len, 0_len), m_world->getObjectManager()))
+       && isVerticallyOutsideRoom(goal.moved(-margin, 0_len, 0_len), m_collisionCache, m_world->getObjectManager()))
     {
       goal.position.X = narrowed.min;
     }
     else if(goal.position.X > narrowed.max
-            && isVerticallyOutsideRoom(goal.moved(margin, 0_len, 0_len), m_world->getObjectManager()))
+            && isVerticallyOutsideRoom(goal.moved(margin, 0_len, 0_len), m_collisionCache, m_world->getObjectManager()))
     {
       goal.position.X = narrowed.max;
     }
@@ -629,19 +634,16 @@ void CameraController::updatePosition(const Location& goal, const core::Frame& s
   m_location.position += (goal.position - m_location.position) / smoothFactor * 1_frame;
   m_location.room = goal.room;
   HeightInfo::skipSteepSlants = false;
-  auto sector = m_location.updateRoom();
-  auto floor = HeightInfo::fromFloor(sector, m_location.position, m_world->getObjectManager().getObjects()).y
-               - core::QuarterSectorSize;
+  auto heights = m_collisionCache.getHeights(m_location, m_world->getObjectManager());
+  auto floor = heights.floor - core::QuarterSectorSize;
   if(floor <= std::min(m_location.position.Y, goal.position.Y))
   {
-    m_location = raycastLineOfSight(m_lookAt, m_location.position, m_world->getObjectManager()).second;
-    sector = m_location.updateRoom();
-    floor = HeightInfo::fromFloor(sector, m_location.position, m_world->getObjectManager().getObjects()).y
-            - core::QuarterSectorSize;
+    m_location = m_collisionCache.raycastLineOfSight(m_lookAt, m_location.position, m_world->getObjectManager()).second;
+    heights = m_collisionCache.getHeights(m_location, m_world->getObjectManager());
+    floor = heights.floor - core::QuarterSectorSize;
   }
 
-  auto ceiling = HeightInfo::fromCeiling(sector, m_location.position, m_world->getObjectManager().getObjects()).y
-                 + core::QuarterSectorSize;
+  auto ceiling = heights.ceiling + core::QuarterSectorSize;
   if(floor < ceiling)
   {
     floor = ceiling = (floor + ceiling) / 2;
@@ -649,7 +651,8 @@ void CameraController::updatePosition(const Location& goal, const core::Frame& s
 
   if(m_bounce < 0_len)
   {
-    const core::TRVec tmp{util::rand15s(m_bounce), util::rand15s(m_bounce), util::rand15s(m_bounce)};
+    auto& random = m_world->getRandomStreams().simulation;
+    const core::TRVec tmp{random.rand15s(m_bounce), random.rand15s(m_bounce), random.rand15s(m_bounce)};
     m_location.position += tmp;
     m_lookAt.position += tmp;
     m_bounce += 5_len;
@@ -701,6 +704,7 @@ void CameraController::chaseObject(const objects::Object& object)
     {
       clampToCorners(distSq, a, b, c, d, e, f, g, h);
     },
+    m_collisionCache,
     m_world->getObjectManager());
 
   updatePosition(goal, m_isCompletelyFixed ? m_smoothness : 12_frame);
@@ -719,7 +723,7 @@ void CameraController::handleFreeLook()
   m_distance = core::DefaultCameraLaraDistance;
   m_lookAt.position += util::pitch(util::sin(-1_sectors / 2, m_rotationAroundLara.X), lara.m_state.rotation.Y);
 
-  if(isVerticallyOutsideRoom(m_lookAt, m_world->getObjectManager()))
+  if(isVerticallyOutsideRoom(m_lookAt, m_collisionCache, m_world->getObjectManager()))
   {
     m_lookAt.position.X = lara.m_state.location.position.X;
     m_lookAt.position.Z = lara.m_state.location.position.Z;
@@ -732,6 +736,7 @@ void CameraController::handleFreeLook()
                                              m_rotationAroundLara.Y,
                                              -util::sin(m_distance, m_rotationAroundLara.X)),
                              &freeLookClamp,
+                             m_collisionCache,
                              m_world->getObjectManager());
 
   m_lookAt.position.X = originalLookAt.X + (m_lookAt.position.X - originalLookAt.X) / m_smoothness * 1_frame;
@@ -773,6 +778,7 @@ void CameraController::handleEnemy()
     {
       clampToCorners(distSq, a, b, c, d, e, f, g, h);
     },
+    m_collisionCache,
     m_world->getObjectManager());
   updatePosition(eye, m_smoothness);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "audio/listener.h"
+#include "cameracollisioncache.h"
 #include "core/angle.h"
 #include "core/magic.h"
 #include "core/units.h"
@@ -100,6 +101,8 @@ private:
   int m_currentFixedCameraId = -1;
   core::Frame m_camOverrideTimeout{-1_frame};
 
+  mutable CameraCollisionCache m_collisionCache;
+
 public:
   explicit CameraController(const gsl::not_null<world::World*>& world, gslu::nn_shared<render::scene::Camera> camera);
 
@@ -10,10 +10,11 @@
 #include "engine/cameracontroller.h"
 #include "engine/displaysettings.h"
 #include "engine/engineconfig.h"
-#include "engine/ghosting/ghostmodel.h"
+#include "engine/fixedtimestep.h"
 #include "engine/inventory.h"
 #include "engine/objectmanager.h"
 #include "engine/objects/objectstate.h"
+#include "engine/presentationinterpolator.h"
 #include "engine/weapontype.h"
 #include "engine/world/room.h"
 #include "ghosting/ghost.h"
@@ -32,6 +33,7 @@
 #include "render/scene/mesh.h"
 #include "render/scene/node.h"
 #include "render/scene/rendercontext.h"
+#include "screencapture.h"
 #include "script/reflection.h"
 #include "script/scriptengine.h"
 #include "serialization/serialization.h"
@@ -45,6 +47,7 @@
 #include "ui/widgets/messagebox.h"
 #include "util/helpers.h"
 #include "world/world.h"
+#include "writeonlyxzarchive.h"
 
 #include <algorithm>
 #include <boost/algorithm/string/predicate.hpp>
@@ -163,7 +166,7 @@ bool showLevelStats(const std::shared_ptr<Presenter>& presenter, world::World& w
     if(presenter->getInputHandler().hasDebouncedAction(hid::Action::Holster))
       detailed = !detailed;
 
-    ui::Ui ui{presenter->getMaterialManager()->getUi(), world.getPalette(), presenter->getUiViewport()};
+    ui::Ui ui{presenter->getUiRenderer(), world.getPalette(), presenter->getUiViewport()};
     ui.drawBox({0, 0}, ui.getSize(), gl::SRGBA8{0, 0, 0, 224});
     if(detailed)
       detailedStats.draw(ui, *presenter, false);
@@ -192,6 +195,32 @@ bool showLevelStats(const std::shared_ptr<Presenter>& presenter, world::World& w
   return true;
 }
 
+//! Adds the logs to the files in @a bugReportPath, and replaces the directory with an archive of its contents.
+void writeBugReportArchive(const std::filesystem::path& userDataPath, const std::filesystem::path& bugReportPath)
+{
+  // copy the logs first, as they may still grow while being archived
+  for(std::filesystem::directory_iterator it{userDataPath}; it != std::filesystem::directory_iterator{}; ++it)
+  {
+    if(!it->is_regular_file() || !boost::algorithm::starts_with(it->path().filename().string(), "croftengine.")
+       || !boost::algorithm::ends_with(it->path().filename().string(), ".log"))
+      continue;
+
+    std::filesystem::copy_file(it->path(), bugReportPath / it->path().filename());
+  }
+
+  const auto archivePath = std::filesystem::path{bugReportPath}.replace_extension(".tar.xz");
+  BOOST_LOG_TRIVIAL(info) << "Create bug report " << archivePath;
+  {
+    WriteOnlyXzArchive archive{archivePath};
+    for(std::filesystem::directory_iterator it{bugReportPath}; it != std::filesystem::directory_iterator{}; ++it)
+    {
+      if(it->is_regular_file())
+        archive.addFile(it->path(), it->path().filename());
+    }
+  }
+  std::filesystem::remove_all(bugReportPath);
+}
+
 std::string getCurrentHumanReadableTimestamp()
 {
   auto time = std::time(nullptr);
@@ -277,8 +306,15 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
   const bool allAmmoCheat = m_scriptEngine.getGameflow().hasAllAmmoCheat();
 
   applySettings();
+  if(isCutscene)
+    m_levelPrefetcher.start();
+
   std::shared_ptr<menu::MenuDisplay> menu;
   Throttler throttler;
+  FixedTimestep timestep;
+  PresentationInterpolator interpolator;
+  FrameTimings frameTimings;
+  std::optional<ui::Ui> tickUi;
   core::Frame laraDeadTime = 0_frame;
 
   core::Frame runtime = 0_frame;
@@ -292,7 +328,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
 
   while(true)
   {
-    ghostManager.model->setVisible(m_engineConfig->displaySettings.ghost);
+    ghostManager.setVisible(m_engineConfig->displaySettings.ghost);
 
     if(m_presenter->shouldClose())
     {
@@ -301,6 +337,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
 
     if(world.levelFinished())
     {
+      m_levelPrefetcher.start();
       if(!isCutscene && allowSave)
       {
         if(!showLevelStats(m_presenter, world))
@@ -313,8 +350,13 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       return {RunResult::NextLevel, std::nullopt};
     }
 
-    throttler.wait();
-    if(!m_presenter->preFrame())
+    // menus and cutscenes run in lock-step with the display, the game itself is simulated in fixed ticks and presented
+    // at the display's rate
+    const bool fixedStep = menu == nullptr && !isCutscene;
+    if(!fixedStep)
+      throttler.wait();
+    frameTimings.beginFrame();
+    if(!m_presenter->preFrame(!fixedStep))
     {
       continue;
     }
@@ -329,7 +371,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       }
       m_presenter->updateSoundEngine();
       m_presenter->renderScreenOverlay();
-      ui::Ui ui{m_presenter->getMaterialManager()->getUi(), world.getPalette(), m_presenter->getUiViewport()};
+      ui::Ui ui{m_presenter->getUiRenderer(), world.getPalette(), m_presenter->getUiViewport()};
       ui.drawBox({0, 0}, ui.getSize(), gl::SRGBA8{0, 0, 0, 224});
       m_presenter->renderUi(ui, 1);
       menu->display(ui, world);
@@ -347,6 +389,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       case menu::MenuResult::Closed:
         menu.reset();
         throttler.reset();
+        timestep.reset();
         break;
       case menu::MenuResult::ExitToTitle:
         if(allowSave)
@@ -395,8 +438,33 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       continue;
     }
 
-    if(!isCutscene)
+    if(isCutscene)
+    {
+      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Menu) || !world.cinematicLoop())
+        return {RunResult::NextLevel, std::nullopt};
+
+      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Screenshot))
+      {
+        makeScreenshot();
+        throttler.reset();
+      }
+
+      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::BugReport))
+      {
+        takeBugReport(world);
+        throttler.reset();
+      }
+      continue;
+    }
+
+    bool screenshotRequested = false;
+    bool bugReportRequested = false;
+    const auto ticks = timestep.advance();
+    for(size_t tick = 0; tick < ticks && menu == nullptr && !world.levelFinished(); ++tick)
     {
+      // sample the input as late as possible, right before it is consumed
+      m_presenter->getInputHandler().update();
+
       if(world.getObjectManager().getLara().isDead())
       {
         world.getAudioEngine().setMusicGain(0);
@@ -410,7 +478,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
                                                      world,
                                                      m_presenter->getRenderViewport());
           throttler.reset();
-          continue;
+          break;
         }
       }
 
@@ -424,13 +492,13 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
                                                 world,
                                                 m_presenter->getRenderViewport());
         throttler.reset();
-        continue;
+        break;
       }
 
       if(allowSave && m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Save))
       {
         world.save(std::nullopt);
-        throttler.reset();
+        timestep.reset();
       }
       else if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Load))
       {
@@ -450,110 +518,75 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
         blackAlpha = 1 - runtime.cast<float>() / BlendInDuration.cast<float>();
       }
 
-      ui::Ui ui{m_presenter->getMaterialManager()->getUi(), world.getPalette(), m_presenter->getUiViewport()};
+      tickUi.emplace(m_presenter->getUiRenderer(), world.getPalette(), m_presenter->getUiViewport());
 
-      drawAmmoWidget(ui, getPresenter().getTrFont(), world, ammoDisplayDuration);
+      drawAmmoWidget(*tickUi, getPresenter().getTrFont(), world, ammoDisplayDuration);
       if(bugReportSavedDuration != 0_frame)
       {
-        drawBugReportMessage(ui, getPresenter().getTrFont());
+        drawBugReportMessage(*tickUi, getPresenter().getTrFont());
         bugReportSavedDuration -= 1_frame;
       }
 
-      if(ghostManager.reader != nullptr)
-      {
-        ghostManager.model->apply(world, ghostManager.reader->read());
-        for(const auto& room : world.getRooms())
-        {
-          if(room.physicalId != ghostManager.model->getRoomId())
-            continue;
-
-          if(room.node->isVisible())
-          {
-            setParent(gsl::not_null{ghostManager.model}, room.node);
-          }
-          else if(room.alternateRoom != nullptr && room.alternateRoom->node->isVisible())
-          {
-            setParent(gsl::not_null{ghostManager.model}, room.alternateRoom->node);
-          }
-          else
-          {
-            for(const auto& altRoom : world.getRooms())
-            {
-              if(&altRoom != &room)
-                continue;
-
-              setParent(gsl::not_null{ghostManager.model}, altRoom.node);
-              break;
-            }
-          }
-          break;
-        }
-      }
+      ghostManager.update(world);
 
+      interpolator.capture(world);
       world.getPlayer().timeSpent += 1_frame;
-      world.gameLoop(godMode, blackAlpha, ui);
+      world.gameLoop(godMode, blackAlpha, *tickUi);
 
       ghostManager.writer->append(world.getObjectManager().getLara().getGhostFrame());
       world.nextGhostFrame();
+
+      screenshotRequested |= m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Screenshot);
+      bugReportRequested |= m_presenter->getInputHandler().hasDebouncedAction(hid::Action::BugReport);
     }
-    else
+
+    if(menu != nullptr || !tickUi.has_value())
+      continue;
+
     {
-      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Menu) || !world.cinematicLoop())
-        return {RunResult::NextLevel, std::nullopt};
+      // the ui is consumed when rendered, but needs to be presented until the next tick
+      auto ui = *tickUi;
+      interpolator.apply(world, timestep.getAlpha());
+      world.renderFrame(ui);
+      interpolator.restore(world);
     }
+    m_presenter->addFrameTime(frameTimings.endFrame(ticks));
 
-    if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Screenshot))
+    if(screenshotRequested)
     {
       makeScreenshot();
-      throttler.reset();
+      timestep.reset();
     }
 
-    if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::BugReport))
+    if(bugReportRequested)
     {
       takeBugReport(world);
       bugReportSavedDuration = core::FrameRate * 5_sec;
-      throttler.reset();
+      timestep.reset();
     }
   }
 }
 
 void Engine::makeScreenshot()
 {
-  auto img = m_presenter->takeScreenshot();
-  if(!std::filesystem::is_directory(m_userDataPath / "screenshots"))
-    std::filesystem::create_directories(m_userDataPath / "screenshots");
-
-  auto filename = getCurrentHumanReadableTimestamp() + ".png";
-  img.savePng(m_userDataPath / "screenshots" / filename);
+  m_presenter->getScreenCapture().capture(m_presenter->getDisplayViewport(),
+                                          m_userDataPath / "screenshots"
+                                            / (getCurrentHumanReadableTimestamp() + ".png"));
 }
 
 void Engine::takeBugReport(world::World& world)
 {
-  if(!std::filesystem::is_directory(m_userDataPath / "bugreports"))
-  {
-    std::filesystem::create_directory(m_userDataPath / "bugreports");
-  }
-
-  const auto dirName = getCurrentHumanReadableTimestamp();
-  if(!std::filesystem::is_directory(m_userDataPath / "bugreports" / dirName))
-  {
-    std::filesystem::create_directory(m_userDataPath / "bugreports" / dirName);
-  }
-
-  for(std::filesystem::directory_iterator it{m_userDataPath}; it != std::filesystem::directory_iterator{}; ++it)
-  {
-    BOOST_LOG_TRIVIAL(info) << it->path() << "; " << it->path().filename().string();
-    if(!it->is_regular_file() || !boost::algorithm::starts_with(it->path().filename().string(), "croftengine.")
-       || !boost::algorithm::ends_with(it->path().filename().string(), ".log"))
-      continue;
-
-    std::filesystem::copy_file(it->path(), m_userDataPath / "bugreports" / dirName / it->path().filename());
-  }
-
-  auto img = m_presenter->takeScreenshot();
-  img.savePng(m_userDataPath / "bugreports" / dirName / "screenshot.png");
-
-  world.save(m_userDataPath / "bugreports" / dirName / "save.yaml", false);
+  const auto bugReportPath = m_userDataPath / "bugreports" / getCurrentHumanReadableTimestamp();
+  std::filesystem::create_directories(bugReportPath);
+
+  // the world state must be saved immediately, everything else is done in the background
+  world.save(bugReportPath / "save.yaml", false);
+  m_presenter->getScreenCapture().capture(m_presenter->getDisplayViewport(),
+                                          bugReportPath / "screenshot.png",
+                                          [userDataPath = m_userDataPath, bugReportPath]()
+                                          {
+                                            writeBugReportArchive(userDataPath, bugReportPath);
+                                          });
 }
 
 std::pair<RunResult, std::optional<size_t>> Engine::runTitleMenu(world::World& world)
@@ -586,7 +619,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::runTitleMenu(world::World& w
     if(!m_presenter->preFrame())
       continue;
 
-    ui::Ui ui{m_presenter->getMaterialManager()->getUi(), world.getPalette(), m_presenter->getUiViewport()};
+    ui::Ui ui{m_presenter->getUiRenderer(), world.getPalette(), m_presenter->getUiViewport()};
 
     std::shared_ptr<render::scene::Mesh> backdropMesh;
     {
@@ -734,10 +767,6 @@ void Engine::applySettings()
     for(auto& room : world->getRooms())
     {
       room.collectShaderLights(m_engineConfig->renderSettings.getLightCollectionDepth());
-      room.regenerateDust(m_presenter,
-                          m_presenter->getMaterialManager()->getDustParticle(),
-                          m_engineConfig->renderSettings.dustActive,
-                          m_engineConfig->renderSettings.dustDensity);
     }
   }
 }
@@ -749,6 +778,13 @@ std::filesystem::path Engine::getSavegameRootPath() const
   return p;
 }
 
+std::filesystem::path Engine::getTextureCachePath() const
+{
+  auto p = m_userDataPath / "cache" / "textures";
+  std::filesystem::create_directories(p);
+  return p;
+}
+
 std::filesystem::path Engine::getSavegamePath(const std::optional<size_t>& slot) const
 {
   const auto root = getSavegameRootPath();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "levelprefetcher.h"
 #include "script/scriptengine.h"
 #include "serialization/serialization_fwd.h"
 
@@ -86,6 +87,7 @@ private:
   std::string m_locale;
 
   std::unique_ptr<loader::trx::Glidos> m_glidos;
+  LevelPrefetcher m_levelPrefetcher;
   [[nodiscard]] std::unique_ptr<loader::trx::Glidos> loadGlidosPack() const;
 
   void makeScreenshot();
@@ -130,6 +132,7 @@ public:
   [[nodiscard]] std::filesystem::path getSavegameRootPath() const;
   [[nodiscard]] std::filesystem::path getSavegamePath(const std::optional<size_t>& slot) const;
   [[nodiscard]] std::filesystem::path getAssetDataPath() const;
+  [[nodiscard]] std::filesystem::path getTextureCachePath() const;
 
   [[nodiscard]] const std::filesystem::path& getEngineDataPath() const
   {
@@ -184,5 +187,10 @@ public:
   {
     return m_gameflowId;
   }
+
+  [[nodiscard]] auto& getLevelPrefetcher()
+  {
+    return m_levelPrefetcher;
+  }
 };
 } // namespace engine
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/magic.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <cstddef>
+
+namespace engine
+{
+/**
+ * Hands out elapsed real time in fixed simulation ticks, so that rendering can run at any rate while the simulation
+ * keeps running at core::FrameRate.
+ */
+class FixedTimestep
+{
+public:
+  //! Limits the number of ticks per frame, so that a stall is not followed by an ever growing catch-up.
+  static constexpr size_t MaxTicksPerFrame = 4;
+
+  FixedTimestep()
+      : m_lastTime{Clock::now()}
+  {
+  }
+
+  //! Accumulates the time elapsed since the last call, and returns the number of ticks that are due.
+  [[nodiscard]] size_t advance()
+  {
+    const auto now = Clock::now();
+    m_accumulator += std::chrono::duration_cast<TimeType>(now - m_lastTime);
+    m_lastTime = now;
+
+    const auto ticks = static_cast<size_t>(m_accumulator / TickDuration);
+    m_accumulator %= TickDuration;
+    return std::min(ticks, MaxTicksPerFrame);
+  }
+
+  //! The fraction of a tick that has elapsed since the last tick, used for interpolating the presentation.
+  [[nodiscard]] float getAlpha() const
+  {
+    return std::clamp(static_cast<float>(m_accumulator.count()) / static_cast<float>(TickDuration.count()), 0.0f, 1.0f);
+  }
+
+  void reset()
+  {
+    m_lastTime = Clock::now();
+    m_accumulator = TimeType::zero();
+  }
+
+private:
+  using Clock = std::chrono::high_resolution_clock;
+  using TimeType = std::chrono::microseconds;
+  static constexpr TimeType TickDuration
+    = std::chrono::duration_cast<TimeType>(std::chrono::seconds(1)) / core::FrameRate.get();
+
+  Clock::time_point m_lastTime;
+  TimeType m_accumulator = TimeType::zero();
+};
+
+/**
+ * Collects presentation timings, i.e. the rate of rendered frames and simulation ticks, and the time between sampling
+ * the input and presenting the result, and periodically logs them.
+ */
+class FrameTimings
+{
+public:
+  void beginFrame()
+  {
+    m_frameStart = Clock::now();
+  }
+
+  //! Returns the duration of the frame.
+  auto endFrame(size_t ticks)
+  {
+    const auto now = Clock::now();
+    const auto frameTime = std::chrono::duration_cast<TimeType>(now - m_frameStart);
+    ++m_frames;
+    m_ticks += ticks;
+    m_totalFrameTime += frameTime;
+    m_maxFrameTime = std::max(m_maxFrameTime, frameTime);
+
+    const auto elapsed = now - m_periodStart;
+    if(elapsed < ReportPeriod)
+      return frameTime;
+
+    const auto seconds = std::chrono::duration<float>(elapsed).count();
+    BOOST_LOG_TRIVIAL(debug) << "Presentation: " << static_cast<float>(m_frames) / seconds << " fps, "
+                             << static_cast<float>(m_ticks) / seconds << " ticks/s, input to present avg "
+                             << m_totalFrameTime.count() / m_frames << " us, max " << m_maxFrameTime.count() << " us";
+
+    m_periodStart = now;
+    m_frames = 0;
+    m_ticks = 0;
+    m_totalFrameTime = TimeType::zero();
+    m_maxFrameTime = TimeType::zero();
+    return frameTime;
+  }
+
+private:
+  using Clock = std::chrono::high_resolution_clock;
+  using TimeType = std::chrono::microseconds;
+  static constexpr auto ReportPeriod = std::chrono::seconds(10);
+
+  Clock::time_point m_periodStart = Clock::now();
+  Clock::time_point m_frameStart = Clock::now();
+  size_t m_frames = 0;
+  size_t m_ticks = 0;
+  TimeType m_totalFrameTime = TimeType::zero();
+  TimeType m_maxFrameTime = TimeType::zero();
+};
+} // namespace engine
@@ -1,48 +1,34 @@
 #include "ghost.h"
 
+#include "ghostcodec.h"
+#include "serialization/optional_value.h"
 #include "serialization/path.h"
 #include "serialization/quantity.h"
 #include "serialization/serialization.h"
 
 #include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <gsl/gsl-lite.hpp>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace engine::ghosting
 {
-constexpr uint32_t DataStreamVersion = 2;
+constexpr uint32_t DataStreamVersion = 3;
+constexpr uint32_t LegacyDataStreamVersion = 2;
 
 namespace
 {
 constexpr int16_t MatrixRotationScale = 32767;
-
-void writeMatrix(std::ostream& s, const glm::mat4& m)
-{
-  BOOST_ASSERT(m[0][3] == 0);
-  BOOST_ASSERT(m[1][3] == 0);
-  BOOST_ASSERT(m[2][3] == 0);
-  BOOST_ASSERT(m[3][3] == 1);
-
-  for(int x = 0; x < 4; ++x)
-  {
-    for(int y = 0; y < 3; ++y)
-    {
-      if(x != 3)
-      {
-        BOOST_ASSERT(m[x][y] >= -1.0f);
-        BOOST_ASSERT(m[x][y] <= 1.0f);
-        auto scaled = gsl::narrow_cast<int16_t>(m[x][y] * MatrixRotationScale);
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.write(reinterpret_cast<const char*>(&scaled), sizeof(scaled));
-      }
-      else
-      {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        s.write(reinterpret_cast<const char*>(&m[x][y]), sizeof(m[x][y]));
-      }
-    }
-  }
-}
+// maximum number of blocks buffered between the game loop and the i/o thread
+constexpr size_t QueueLimit = 4;
 
 [[nodiscard]] glm::mat4 readMatrix(std::istream& s)
 {
@@ -67,21 +53,54 @@ void writeMatrix(std::ostream& s, const glm::mat4& m)
   }
   return m;
 }
-} // namespace
 
-void GhostFrame::write(std::ostream& s) const
+struct BlockHeader
 {
-  uint8_t size = gsl::narrow<uint8_t>(bones.size());
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&size), sizeof(size));
-  for(const auto& bone : bones)
-    bone.write(s);
+  uint32_t frameCount = 0;
+  uint32_t dataSize = 0;
+};
 
+[[nodiscard]] std::optional<BlockHeader> readBlockHeader(std::istream& s)
+{
+  BlockHeader header;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  s.read(reinterpret_cast<char*>(&header.frameCount), sizeof(header.frameCount));
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&roomId), sizeof(roomId));
+  s.read(reinterpret_cast<char*>(&header.dataSize), sizeof(header.dataSize));
+  if(!s.good())
+    return std::nullopt;
+  return header;
+}
 
-  writeMatrix(s, modelMatrix);
+/**
+ * Skips all complete blocks before @a frame by only reading their headers, and returns the number of skipped frames.
+ * The stream is left at the header of the block containing @a frame.
+ */
+[[nodiscard]] size_t skipBlocks(std::istream& s, size_t frame)
+{
+  const auto begin = s.tellg();
+  s.seekg(0, std::ios::end);
+  const auto end = s.tellg();
+  s.seekg(begin);
+
+  size_t skipped = 0;
+  while(true)
+  {
+    const auto blockBegin = s.tellg();
+    const auto header = readBlockHeader(s);
+    if(!header.has_value() || skipped + header->frameCount > frame
+       || s.tellg() + std::streamoff{header->dataSize} > end)
+    {
+      s.clear();
+      s.seekg(blockBegin);
+      return skipped;
+    }
+
+    s.seekg(header->dataSize, std::ios::cur);
+    skipped += header->frameCount;
+  }
 }
+} // namespace
 
 void GhostFrame::read(std::istream& s)
 {
@@ -105,48 +124,306 @@ GhostDataWriter::GhostDataWriter(const std::filesystem::path& path)
 {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
   m_file->write(reinterpret_cast<const char*>(&DataStreamVersion), sizeof(DataStreamVersion));
+  m_pending.reserve(GhostBlockFrames);
+  m_writerThread = std::thread{&GhostDataWriter::writerLoop, this};
 }
 
-GhostDataWriter::~GhostDataWriter() = default;
+GhostDataWriter::GhostDataWriter(const std::filesystem::path& path,
+                                 const std::filesystem::path& source,
+                                 const core::Frame& frames)
+    : m_file{std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc)}
+{
+  m_pending.reserve(GhostBlockFrames);
+
+  const auto frameCount = gsl::narrow<size_t>(frames.get());
+  std::ifstream sourceFile{source, std::ios::binary};
+  uint32_t sourceVersion = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  sourceFile.read(reinterpret_cast<char*>(&sourceVersion), sizeof(sourceVersion));
+  size_t copied = 0;
+  if(sourceFile.good() && sourceVersion == DataStreamVersion)
+  {
+    copied = copyBlocks(sourceFile, frameCount);
+  }
+  else
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    m_file->write(reinterpret_cast<const char*>(&DataStreamVersion), sizeof(DataStreamVersion));
+  }
+
+  m_writerThread = std::thread{&GhostDataWriter::writerLoop, this};
+
+  if(copied < frameCount && sourceFile.is_open() && sourceVersion == LegacyDataStreamVersion)
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Converting legacy ghost data " << source;
+    GhostDataReader reader{source};
+    for(; copied < frameCount; ++copied)
+      append(reader.read());
+  }
+
+  for(; copied < frameCount; ++copied)
+    append({});
+}
+
+size_t GhostDataWriter::copyBlocks(std::istream& source, size_t frameCount)
+{
+  // complete blocks are copied verbatim, including the version of the stream
+  const auto skipped = skipBlocks(source, frameCount);
+  const auto end = source.tellg();
+  source.seekg(0);
+
+  static constexpr std::streamsize BufferSize = 64 * 1024;
+  std::vector<char> buffer;
+  buffer.resize(BufferSize);
+  for(std::streamoff remaining = end; remaining > 0;)
+  {
+    const auto n = std::min<std::streamoff>(BufferSize, remaining);
+    source.read(buffer.data(), n);
+    if(source.gcount() != n)
+      BOOST_THROW_EXCEPTION(std::runtime_error("Failed to copy ghost data"));
+    m_file->write(buffer.data(), n);
+    remaining -= n;
+  }
+
+  if(skipped == frameCount)
+    return skipped;
+
+  // the remaining frames are taken from the beginning of the next block, and are encoded again together with the
+  // following frames
+  const auto header = readBlockHeader(source);
+  if(!header.has_value())
+    return skipped;
+
+  std::vector<uint8_t> data;
+  data.resize(header->dataSize);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  source.read(reinterpret_cast<char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+  if(!source.good())
+    return skipped;
+
+  auto frames = decodeGhostBlock(data);
+  const auto remaining = std::min(frameCount - skipped, frames.size());
+  std::move(frames.begin(),
+            std::next(frames.begin(), gsl::narrow<std::ptrdiff_t>(remaining)),
+            std::back_inserter(m_pending));
+  return skipped + remaining;
+}
+
+GhostDataWriter::~GhostDataWriter()
+{
+  submitPending();
+  {
+    std::lock_guard lock{m_queueMutex};
+    m_shutdown = true;
+  }
+  m_queueCondition.notify_all();
+  m_writerThread.join();
+  m_file->flush();
+}
 
 void GhostDataWriter::append(const GhostFrame& frame)
 {
-  frame.write(*m_file);
+  m_pending.emplace_back(frame);
+  if(m_pending.size() >= GhostBlockFrames)
+    submitPending();
 }
 
-GhostDataReader::GhostDataReader(const std::filesystem::path& path)
+void GhostDataWriter::submitPending()
+{
+  if(m_pending.empty())
+    return;
+
+  {
+    std::unique_lock lock{m_queueMutex};
+    m_queueCondition.wait(lock,
+                          [this]()
+                          {
+                            return m_queue.size() < QueueLimit;
+                          });
+    m_queue.emplace_back(std::move(m_pending));
+  }
+  m_queueCondition.notify_all();
+
+  m_pending.clear();
+  m_pending.reserve(GhostBlockFrames);
+}
+
+void GhostDataWriter::writerLoop()
+{
+  while(true)
+  {
+    std::vector<GhostFrame> frames;
+    {
+      std::unique_lock lock{m_queueMutex};
+      m_queueCondition.wait(lock,
+                            [this]()
+                            {
+                              return m_shutdown || !m_queue.empty();
+                            });
+      if(m_queue.empty())
+        return;
+
+      frames = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    m_queueCondition.notify_all();
+
+    try
+    {
+      const auto data = encodeGhostBlock(frames);
+      const auto frameCount = gsl::narrow<uint32_t>(frames.size());
+      const auto dataSize = gsl::narrow<uint32_t>(data.size());
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      m_file->write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      m_file->write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      m_file->write(reinterpret_cast<const char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+    }
+    catch(std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(error) << "Failed to write ghost data: " << ex.what();
+    }
+  }
+}
+
+GhostDataReader::GhostDataReader(const std::filesystem::path& path, const core::Frame& start)
     : m_file{std::make_unique<std::ifstream>(path, std::ios::binary)}
 {
-  uint32_t version = 0;
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  m_file->read(reinterpret_cast<char*>(&version), sizeof(version));
-  if(version != DataStreamVersion)
+  m_file->read(reinterpret_cast<char*>(&m_version), sizeof(m_version));
+  if(m_version != DataStreamVersion && m_version != LegacyDataStreamVersion)
   {
     m_file.reset();
+    return;
   }
+
+  const auto startFrame = gsl::narrow<size_t>(start.get());
+  if(m_version == LegacyDataStreamVersion)
+  {
+    // legacy frames have varying sizes, so they need to be parsed
+    for(size_t i = 0; i < startFrame && m_file->peek() != std::char_traits<char>::eof(); ++i)
+      GhostFrame{}.read(*m_file);
+  }
+  else
+  {
+    m_skip = startFrame - skipBlocks(*m_file, startFrame);
+  }
+
+  m_readerThread = std::thread{&GhostDataReader::readerLoop, this};
 }
 
-GhostDataReader::~GhostDataReader() = default;
+GhostDataReader::~GhostDataReader()
+{
+  if(!m_readerThread.joinable())
+    return;
+
+  {
+    std::lock_guard lock{m_queueMutex};
+    m_shutdown = true;
+  }
+  m_queueCondition.notify_all();
+  m_readerThread.join();
+}
 
 GhostFrame GhostDataReader::read()
 {
-  GhostFrame result;
-  if(m_file != nullptr && !m_file->eof())
+  if(m_file == nullptr)
+    return {};
+
+  if(m_currentIndex >= m_current.size())
   {
-    result.read(*m_file);
+    {
+      std::unique_lock lock{m_queueMutex};
+      m_queueCondition.wait(lock,
+                            [this]()
+                            {
+                              return m_eof || !m_queue.empty();
+                            });
+      if(m_queue.empty())
+        return {};
+
+      m_current = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    m_queueCondition.notify_all();
+    m_currentIndex = std::min(std::exchange(m_skip, 0), m_current.size());
+
+    if(m_currentIndex >= m_current.size())
+      return {};
   }
-  return result;
+
+  return std::move(m_current[m_currentIndex++]);
 }
 
-void GhostFrame::BoneData::write(std::ostream& s) const
+std::optional<std::vector<GhostFrame>> GhostDataReader::readBlock()
 {
-  writeMatrix(s, matrix);
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&meshIdx), sizeof(meshIdx));
+  if(m_version == LegacyDataStreamVersion)
+  {
+    std::vector<GhostFrame> frames;
+    while(frames.size() < GhostBlockFrames && m_file->peek() != std::char_traits<char>::eof())
+    {
+      frames.emplace_back().read(*m_file);
+    }
+    if(frames.empty())
+      return std::nullopt;
+    return frames;
+  }
+
+  const auto header = readBlockHeader(*m_file);
+  if(!header.has_value())
+    return std::nullopt;
 
-  uint8_t tmp = visible ? 1 : 0;
+  std::vector<uint8_t> data;
+  data.resize(header->dataSize);
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  s.write(reinterpret_cast<const char*>(&tmp), sizeof(tmp));
+  m_file->read(reinterpret_cast<char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+  if(!m_file->good())
+    return std::nullopt;
+
+  auto frames = decodeGhostBlock(data);
+  if(frames.size() != header->frameCount)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Ghost block frame count mismatch"));
+  return frames;
+}
+
+void GhostDataReader::readerLoop()
+{
+  while(true)
+  {
+    {
+      std::unique_lock lock{m_queueMutex};
+      m_queueCondition.wait(lock,
+                            [this]()
+                            {
+                              return m_shutdown || m_queue.size() < QueueLimit;
+                            });
+      if(m_shutdown)
+        return;
+    }
+
+    std::optional<std::vector<GhostFrame>> frames;
+    try
+    {
+      frames = readBlock();
+    }
+    catch(std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(error) << "Failed to read ghost data: " << ex.what();
+    }
+
+    {
+      std::lock_guard lock{m_queueMutex};
+      if(frames.has_value())
+        m_queue.emplace_back(std::move(*frames));
+      else
+        m_eof = true;
+    }
+    m_queueCondition.notify_all();
+
+    if(!frames.has_value())
+      return;
+  }
 }
 
 void GhostFrame::BoneData::read(std::istream& s)
@@ -163,6 +440,10 @@ void GhostFrame::BoneData::read(std::istream& s)
 
 void GhostMeta::serialize(const serialization::Serializer<GhostMeta>& ser)
 {
-  ser(S_NV("duration", duration), S_NV("finishState", finishState), S_NV("level", level), S_NV("gameflow", gameflow));
+  ser(S_NV("duration", duration),
+      S_NV("finishState", finishState),
+      S_NV("level", level),
+      S_NV("gameflow", gameflow),
+      S_NVO("randomStreams", randomStreams));
 }
 } // namespace engine::ghosting
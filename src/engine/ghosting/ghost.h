@@ -1,16 +1,22 @@
 #pragma once
 
 #include "core/units.h"
+#include "engine/randomstreams.h"
 #include "ghostfinishstate.h"
 #include "serialization/named_enum.h"
 #include "serialization/serialization_fwd.h"
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <glm/mat4x4.hpp>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace engine::ghosting
@@ -23,6 +29,8 @@ struct GhostMeta
   NamedGhostFinishState finishState = GhostFinishState::Unfinished;
   std::filesystem::path level{};
   std::string gameflow{};
+  //! The random streams of the world when the recording started.
+  RandomStreams randomStreams{};
 
   void serialize(const serialization::Serializer<GhostMeta>& ser);
 };
@@ -35,7 +43,7 @@ struct GhostFrame
     uint16_t meshIdx = 0;
     bool visible = false;
 
-    void write(std::ostream& s) const;
+    // legacy v2 format
     void read(std::istream& s);
   };
 
@@ -43,26 +51,47 @@ struct GhostFrame
   glm::mat4 modelMatrix{1.0f};
   std::vector<BoneData> bones{};
 
-  void write(std::ostream& s) const;
+  // legacy v2 format
   void read(std::istream& s);
 };
 
+/**
+ * Collects frames into blocks which are encoded, compressed and written by a background thread.
+ */
 class GhostDataWriter
 {
 public:
   explicit GhostDataWriter(const std::filesystem::path& path);
+  //! Starts with the first @a frames frames of @a source, padded with empty frames if it's too short.
+  explicit GhostDataWriter(const std::filesystem::path& path,
+                           const std::filesystem::path& source,
+                           const core::Frame& frames);
   ~GhostDataWriter();
 
   void append(const GhostFrame& frame);
 
 private:
+  [[nodiscard]] size_t copyBlocks(std::istream& source, size_t frameCount);
+  void submitPending();
+  void writerLoop();
+
   std::unique_ptr<std::ostream> m_file;
+  std::vector<GhostFrame> m_pending;
+
+  std::deque<std::vector<GhostFrame>> m_queue;
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  bool m_shutdown = false;
+  std::thread m_writerThread;
 };
 
+/**
+ * Decodes blocks ahead of time on a background thread, so that reading a frame never touches the file.
+ */
 class GhostDataReader
 {
 public:
-  explicit GhostDataReader(const std::filesystem::path& path);
+  explicit GhostDataReader(const std::filesystem::path& path, const core::Frame& start = 0_frame);
   ~GhostDataReader();
 
   [[nodiscard]] GhostFrame read();
@@ -73,6 +102,22 @@ public:
   }
 
 private:
+  [[nodiscard]] std::optional<std::vector<GhostFrame>> readBlock();
+  void readerLoop();
+
   std::unique_ptr<std::istream> m_file;
+  uint32_t m_version = 0;
+
+  std::vector<GhostFrame> m_current;
+  size_t m_currentIndex = 0;
+  //! Frames to skip within the first block.
+  size_t m_skip = 0;
+
+  std::deque<std::vector<GhostFrame>> m_queue;
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  bool m_shutdown = false;
+  bool m_eof = false;
+  std::thread m_readerThread;
 };
 } // namespace engine::ghosting
\ No newline at end of file
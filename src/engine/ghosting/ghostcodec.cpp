@@ -0,0 +1,208 @@
+#include "ghostcodec.h"
+
+#include "compressedblock.h"
+#include "ghost.h"
+
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <stdexcept>
+
+namespace engine::ghosting
+{
+namespace
+{
+constexpr float QuaternionScale = 32767;
+constexpr float TranslationScale = 16;
+
+// per-frame channel layout: room id, bone count, model transform, then per bone the transform, mesh index and
+// visibility
+constexpr size_t TransformChannels = 7;
+constexpr size_t FrameHeaderChannels = 2 + TransformChannels;
+constexpr size_t BoneChannels = TransformChannels + 2;
+
+enum class FrameType : uint8_t
+{
+  Key = 0,
+  Delta = 1
+};
+
+using Channels = std::vector<int32_t>;
+
+void appendTransform(Channels& channels, const glm::mat4& m, const Channels& previous)
+{
+  auto q = glm::normalize(glm::quat_cast(glm::mat3{m}));
+
+  // q and -q are the same rotation; stay in the hemisphere of the previous frame to keep the deltas small
+  const auto offset = channels.size();
+  if(previous.size() >= offset + 4)
+  {
+    const auto dot = static_cast<float>(previous[offset + 0]) * q.x + static_cast<float>(previous[offset + 1]) * q.y
+                     + static_cast<float>(previous[offset + 2]) * q.z + static_cast<float>(previous[offset + 3]) * q.w;
+    if(dot < 0)
+      q = -q;
+  }
+
+  channels.emplace_back(static_cast<int32_t>(std::lround(q.x * QuaternionScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(q.y * QuaternionScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(q.z * QuaternionScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(q.w * QuaternionScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(m[3][0] * TranslationScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(m[3][1] * TranslationScale)));
+  channels.emplace_back(static_cast<int32_t>(std::lround(m[3][2] * TranslationScale)));
+}
+
+[[nodiscard]] glm::mat4 toTransform(const gsl::span<const int32_t>& channels)
+{
+  BOOST_ASSERT(channels.size() >= TransformChannels);
+  const glm::quat q{static_cast<float>(channels[3]) / QuaternionScale,
+                    static_cast<float>(channels[0]) / QuaternionScale,
+                    static_cast<float>(channels[1]) / QuaternionScale,
+                    static_cast<float>(channels[2]) / QuaternionScale};
+  auto m = glm::mat4_cast(glm::normalize(q));
+  m[3] = glm::vec4{static_cast<float>(channels[4]) / TranslationScale,
+                   static_cast<float>(channels[5]) / TranslationScale,
+                   static_cast<float>(channels[6]) / TranslationScale,
+                   1.0f};
+  return m;
+}
+
+[[nodiscard]] Channels toChannels(const GhostFrame& frame, const Channels& previous)
+{
+  Channels channels;
+  channels.reserve(FrameHeaderChannels + frame.bones.size() * BoneChannels);
+  channels.emplace_back(frame.roomId);
+  channels.emplace_back(gsl::narrow<int32_t>(frame.bones.size()));
+  appendTransform(channels, frame.modelMatrix, previous);
+  for(const auto& bone : frame.bones)
+  {
+    appendTransform(channels, bone.matrix, previous);
+    channels.emplace_back(bone.meshIdx);
+    channels.emplace_back(bone.visible ? 1 : 0);
+  }
+  return channels;
+}
+
+[[nodiscard]] GhostFrame fromChannels(const Channels& channels)
+{
+  if(channels.size() < FrameHeaderChannels)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Ghost frame is truncated"));
+
+  const auto boneCount = gsl::narrow<size_t>(channels[1]);
+  if(channels.size() != FrameHeaderChannels + boneCount * BoneChannels)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Ghost frame has an invalid size"));
+
+  const gsl::span<const int32_t> data{channels};
+  GhostFrame frame;
+  frame.roomId = gsl::narrow<uint16_t>(channels[0]);
+  frame.modelMatrix = toTransform(data.subspan(2, TransformChannels));
+  frame.bones.reserve(boneCount);
+  for(size_t i = 0; i < boneCount; ++i)
+  {
+    const auto bone = data.subspan(FrameHeaderChannels + i * BoneChannels, BoneChannels);
+    frame.bones.emplace_back(GhostFrame::BoneData{
+      toTransform(bone), gsl::narrow<uint16_t>(bone[TransformChannels]), bone[TransformChannels + 1] != 0});
+  }
+  return frame;
+}
+
+void writeVarUInt(std::vector<uint8_t>& dst, uint64_t value)
+{
+  while(value >= 0x80u)
+  {
+    dst.emplace_back(static_cast<uint8_t>(value | 0x80u));
+    value >>= 7u;
+  }
+  dst.emplace_back(static_cast<uint8_t>(value));
+}
+
+void writeVarInt(std::vector<uint8_t>& dst, int64_t value)
+{
+  // zig-zag encoding, so that small negative values stay small
+  writeVarUInt(dst, (static_cast<uint64_t>(value) << 1u) ^ static_cast<uint64_t>(value >> 63));
+}
+
+[[nodiscard]] uint64_t readVarUInt(const gsl::span<const uint8_t>& src, size_t& pos)
+{
+  uint64_t value = 0;
+  for(uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    if(pos >= src.size())
+      BOOST_THROW_EXCEPTION(std::runtime_error("Ghost block is truncated"));
+
+    const auto b = src[pos++];
+    value |= static_cast<uint64_t>(b & 0x7fu) << shift;
+    if((b & 0x80u) == 0)
+      return value;
+  }
+  BOOST_THROW_EXCEPTION(std::runtime_error("Ghost block contains an invalid value"));
+}
+
+[[nodiscard]] int64_t readVarInt(const gsl::span<const uint8_t>& src, size_t& pos)
+{
+  const auto value = readVarUInt(src, pos);
+  return static_cast<int64_t>(value >> 1u) ^ -static_cast<int64_t>(value & 1u);
+}
+} // namespace
+
+std::vector<uint8_t> encodeGhostBlock(const gsl::span<const GhostFrame>& frames)
+{
+  std::vector<uint8_t> data;
+  Channels previous;
+  for(const auto& frame : frames)
+  {
+    auto channels = toChannels(frame, previous);
+    const auto type = previous.size() == channels.size() ? FrameType::Delta : FrameType::Key;
+    data.emplace_back(static_cast<uint8_t>(type));
+    writeVarUInt(data, channels.size());
+    for(size_t i = 0; i < channels.size(); ++i)
+    {
+      if(type == FrameType::Delta)
+        writeVarInt(data, static_cast<int64_t>(channels[i]) - previous[i]);
+      else
+        writeVarInt(data, channels[i]);
+    }
+    previous = std::move(channels);
+  }
+
+  return compressXz(data);
+}
+
+std::vector<GhostFrame> decodeGhostBlock(const gsl::span<const uint8_t>& data)
+{
+  const auto raw = decompressBlock(data);
+  const gsl::span<const uint8_t> src{raw};
+
+  std::vector<GhostFrame> frames;
+  Channels channels;
+  size_t pos = 0;
+  while(pos < src.size())
+  {
+    const auto type = static_cast<FrameType>(src[pos++]);
+    const auto size = gsl::narrow<size_t>(readVarUInt(src, pos));
+    switch(type)
+    {
+    case FrameType::Key:
+      channels.resize(size);
+      for(auto& value : channels)
+        value = gsl::narrow<int32_t>(readVarInt(src, pos));
+      break;
+    case FrameType::Delta:
+      if(size != channels.size())
+        BOOST_THROW_EXCEPTION(std::runtime_error("Ghost delta frame does not match its predecessor"));
+      for(auto& value : channels)
+        value = gsl::narrow<int32_t>(value + readVarInt(src, pos));
+      break;
+    default:
+      BOOST_THROW_EXCEPTION(std::runtime_error("Invalid ghost frame type"));
+    }
+
+    frames.emplace_back(fromChannels(channels));
+  }
+
+  return frames;
+}
+} // namespace engine::ghosting
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl-lite.hpp>
+#include <vector>
+
+namespace engine::ghosting
+{
+struct GhostFrame;
+
+//! Each block starts with a key frame, so it can be decoded on its own.
+constexpr size_t GhostBlockFrames = 64;
+
+/**
+ * Encodes frames into a compressed block.
+ *
+ * Rotations are stored as quantised quaternions, translations as fixed-point values, and all values except those of
+ * the first frame are stored as deltas to the previous frame, before the whole block is compressed.
+ */
+[[nodiscard]] extern std::vector<uint8_t> encodeGhostBlock(const gsl::span<const GhostFrame>& frames);
+
+[[nodiscard]] extern std::vector<GhostFrame> decodeGhostBlock(const gsl::span<const uint8_t>& data);
+} // namespace engine::ghosting
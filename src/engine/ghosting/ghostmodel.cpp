@@ -5,69 +5,118 @@
 #include "engine/presenter.h"
 #include "engine/world/rendermeshdata.h"
 #include "engine/world/world.h"
-#include "ghost.h"
 #include "render/material/materialgroup.h"
 #include "render/material/materialmanager.h"
 #include "render/material/rendermode.h"
 #include "render/scene/mesh.h"
+#include "render/scene/renderable.h"
 
 #include <gl/buffer.h>
+#include <gl/program.h>
 #include <gl/renderstate.h>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace engine::ghosting
 {
-void GhostModel::apply(const world::World& world, const GhostFrame& frame)
+class InstancedGhostMesh final : public render::scene::Renderable
 {
-  setLocalMatrix(frame.modelMatrix);
-  m_roomId = frame.roomId;
+public:
+  explicit InstancedGhostMesh(gslu::nn_shared<render::scene::Mesh> mesh)
+      : m_mesh{std::move(mesh)}
+  {
+  }
 
-  engine::world::RenderMeshDataCompositor compositor;
-  std::vector<glm::mat4> matrices;
-  matrices.reserve(frame.bones.size());
-  for(const auto& bone : frame.bones)
+  void render(const render::scene::Node* node, render::scene::RenderContext& context) override
   {
-    matrices.emplace_back(bone.matrix);
-    if(!bone.visible)
-      compositor.appendEmpty();
-    else
-      compositor.append(*world.getMeshes().at(bone.meshIdx).meshData, gl::SRGBA8{0, 0, 0, 0});
+    if(m_instanceCount > 0)
+      m_mesh->render(node, context, m_instanceCount);
   }
 
-  if(compositor.empty())
+  void render(const render::scene::Node* node,
+              render::scene::RenderContext& context,
+              gl::api::core::SizeType instanceCount) override
   {
-    setRenderable(nullptr);
+    if(m_instanceCount > 0 && instanceCount > 0)
+      m_mesh->render(node, context, m_instanceCount * instanceCount);
   }
-  else
+
+  void setInstanceCount(gl::api::core::SizeType instanceCount)
+  {
+    m_instanceCount = instanceCount;
+  }
+
+private:
+  gslu::nn_shared<render::scene::Mesh> m_mesh;
+  gl::api::core::SizeType m_instanceCount = 0;
+};
+
+GhostModel::GhostModel(const world::World& world, const std::vector<uint16_t>& meshIndices)
+    : render::scene::Node{"ghost"}
+    , m_boneCount{meshIndices.size()}
+{
+  bind("u_boneCount",
+       [boneCount = gsl::narrow<int32_t>(m_boneCount)](
+         const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+       {
+         uniform.set(boneCount);
+       });
+
+  engine::world::RenderMeshDataCompositor compositor;
+  for(const auto meshIdx : meshIndices)
   {
-    auto mesh = compositor.toMesh(
-      *world.getPresenter().getMaterialManager(),
-      true,
-      false,
-      [&engine = world.getEngine()]()
-      {
-        return engine.getEngineConfig()->animSmoothing;
-      },
-      [&engine = world.getEngine()]()
-      {
-        const auto& settings = engine.getEngineConfig()->renderSettings;
-        return !settings.lightingModeActive ? 0 : settings.lightingMode;
-      },
-      getName());
-    mesh->getMaterialGroup().set(render::material::RenderMode::Full,
-                                 world.getPresenter().getMaterialManager()->getGhost(
-                                   [&engine = world.getEngine()]()
-                                   {
-                                     return engine.getEngineConfig()->animSmoothing;
-                                   }));
-    mesh->getMaterialGroup().set(render::material::RenderMode::DepthOnly, nullptr);
-    mesh->getRenderState().setScissorTest(false);
-    setRenderable(mesh);
+    if(meshIdx >= world.getMeshes().size())
+      compositor.appendEmpty();
+    else
+      compositor.append(*world.getMeshes()[meshIdx].meshData, gl::SRGBA8{0, 0, 0, 0});
   }
 
-  if(m_meshMatricesBuffer == nullptr || m_meshMatricesBuffer->size() != matrices.size())
+  if(compositor.empty())
+    return;
+
+  auto mesh = compositor.toMesh(
+    *world.getPresenter().getMaterialManager(),
+    true,
+    false,
+    [&engine = world.getEngine()]()
+    {
+      return engine.getEngineConfig()->animSmoothing;
+    },
+    [&engine = world.getEngine()]()
+    {
+      const auto& settings = engine.getEngineConfig()->renderSettings;
+      return !settings.lightingModeActive ? 0 : settings.lightingMode;
+    },
+    getName());
+  mesh->getMaterialGroup().set(render::material::RenderMode::Full,
+                               world.getPresenter().getMaterialManager()->getGhost(
+                                 [&engine = world.getEngine()]()
+                                 {
+                                   return engine.getEngineConfig()->animSmoothing;
+                                 }));
+  mesh->getMaterialGroup().set(render::material::RenderMode::DepthOnly, nullptr);
+  mesh->getRenderState().setScissorTest(false);
+  m_instancedMesh = std::make_shared<InstancedGhostMesh>(mesh);
+  setRenderable(m_instancedMesh);
+}
+
+GhostModel::~GhostModel() = default;
+
+void GhostModel::setInstances(const std::vector<glm::mat4>& matrices)
+{
+  BOOST_ASSERT(m_boneCount == 0 || matrices.size() % m_boneCount == 0);
+
+  if(m_instancedMesh == nullptr)
+    return;
+
+  m_instancedMesh->setInstanceCount(
+    gsl::narrow<gl::api::core::SizeType>(m_boneCount == 0 ? 0 : matrices.size() / m_boneCount));
+  if(matrices.empty())
+    return;
+
+  if(m_meshMatricesBuffer == nullptr || m_meshMatricesBuffer->size() < matrices.size())
   {
     m_meshMatricesBuffer = std::make_unique<gl::ShaderStorageBuffer<glm::mat4>>(
       "mesh-matrices-ssb", gl::api::BufferUsage::DynamicDraw, matrices);
@@ -2,10 +2,13 @@
 
 #include "render/scene/node.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <gl/buffer.h>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace engine::world
 {
@@ -14,17 +17,21 @@ class World;
 
 namespace engine::ghosting
 {
-struct GhostFrame;
-
+class InstancedGhostMesh;
+
+/**
+ * Renders all ghosts sharing the same set of bone meshes with a single instanced draw call.
+ *
+ * The mesh matrices buffer contains @a getBoneCount() world space matrices per instance, so the node itself is
+ * expected to be placed at the origin.
+ */
 class GhostModel final : public render::scene::Node
 {
 public:
-  GhostModel()
-      : render::scene::Node{"ghost"}
-  {
-  }
+  explicit GhostModel(const engine::world::World& world, const std::vector<uint16_t>& meshIndices);
+  ~GhostModel() override;
 
-  void apply(const engine::world::World& world, const GhostFrame& frame);
+  void setInstances(const std::vector<glm::mat4>& matrices);
 
   [[nodiscard]] const auto& getMeshMatricesBuffer() const
   {
@@ -34,13 +41,14 @@ public:
     return *m_meshMatricesBuffer;
   }
 
-  [[nodiscard]] auto getRoomId() const
+  [[nodiscard]] auto getBoneCount() const
   {
-    return m_roomId;
+    return m_boneCount;
   }
 
 private:
+  const size_t m_boneCount;
+  std::shared_ptr<InstancedGhostMesh> m_instancedMesh;
   mutable std::unique_ptr<gl::ShaderStorageBuffer<glm::mat4>> m_meshMatricesBuffer;
-  uint32_t m_roomId = 0;
 };
 } // namespace engine::ghosting
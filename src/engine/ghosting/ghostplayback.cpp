@@ -0,0 +1,104 @@
+#include "ghostplayback.h"
+
+#include "engine/presenter.h"
+#include "engine/world/room.h"
+#include "engine/world/world.h"
+#include "ghost.h"
+#include "ghostmodel.h"
+#include "render/scene/node.h"
+#include "render/scene/renderer.h"
+
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace engine::ghosting
+{
+namespace
+{
+[[nodiscard]] const render::scene::Node* findGhostParent(const world::Room& room)
+{
+  if(room.node->isVisible())
+    return room.node.get();
+  if(room.alternateRoom != nullptr && room.alternateRoom->node->isVisible())
+    return room.alternateRoom->node.get();
+  return room.node.get();
+}
+} // namespace
+
+GhostPlayback::GhostPlayback(std::vector<std::unique_ptr<GhostDataReader>>&& readers)
+    : m_readers{std::move(readers)}
+    , m_node{gsl::make_shared<render::scene::Node>("ghosts")}
+{
+}
+
+GhostPlayback::~GhostPlayback()
+{
+  setParent(m_node, nullptr);
+}
+
+std::vector<GhostFrame> GhostPlayback::next()
+{
+  std::vector<GhostFrame> frames;
+  frames.reserve(m_readers.size());
+  for(const auto& reader : m_readers)
+    frames.emplace_back(reader->read());
+  return frames;
+}
+
+void GhostPlayback::apply(const world::World& world, const std::vector<GhostFrame>& frames)
+{
+  // the root node is cleared when a savegame is loaded
+  setParent(m_node, world.getPresenter().getRenderer().getRootNode());
+
+  for(auto& [meshIndices, matrices] : m_instanceMatrices)
+    matrices.clear();
+
+  std::vector<uint16_t> meshIndices;
+  for(const auto& frame : frames)
+  {
+    if(frame.bones.empty())
+      continue;
+
+    const auto* room = world.findRoomByPhysicalId(frame.roomId);
+    if(room == nullptr)
+      continue;
+
+    const auto* parent = findGhostParent(*room);
+    if(!parent->isVisible())
+      continue;
+
+    meshIndices.clear();
+    for(const auto& bone : frame.bones)
+      meshIndices.emplace_back(bone.meshIdx);
+
+    auto& matrices = m_instanceMatrices[meshIndices];
+    const auto modelMatrix = parent->getModelMatrix() * frame.modelMatrix;
+    for(const auto& bone : frame.bones)
+    {
+      // hidden bones collapse into a single point instead of requiring a different mesh
+      matrices.emplace_back(bone.visible ? modelMatrix * bone.matrix : glm::mat4{0.0f});
+    }
+  }
+
+  for(const auto& [meshIndices, matrices] : m_instanceMatrices)
+  {
+    auto it = m_models.find(meshIndices);
+    if(it == m_models.end())
+    {
+      if(matrices.empty())
+        continue;
+
+      auto model = std::make_shared<GhostModel>(world, meshIndices);
+      setParent(gsl::not_null{model}, m_node);
+      it = m_models.emplace(meshIndices, std::move(model)).first;
+    }
+
+    it->second->setInstances(matrices);
+  }
+}
+
+void GhostPlayback::setVisible(bool visible)
+{
+  m_node->setVisible(visible);
+}
+} // namespace engine::ghosting
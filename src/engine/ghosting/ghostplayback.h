@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <gslu.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace engine::world
+{
+class World;
+}
+
+namespace render::scene
+{
+class Node;
+}
+
+namespace engine::ghosting
+{
+struct GhostFrame;
+class GhostDataReader;
+class GhostModel;
+
+/**
+ * Plays back any number of recordings at once.
+ *
+ * Each reader decodes its recording on its own thread, and all ghosts sharing the same bone meshes are drawn with a
+ * single instanced draw call.
+ */
+class GhostPlayback final
+{
+public:
+  explicit GhostPlayback(std::vector<std::unique_ptr<GhostDataReader>>&& readers);
+  ~GhostPlayback();
+
+  //! Reads the next frame of every recording, in the order of the readers.
+  [[nodiscard]] std::vector<GhostFrame> next();
+
+  void apply(const world::World& world, const std::vector<GhostFrame>& frames);
+
+  void setVisible(bool visible);
+
+  [[nodiscard]] auto getRecordingCount() const
+  {
+    return m_readers.size();
+  }
+
+private:
+  std::vector<std::unique_ptr<GhostDataReader>> m_readers;
+  gslu::nn_shared<render::scene::Node> m_node;
+  // keyed by the mesh indices of all bones
+  std::map<std::vector<uint16_t>, std::shared_ptr<GhostModel>> m_models;
+  std::map<std::vector<uint16_t>, std::vector<glm::mat4>> m_instanceMatrices;
+};
+} // namespace engine::ghosting
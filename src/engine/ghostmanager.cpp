@@ -4,11 +4,10 @@
 #include "core/i18n.h"
 #include "engine.h"
 #include "ghosting/ghost.h"
-#include "ghosting/ghostmodel.h"
+#include "ghosting/ghostplayback.h"
 #include "hid/inputhandler.h"
 #include "objects/laraobject.h"
 #include "presenter.h"
-#include "render/material/materialmanager.h"
 #include "serialization/serialization.h"
 #include "serialization/yamldocument.h"
 #include "throttler.h"
@@ -16,36 +15,90 @@
 #include "world/world.h"
 #include "writeonlyxzarchive.h"
 
+#include <algorithm>
 #include <boost/log/trivial.hpp>
+#include <exception>
+#include <tuple>
+#include <vector>
 
 namespace engine
 {
-GhostManager::GhostManager(const std::filesystem::path& recordingPath, world::World& world)
-    : model{std::make_shared<ghosting::GhostModel>()}
-    , readerPath{std::filesystem::path{recordingPath}.replace_extension(".bin")}
-    , writerPath{recordingPath}
-    , writer{std::make_unique<ghosting::GhostDataWriter>(recordingPath)}
+namespace
 {
-  if(std::filesystem::is_regular_file(readerPath))
-  {
-    reader = std::make_unique<ghosting::GhostDataReader>(readerPath);
-    if(!reader->isOpen())
-      reader.reset();
-  }
-  if(reader != nullptr)
+constexpr size_t MaxGhosts = 16;
+
+/**
+ * Returns the player's own recording of a level, followed by the fastest completed recordings found in the
+ * directory named like the level, e.g. "ghosts/tr1/LEVEL1/".
+ */
+std::vector<std::filesystem::path> findRecordings(const std::filesystem::path& ownRecording)
+{
+  std::vector<std::filesystem::path> result;
+  if(std::filesystem::is_regular_file(ownRecording))
+    result.emplace_back(ownRecording);
+
+  const auto recordingsDir = std::filesystem::path{ownRecording}.replace_extension();
+  if(!std::filesystem::is_directory(recordingsDir))
+    return result;
+
+  std::vector<std::tuple<core::Frame, std::filesystem::path>> candidates;
+  for(const auto& entry : std::filesystem::directory_iterator{recordingsDir})
   {
-    for(auto i = 0_frame; i < world.getGhostFrame(); i += 1_frame)
+    if(!entry.is_regular_file() || entry.path().extension() != ".bin")
+      continue;
+
+    const auto metaPath = std::filesystem::path{entry.path()}.replace_extension(".yml");
+    if(!std::filesystem::is_regular_file(metaPath))
+      continue;
+
+    ghosting::GhostMeta meta;
+    try
     {
-      writer->append(reader->read());
+      serialization::YAMLDocument<true> metaDoc{metaPath};
+      metaDoc.load("ghost", meta, meta);
     }
-  }
-  else
-  {
-    for(auto i = 0_frame; i < world.getGhostFrame(); i += 1_frame)
+    catch(std::exception& ex)
     {
-      writer->append({});
+      BOOST_LOG_TRIVIAL(warning) << "Failed to load ghost meta data " << metaPath << ": " << ex.what();
+      continue;
     }
+
+    if(meta.finishState.value != ghosting::GhostFinishState::Completed)
+      continue;
+
+    candidates.emplace_back(meta.duration, entry.path());
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  for(const auto& [duration, path] : candidates)
+  {
+    if(result.size() >= MaxGhosts)
+      break;
+    result.emplace_back(path);
+  }
+
+  return result;
+}
+} // namespace
+
+GhostManager::GhostManager(const std::filesystem::path& recordingPath, world::World& world)
+    : readerPath{std::filesystem::path{recordingPath}.replace_extension(".bin")}
+    , writerPath{recordingPath}
+    , writer{std::make_unique<ghosting::GhostDataWriter>(recordingPath, readerPath, world.getGhostFrame())}
+    , randomStreams{world.getGhostRandomStreams()}
+{
+  std::vector<std::unique_ptr<ghosting::GhostDataReader>> readers;
+  for(const auto& path : findRecordings(readerPath))
+  {
+    auto reader = std::make_unique<ghosting::GhostDataReader>(path, world.getGhostFrame());
+    if(!reader->isOpen())
+      continue;
+
+    readers.emplace_back(std::move(reader));
   }
+
+  BOOST_LOG_TRIVIAL(debug) << "Playing back " << readers.size() << " ghost recording(s)";
+  playback = std::make_unique<ghosting::GhostPlayback>(std::move(readers));
 }
 
 GhostManager::~GhostManager()
@@ -55,6 +108,18 @@ GhostManager::~GhostManager()
   std::filesystem::remove(writerPath, ec);
 }
 
+void GhostManager::setVisible(bool visible)
+{
+  if(playback != nullptr)
+    playback->setVisible(visible);
+}
+
+void GhostManager::update(const world::World& world)
+{
+  if(playback != nullptr && playback->getRecordingCount() > 0)
+    playback->apply(world, playback->next());
+}
+
 bool GhostManager::askGhostSave(Presenter& presenter, world::World& world)
 {
   const auto msgBox = std::make_shared<ui::widgets::MessageBox>(
@@ -83,7 +148,7 @@ bool GhostManager::askGhostSave(Presenter& presenter, world::World& world)
       msgBox->setConfirmed(!msgBox->isConfirmed());
     }
 
-    ui::Ui ui{presenter.getMaterialManager()->getUi(), world.getPalette(), presenter.getUiViewport()};
+    ui::Ui ui{presenter.getUiRenderer(), world.getPalette(), presenter.getUiViewport()};
 
     msgBox->setPosition({(ui.getSize().x - msgBox->getSize().x) / 2, (ui.getSize().y - msgBox->getSize().y) / 2});
     msgBox->update(true);
@@ -104,7 +169,7 @@ bool GhostManager::askGhostSave(Presenter& presenter, world::World& world)
     if(!msgBox->isConfirmed())
       return true;
 
-    reader.reset();
+    playback.reset();
     writer.reset();
 
     std::error_code ec;
@@ -116,6 +181,7 @@ bool GhostManager::askGhostSave(Presenter& presenter, world::World& world)
     ghostMeta.duration = world.getGhostFrame();
     ghostMeta.level = world.getLevelFilename().stem();
     ghostMeta.gameflow = world.getEngine().getGameflowId();
+    ghostMeta.randomStreams = randomStreams;
     if(world.levelFinished())
     {
       ghostMeta.finishState = world.getObjectManager().getLara().m_state.isDead()
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "randomstreams.h"
+
 #include <filesystem>
+#include <memory>
 
 namespace engine::world
 {
@@ -9,8 +12,7 @@ class World;
 
 namespace engine::ghosting
 {
-class GhostModel;
-class GhostDataReader;
+class GhostPlayback;
 class GhostDataWriter;
 } // namespace engine::ghosting
 
@@ -26,10 +28,13 @@ struct GhostManager
 
   bool askGhostSave(Presenter& presenter, world::World& world);
 
-  std::shared_ptr<ghosting::GhostModel> model;
+  void setVisible(bool visible);
+  void update(const world::World& world);
+
   const std::filesystem::path readerPath;
-  std::unique_ptr<ghosting::GhostDataReader> reader;
+  std::unique_ptr<ghosting::GhostPlayback> playback;
   const std::filesystem::path writerPath;
   std::unique_ptr<ghosting::GhostDataWriter> writer;
+  const RandomStreams randomStreams;
 };
 } // namespace engine
@@ -14,16 +14,176 @@ namespace engine
 {
 bool HeightInfo::skipSteepSlants = false;
 
+namespace
+{
+gsl::not_null<const world::Sector*> getFloorSector(gsl::not_null<const world::Sector*> roomSector,
+                                                   const core::TRVec& pos)
+{
+  while(roomSector->roomBelow != nullptr)
+  {
+    roomSector = gsl::not_null{roomSector->roomBelow->getSectorByAbsolutePosition(pos)};
+  }
+  return roomSector;
+}
+
+gsl::not_null<const world::Sector*> getCeilingSector(gsl::not_null<const world::Sector*> roomSector,
+                                                     const core::TRVec& pos)
+{
+  while(roomSector->roomAbove != nullptr)
+  {
+    roomSector = gsl::not_null{roomSector->roomAbove->getSectorByAbsolutePosition(pos)};
+  }
+  return roomSector;
+}
+
+std::pair<core::Length::type, core::Length::type> readSlant(const floordata::FloorDataValue& fd)
+{
+  return {gsl::narrow_cast<int8_t>(util::bits(fd.get(), 0, 8)), gsl::narrow_cast<int8_t>(util::bits(fd.get(), 8, 8))};
+}
+
+bool isSlantApplied(const core::Length::type xSlant, const core::Length::type zSlant)
+{
+  return !HeightInfo::skipSteepSlants || (std::abs(xSlant) <= 2 && std::abs(zSlant) <= 2);
+}
+
+void applyFloorSlant(core::Length& y,
+                     const core::Length::type xSlant,
+                     const core::Length::type zSlant,
+                     const core::TRVec& pos)
+{
+  const auto localX = toSectorLocal(pos.X);
+  const auto localZ = toSectorLocal(pos.Z);
+
+  if(zSlant > 0) // lower edge at -Z
+  {
+    const auto dist = 1_sectors - localZ;
+    y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+  else if(zSlant < 0) // lower edge at +Z
+  {
+    const auto dist = localZ;
+    y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+
+  if(xSlant > 0) // lower edge at -X
+  {
+    const auto dist = 1_sectors - localX;
+    y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+  else if(xSlant < 0) // lower edge at +X
+  {
+    const auto dist = localX;
+    y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+}
+
+void applyCeilingSlant(core::Length& y,
+                       const core::Length::type xSlant,
+                       const core::Length::type zSlant,
+                       const core::TRVec& pos)
+{
+  const auto localX = toSectorLocal(pos.X);
+  const auto localZ = toSectorLocal(pos.Z);
+
+  if(zSlant > 0) // lower edge at -Z
+  {
+    const auto dist = 1_sectors - localZ;
+    y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+  else if(zSlant < 0) // lower edge at +Z
+  {
+    const auto dist = localZ;
+    y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+
+  if(xSlant > 0) // lower edge at -X
+  {
+    const auto dist = localX;
+    y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+  else if(xSlant < 0) // lower edge at +X
+  {
+    const auto dist = 1_sectors - localX;
+    y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
+  }
+}
+
+//! Calls @p visitor with the parameter of each activation command of the command sequence at @p fd, and returns the
+//! floor data following the sequence.
+template<typename Visitor>
+const floordata::FloorDataValue* visitActivations(const floordata::FloorDataValue* fd, const Visitor& visitor)
+{
+  while(true)
+  {
+    const floordata::Command command{*fd++};
+
+    if(command.opcode == floordata::CommandOpcode::Activate)
+    {
+      visitor(command.parameter);
+    }
+    else if(command.opcode == floordata::CommandOpcode::SwitchCamera)
+    {
+      command.isLast = floordata::CameraParameters{*fd++}.isLast;
+    }
+
+    if(command.isLast)
+      return fd;
+  }
+}
+
+//! Returns the ceiling slant chunk, which may only follow the floor slant chunk.
+const floordata::FloorDataValue* findCeilingSlant(const floordata::FloorDataValue* fd)
+{
+  floordata::FloorDataChunk chunkHeader{*fd};
+  ++fd;
+
+  if(chunkHeader.type == floordata::FloorDataChunkType::FloorSlant)
+  {
+    ++fd;
+
+    chunkHeader = floordata::FloorDataChunk{*fd};
+    ++fd;
+  }
+
+  return chunkHeader.type == floordata::FloorDataChunkType::CeilingSlant ? fd : nullptr;
+}
+
+//! Calls @p visitor with the parameter of each activation command in the floor data of a sector.
+template<typename Visitor>
+void visitSectorActivations(const floordata::FloorDataValue* fd, const Visitor& visitor)
+{
+  while(true)
+  {
+    const floordata::FloorDataChunk chunkHeader{*fd++};
+    switch(chunkHeader.type)
+    {
+    case floordata::FloorDataChunkType::CeilingSlant:
+    case floordata::FloorDataChunkType::FloorSlant:
+    case floordata::FloorDataChunkType::BoundaryRoom:
+      ++fd;
+      break;
+    case floordata::FloorDataChunkType::Death:
+      break;
+    case floordata::FloorDataChunkType::CommandSequence:
+      ++fd;
+      fd = visitActivations(fd, visitor);
+      break;
+    default:
+      break;
+    }
+    if(chunkHeader.isLast)
+      break;
+  }
+}
+} // namespace
+
 HeightInfo HeightInfo::fromFloor(gsl::not_null<const world::Sector*> roomSector,
                                  const core::TRVec& pos,
                                  const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
 {
   HeightInfo hi;
 
-  while(roomSector->roomBelow != nullptr)
-  {
-    roomSector = gsl::not_null{roomSector->roomBelow->getSectorByAbsolutePosition(pos)};
-  }
+  roomSector = getFloorSector(roomSector, pos);
 
   hi.y = roomSector->floorHeight;
 
@@ -41,42 +201,16 @@ HeightInfo HeightInfo::fromFloor(gsl::not_null<const world::Sector*> roomSector,
     {
     case floordata::FloorDataChunkType::FloorSlant:
     {
-      const core::Length::type xSlant = gsl::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8));
-      const core::Length::type zSlant = gsl::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8));
+      const auto [xSlant, zSlant] = readSlant(*fd);
       ++fd;
-      const core::Length::type absX = std::abs(xSlant);
-      const core::Length::type absZ = std::abs(zSlant);
-      if(!skipSteepSlants || (absX <= 2 && absZ <= 2))
+      if(isSlantApplied(xSlant, zSlant))
       {
-        if(absX <= 2 && absZ <= 2)
+        if(std::abs(xSlant) <= 2 && std::abs(zSlant) <= 2)
           hi.slantClass = SlantClass::Max512;
         else
           hi.slantClass = SlantClass::Steep;
 
-        const auto localX = toSectorLocal(pos.X);
-        const auto localZ = toSectorLocal(pos.Z);
-
-        if(zSlant > 0) // lower edge at -Z
-        {
-          const auto dist = 1_sectors - localZ;
-          hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(zSlant < 0) // lower edge at +Z
-        {
-          const auto dist = localZ;
-          hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-
-        if(xSlant > 0) // lower edge at -X
-        {
-          const auto dist = 1_sectors - localX;
-          hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(xSlant < 0) // lower edge at +X
-        {
-          const auto dist = localX;
-          hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
+        applyFloorSlant(hi.y, xSlant, zSlant, pos);
       }
     }
     break;
@@ -94,25 +228,14 @@ HeightInfo HeightInfo::fromFloor(gsl::not_null<const world::Sector*> roomSector,
       if(hi.lastCommandSequenceOrDeath == nullptr)
         hi.lastCommandSequenceOrDeath = fd - 1;
       ++fd;
-      while(true)
-      {
-        const floordata::Command command{*fd++};
-
-        if(command.opcode == floordata::CommandOpcode::Activate)
-        {
-          if(auto it = objects.find(command.parameter); it != objects.end())
-          {
-            it->second->patchFloor(pos, hi.y);
-          }
-        }
-        else if(command.opcode == floordata::CommandOpcode::SwitchCamera)
-        {
-          command.isLast = floordata::CameraParameters{*fd++}.isLast;
-        }
-
-        if(command.isLast)
-          break;
-      }
+      fd = visitActivations(fd,
+                            [&objects, &pos, &hi](uint16_t parameter)
+                            {
+                              if(auto it = objects.find(parameter); it != objects.end())
+                              {
+                                it->second->patchFloor(pos, hi.y);
+                              }
+                            });
       break;
     default:
       break;
@@ -130,105 +253,115 @@ HeightInfo HeightInfo::fromCeiling(gsl::not_null<const world::Sector*> roomSecto
 {
   HeightInfo hi;
 
-  while(roomSector->roomAbove != nullptr)
-  {
-    roomSector = gsl::not_null{roomSector->roomAbove->getSectorByAbsolutePosition(pos)};
-  }
+  roomSector = getCeilingSector(roomSector, pos);
 
   hi.y = roomSector->ceilingHeight;
 
   if(roomSector->floorData != nullptr)
   {
-    const floordata::FloorDataValue* fd = roomSector->floorData;
-    floordata::FloorDataChunk chunkHeader{*fd};
-    ++fd;
-
-    if(chunkHeader.type == floordata::FloorDataChunkType::FloorSlant)
+    if(const auto fd = findCeilingSlant(roomSector->floorData); fd != nullptr)
     {
-      ++fd;
-
-      chunkHeader = floordata::FloorDataChunk{*fd};
-      ++fd;
+      const auto [xSlant, zSlant] = readSlant(*fd);
+      if(isSlantApplied(xSlant, zSlant))
+        applyCeilingSlant(hi.y, xSlant, zSlant, pos);
     }
+  }
+
+  roomSector = getFloorSector(roomSector, pos);
+
+  if(roomSector->floorData == nullptr)
+    return hi;
+
+  visitSectorActivations(roomSector->floorData,
+                         [&objects, &pos, &hi](uint16_t parameter)
+                         {
+                           if(auto it = objects.find(parameter); it != objects.end())
+                           {
+                             it->second->patchCeiling(pos, hi.y);
+                           }
+                         });
+
+  return hi;
+}
+
+SectorHeights::SectorHeights(const gsl::not_null<const world::Sector*>& roomSector, const core::TRVec& pos)
+    : m_roomSector{roomSector}
+    , m_position{pos}
+{
+}
 
-    if(chunkHeader.type == floordata::FloorDataChunkType::CeilingSlant)
+core::Length SectorHeights::getFloor(const core::TRVec& pos,
+                                     const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
+{
+  if(!m_floor.has_value())
+    m_floor = decodeFloor();
+
+  auto y = m_floor->sector->floorHeight;
+  for(const auto& command : m_floor->commands)
+  {
+    if(command.isSlant)
     {
-      const core::Length::type xSlant = gsl::narrow_cast<int8_t>(util::bits(fd->get(), 0, 8));
-      const core::Length::type absX = std::abs(xSlant);
-      const core::Length::type zSlant = gsl::narrow_cast<int8_t>(util::bits(fd->get(), 8, 8));
-      const core::Length::type absZ = std::abs(zSlant);
-      if(!skipSteepSlants || (absX <= 2 && absZ <= 2))
-      {
-        const auto localX = toSectorLocal(pos.X);
-        const auto localZ = toSectorLocal(pos.Z);
-
-        if(zSlant > 0) // lower edge at -Z
-        {
-          const auto dist = 1_sectors - localZ;
-          hi.y -= dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(zSlant < 0) // lower edge at +Z
-        {
-          const auto dist = localZ;
-          hi.y += dist * zSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-
-        if(xSlant > 0) // lower edge at -X
-        {
-          const auto dist = localX;
-          hi.y -= dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-        else if(xSlant < 0) // lower edge at +X
-        {
-          const auto dist = 1_sectors - localX;
-          hi.y += dist * xSlant * core::QuarterSectorSize / core::SectorSize;
-        }
-      }
+      if(isSlantApplied(command.xSlant, command.zSlant))
+        applyFloorSlant(y, command.xSlant, command.zSlant, pos);
+    }
+    else if(auto it = objects.find(command.objectId); it != objects.end())
+    {
+      it->second->patchFloor(pos, y);
     }
   }
+  return y;
+}
 
-  while(roomSector->roomBelow != nullptr)
+core::Length SectorHeights::getCeiling(const core::TRVec& pos,
+                                       const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects)
+{
+  if(!m_ceiling.has_value())
+    m_ceiling = decodeCeiling();
+
+  auto y = m_ceiling->sector->ceilingHeight;
+  if(m_ceiling->slant.has_value() && isSlantApplied(m_ceiling->slant->first, m_ceiling->slant->second))
+    applyCeilingSlant(y, m_ceiling->slant->first, m_ceiling->slant->second, pos);
+
+  for(const auto objectId : m_ceiling->patches)
   {
-    roomSector = gsl::not_null{roomSector->roomBelow->getSectorByAbsolutePosition(pos)};
+    if(auto it = objects.find(objectId); it != objects.end())
+    {
+      it->second->patchCeiling(pos, y);
+    }
   }
+  return y;
+}
 
-  if(roomSector->floorData == nullptr)
-    return hi;
+SectorHeights::Floor SectorHeights::decodeFloor() const
+{
+  Floor floor{getFloorSector(m_roomSector, m_position), {}};
+  if(floor.sector->floorData == nullptr)
+    return floor;
 
-  const floordata::FloorDataValue* fd = roomSector->floorData;
+  const floordata::FloorDataValue* fd = floor.sector->floorData;
   while(true)
   {
     const floordata::FloorDataChunk chunkHeader{*fd++};
     switch(chunkHeader.type)
     {
-    case floordata::FloorDataChunkType::CeilingSlant:
     case floordata::FloorDataChunkType::FloorSlant:
+    {
+      const auto [xSlant, zSlant] = readSlant(*fd);
+      ++fd;
+      floor.commands.emplace_back(FloorCommand{true, xSlant, zSlant, 0});
+    }
+    break;
+    case floordata::FloorDataChunkType::CeilingSlant:
     case floordata::FloorDataChunkType::BoundaryRoom:
       ++fd;
       break;
-    case floordata::FloorDataChunkType::Death:
-      break;
     case floordata::FloorDataChunkType::CommandSequence:
       ++fd;
-      while(true)
-      {
-        const floordata::Command command{*fd++};
-
-        if(command.opcode == floordata::CommandOpcode::Activate)
-        {
-          if(auto it = objects.find(command.parameter); it != objects.end())
-          {
-            it->second->patchCeiling(pos, hi.y);
-          }
-        }
-        else if(command.opcode == floordata::CommandOpcode::SwitchCamera)
-        {
-          command.isLast = floordata::CameraParameters{*fd++}.isLast;
-        }
-
-        if(command.isLast)
-          break;
-      }
+      fd = visitActivations(fd,
+                            [&floor](uint16_t parameter)
+                            {
+                              floor.commands.emplace_back(FloorCommand{false, 0, 0, parameter});
+                            });
       break;
     default:
       break;
@@ -236,7 +369,27 @@ HeightInfo HeightInfo::fromCeiling(gsl::not_null<const world::Sector*> roomSecto
     if(chunkHeader.isLast)
       break;
   }
+  return floor;
+}
 
-  return hi;
+SectorHeights::Ceiling SectorHeights::decodeCeiling() const
+{
+  Ceiling ceiling{getCeilingSector(m_roomSector, m_position), std::nullopt, {}};
+  if(ceiling.sector->floorData != nullptr)
+  {
+    if(const auto fd = findCeilingSlant(ceiling.sector->floorData); fd != nullptr)
+      ceiling.slant = readSlant(*fd);
+  }
+
+  const auto floorSector = getFloorSector(ceiling.sector, m_position);
+  if(floorSector->floorData == nullptr)
+    return ceiling;
+
+  visitSectorActivations(floorSector->floorData,
+                         [&ceiling](uint16_t parameter)
+                         {
+                           ceiling.patches.emplace_back(parameter);
+                         });
+  return ceiling;
 }
 } // namespace engine
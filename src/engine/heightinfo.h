@@ -11,6 +11,9 @@
 #include <gslu.h>
 #include <map>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace engine::world
 {
@@ -50,6 +53,56 @@ struct HeightInfo
   HeightInfo() = default;
 };
 
+/**
+ * The floor data of a sector which determines its floor and ceiling heights, decoded on first use for repeated queries
+ * at positions within the sector. The heights are the same as the ones of HeightInfo; objects patching heights are
+ * queried on every call.
+ */
+class SectorHeights final
+{
+public:
+  //! @p pos must be within @p roomSector, and so must all positions queried later. As rooms are aligned to the sector
+  //! grid, the sectors above and below are then the same for all of them.
+  SectorHeights(const gsl::not_null<const world::Sector*>& roomSector, const core::TRVec& pos);
+
+  [[nodiscard]] core::Length getFloor(const core::TRVec& pos,
+                                      const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects);
+
+  [[nodiscard]] core::Length getCeiling(const core::TRVec& pos,
+                                        const std::map<uint16_t, gslu::nn_shared<objects::Object>>& objects);
+
+private:
+  //! Either a floor slant, or the id of an object which patches the floor, in the order of the floor data.
+  struct FloorCommand
+  {
+    bool isSlant;
+    core::Length::type xSlant;
+    core::Length::type zSlant;
+    uint16_t objectId;
+  };
+
+  struct Floor
+  {
+    gsl::not_null<const world::Sector*> sector;
+    std::vector<FloorCommand> commands;
+  };
+
+  struct Ceiling
+  {
+    gsl::not_null<const world::Sector*> sector;
+    std::optional<std::pair<core::Length::type, core::Length::type>> slant;
+    std::vector<uint16_t> patches;
+  };
+
+  gsl::not_null<const world::Sector*> m_roomSector;
+  core::TRVec m_position;
+  std::optional<Floor> m_floor;
+  std::optional<Ceiling> m_ceiling;
+
+  [[nodiscard]] Floor decodeFloor() const;
+  [[nodiscard]] Ceiling decodeCeiling() const;
+};
+
 struct VerticalDistances
 {
   //! Floor distance relative to the object
@@ -47,11 +47,11 @@ public:
 
       const auto r = spheres[i].radius;
       auto p = core::TRVec{spheres[i].getCollisionPosition()};
-      p.X += util::rand15s(r);
-      p.Y += util::rand15s(r);
-      p.Z += util::rand15s(r);
-      auto fx = gsl::make_shared<SparkleParticle>(Location{world.getObjectManager().getLara().m_state.location.room, p},
-                                                  world);
+      p.X += world.getRandomStreams().particles.rand15s(r);
+      p.Y += world.getRandomStreams().particles.rand15s(r);
+      p.Z += world.getRandomStreams().particles.rand15s(r);
+      auto fx = world.getLevelArena().makeShared<SparkleParticle>(
+        ArenaCategory::Particles, Location{world.getObjectManager().getLara().m_state.location.room, p}, world);
       world.getObjectManager().registerParticle(fx);
     }
   }
@@ -0,0 +1,59 @@
+#include "levelarena.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+
+namespace engine
+{
+const char* toString(const ArenaCategory category)
+{
+  switch(category)
+  {
+  case ArenaCategory::Objects:
+    return "objects";
+  case ArenaCategory::SkeletalModels:
+    return "skeletal models";
+  case ArenaCategory::Particles:
+    return "particles";
+  case ArenaCategory::SceneNodes:
+    return "scene nodes";
+  }
+  return "unknown";
+}
+
+LevelArena::~LevelArena()
+{
+  logCounters();
+}
+
+void LevelArena::logCounters() const
+{
+  for(size_t i = 0; i < ArenaCategoryCount; ++i)
+  {
+    const auto& counters = m_counters[i];
+    BOOST_LOG_TRIVIAL(info) << "Level arena " << toString(static_cast<ArenaCategory>(i)) << ": " << counters.bytes
+                            << " bytes in " << counters.allocations << " allocations, peak " << counters.peakBytes
+                            << " bytes, " << counters.totalAllocations << " allocations in total";
+  }
+}
+
+void* LevelArena::allocate(const size_t bytes, const size_t alignment, const ArenaCategory category)
+{
+  auto* p = m_pool.allocate(bytes, alignment);
+  auto& counters = m_counters.at(static_cast<size_t>(category));
+  counters.bytes += bytes;
+  counters.peakBytes = std::max(counters.peakBytes, counters.bytes);
+  ++counters.allocations;
+  ++counters.totalAllocations;
+  return p;
+}
+
+void LevelArena::deallocate(void* p, const size_t bytes, const size_t alignment, const ArenaCategory category)
+{
+  auto& counters = m_counters.at(static_cast<size_t>(category));
+  gsl_Assert(counters.bytes >= bytes && counters.allocations > 0);
+  counters.bytes -= bytes;
+  --counters.allocations;
+  m_pool.deallocate(p, bytes, alignment);
+}
+} // namespace engine
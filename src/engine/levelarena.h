@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace engine
+{
+enum class ArenaCategory
+{
+  Objects,
+  SkeletalModels,
+  Particles,
+  SceneNodes,
+};
+
+constexpr size_t ArenaCategoryCount = 4;
+
+[[nodiscard]] const char* toString(ArenaCategory category);
+
+struct ArenaCounters
+{
+  //! Bytes currently allocated.
+  size_t bytes = 0;
+  //! Number of allocations currently alive.
+  size_t allocations = 0;
+  size_t peakBytes = 0;
+  //! Number of allocations over the whole lifetime of the arena.
+  size_t totalAllocations = 0;
+};
+
+/**
+ * Pools the long-lived allocations of a level, i.e. objects, their models, particles and room scene nodes.
+ *
+ * Allocations of the same size are packed into shared chunks instead of being spread across the heap, and the chunks
+ * are freed at once when the level is unloaded. Every allocation keeps the arena alive through its control block, so
+ * shared pointers outliving the world stay valid. The arena is not thread-safe, like the rest of the world state.
+ */
+class LevelArena final : public std::enable_shared_from_this<LevelArena>
+{
+public:
+  LevelArena(const LevelArena&) = delete;
+  LevelArena(LevelArena&&) = delete;
+  LevelArena& operator=(const LevelArena&) = delete;
+  LevelArena& operator=(LevelArena&&) = delete;
+
+  LevelArena() = default;
+  ~LevelArena();
+
+  template<typename T, typename... Args>
+  [[nodiscard]] gslu::nn_shared<T> makeShared(ArenaCategory category, Args&&... args)
+  {
+    return gsl::not_null{
+      std::allocate_shared<T>(Allocator<T>{shared_from_this(), category}, std::forward<Args>(args)...)};
+  }
+
+  [[nodiscard]] const ArenaCounters& getCounters(ArenaCategory category) const
+  {
+    return m_counters.at(static_cast<size_t>(category));
+  }
+
+  void logCounters() const;
+
+private:
+  template<typename T>
+  class Allocator final
+  {
+  public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<LevelArena> arena, ArenaCategory category)
+        : m_arena{std::move(arena)}
+        , m_category{category}
+    {
+    }
+
+    template<typename U>
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    Allocator(const Allocator<U>& rhs)
+        : m_arena{rhs.m_arena}
+        , m_category{rhs.m_category}
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_t n)
+    {
+      return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T), m_category));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+      m_arena->deallocate(p, n * sizeof(T), alignof(T), m_category);
+    }
+
+    template<typename U>
+    [[nodiscard]] bool operator==(const Allocator<U>& rhs) const
+    {
+      return m_arena == rhs.m_arena;
+    }
+
+    template<typename U>
+    [[nodiscard]] bool operator!=(const Allocator<U>& rhs) const
+    {
+      return m_arena != rhs.m_arena;
+    }
+
+  private:
+    template<typename>
+    friend class Allocator;
+
+    std::shared_ptr<LevelArena> m_arena;
+    ArenaCategory m_category;
+  };
+
+  [[nodiscard]] void* allocate(size_t bytes, size_t alignment, ArenaCategory category);
+  void deallocate(void* p, size_t bytes, size_t alignment, ArenaCategory category);
+
+  std::pmr::unsynchronized_pool_resource m_pool;
+  std::array<ArenaCounters, ArenaCategoryCount> m_counters{};
+};
+} // namespace engine
@@ -0,0 +1,77 @@
+#include "levelprefetcher.h"
+
+#include "loader/file/level/game.h"
+#include "loader/file/level/level.h"
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/log/trivial.hpp>
+#include <exception>
+#include <utility>
+
+namespace engine
+{
+LevelPrefetcher::~LevelPrefetcher()
+{
+  drop();
+}
+
+void LevelPrefetcher::setNext(const std::optional<std::filesystem::path>& path)
+{
+  m_next = path;
+}
+
+void LevelPrefetcher::start()
+{
+  if(!m_next.has_value() || m_pendingPath == m_next)
+    return;
+
+  drop();
+  BOOST_LOG_TRIVIAL(debug) << "Prefetching level " << *m_next;
+  m_pendingPath = m_next;
+  m_pending = std::async(std::launch::async,
+                         [path = *m_next]()
+                         {
+                           auto level = loader::file::level::Level::createLoader(path,
+                                                                                 loader::file::level::Game::Unknown);
+                           if(level != nullptr)
+                             level->loadFileData();
+                           return level;
+                         });
+}
+
+std::unique_ptr<loader::file::level::Level> LevelPrefetcher::take(const std::filesystem::path& path)
+{
+  if(m_pendingPath != path)
+    return nullptr;
+
+  m_pendingPath.reset();
+  try
+  {
+    return m_pending.get();
+  }
+  catch(...)
+  {
+    // let the regular load report the error
+    BOOST_LOG_TRIVIAL(warning) << "Prefetching level " << path
+                               << " failed: " << boost::current_exception_diagnostic_information();
+    return nullptr;
+  }
+}
+
+void LevelPrefetcher::drop()
+{
+  if(!m_pending.valid())
+    return;
+
+  // waits for the background thread to finish
+  try
+  {
+    (void)m_pending.get();
+  }
+  catch(...)
+  {
+    // the level isn't used anyway
+  }
+  m_pendingPath.reset();
+}
+} // namespace engine
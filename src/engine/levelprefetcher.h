@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+
+namespace loader::file::level
+{
+class Level;
+}
+
+namespace engine
+{
+/**
+ * Reads the file of the next level on a background thread while the engine is mostly idle, e.g. during the level
+ * stats screen, FMVs and cutscenes.
+ *
+ * The level file also contains the audio samples, so only building the world and uploading its data to the GPU is
+ * left for the actual level load.
+ */
+class LevelPrefetcher final
+{
+public:
+  LevelPrefetcher() = default;
+  ~LevelPrefetcher();
+
+  LevelPrefetcher(const LevelPrefetcher&) = delete;
+  LevelPrefetcher(LevelPrefetcher&&) = delete;
+  LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+  LevelPrefetcher& operator=(LevelPrefetcher&&) = delete;
+
+  //! Sets the level to be loaded after the current one.
+  void setNext(const std::optional<std::filesystem::path>& path);
+
+  //! Starts reading the next level, unless it is already read or being read. Data of another level is dropped.
+  void start();
+
+  //! Returns the level if it was prefetched, waiting for the background thread if it is still busy.
+  [[nodiscard]] std::unique_ptr<loader::file::level::Level> take(const std::filesystem::path& path);
+
+private:
+  std::optional<std::filesystem::path> m_next;
+  std::optional<std::filesystem::path> m_pendingPath;
+  std::future<std::unique_ptr<loader::file::level::Level>> m_pending;
+
+  void drop();
+};
+} // namespace engine
@@ -5,8 +5,12 @@
 #include "engine/world/world.h"
 #include "render/scene/node.h"
 
+#include <algorithm>
 #include <gl/api/gl.hpp>
 #include <gl/program.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <utility>
 
 namespace render::scene
 {
@@ -15,6 +19,47 @@ class Mesh;
 
 namespace engine
 {
+namespace
+{
+//! The distance a lit sphere may move before its light selection is re-evaluated.
+constexpr float SelectionTolerance = 32;
+//! The influence below which a light is considered not to contribute, about one step of an 8 bit colour channel.
+constexpr float MinInfluence = 1.0f / 256.0f;
+} // namespace
+
+std::vector<ShaderLight> selectLights(const std::vector<ShaderLight>& candidates,
+                                      const glm::vec3& boxMin,
+                                      const glm::vec3& boxMax,
+                                      size_t maxLights)
+{
+  std::vector<std::pair<float, gsl::not_null<const ShaderLight*>>> weighted;
+  weighted.reserve(candidates.size());
+  for(const auto& light : candidates)
+  {
+    // see calc_light_strength in lighting.glsl
+    const glm::vec3 position{light.position};
+    const auto r = glm::distance(position, glm::clamp(position, boxMin, boxMax)) / light.fadeDistance;
+    const auto influence = light.color.x / (r * r + 1);
+    if(influence >= MinInfluence)
+      weighted.emplace_back(influence, &light);
+  }
+
+  const auto count = std::min(weighted.size(), maxLights);
+  std::partial_sort(weighted.begin(),
+                    weighted.begin() + count,
+                    weighted.end(),
+                    [](const auto& a, const auto& b)
+                    {
+                      return a.first > b.first;
+                    });
+
+  std::vector<ShaderLight> result;
+  result.reserve(count);
+  for(size_t i = 0; i < count; ++i)
+    result.emplace_back(*weighted[i].second);
+  return result;
+}
+
 void Lighting::update(const core::Shade& shade, const world::Room& baseRoom)
 {
   if(shade.get() >= 0)
@@ -28,6 +73,52 @@ void Lighting::update(const core::Shade& shade, const world::Room& baseRoom)
   fadeAmbient(baseRoom.ambientShade);
 }
 
+void Lighting::update(const core::Shade& shade,
+                      const world::Room& baseRoom,
+                      const glm::vec3& center,
+                      const float radius)
+{
+  if(shade.get() >= 0)
+  {
+    fadeAmbient(shade);
+    m_buffer = ShaderLight::getEmptyBuffer();
+    return;
+  }
+
+  fadeAmbient(baseRoom.ambientShade);
+
+  if(baseRoom.lightsBuffer != nullptr && m_selectionSource.lock() == baseRoom.lightsBuffer
+     && m_selectionRadius == radius && glm::distance(m_selectionCenter, center) < SelectionTolerance
+     && m_selectionBuffer != nullptr)
+  {
+    m_buffer = gsl::not_null{m_selectionBuffer};
+    return;
+  }
+
+  m_selectionSource = baseRoom.lightsBuffer;
+  m_selectionCenter = center;
+  m_selectionRadius = radius;
+
+  auto selected = selectLights(baseRoom.bufferLights, center - radius, center + radius, MaxObjectLights);
+  if(m_selectionBuffer != nullptr && selected == m_selectedLights)
+  {
+    m_buffer = gsl::not_null{m_selectionBuffer};
+    return;
+  }
+
+  m_selectedLights = std::move(selected);
+  if(m_selectionBuffer != nullptr && m_selectionBuffer->size() == m_selectedLights.size())
+  {
+    m_selectionBuffer->setSubData(m_selectedLights, 0);
+  }
+  else
+  {
+    m_selectionBuffer = std::make_shared<gl::ShaderStorageBuffer<ShaderLight>>(
+      "selected-lights-buffer", gl::api::BufferUsage::DynamicDraw, m_selectedLights);
+  }
+  m_buffer = gsl::not_null{m_selectionBuffer};
+}
+
 void Lighting::bind(render::scene::Node& node, const world::World& world) const
 {
   node.bind("u_lightAmbient",
@@ -3,12 +3,15 @@
 #include "core/units.h"
 #include "qs/qs.h"
 
+#include <cstddef>
 #include <gl/buffer.h>
+#include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace render::scene
 {
@@ -55,14 +58,36 @@ struct ShaderLight
 };
 static_assert(sizeof(ShaderLight) == 48, "Invalid Light struct size");
 
+//! The maximum number of lights affecting a single object.
+constexpr size_t MaxObjectLights = 8;
+//! The maximum number of lights affecting the geometry of a room.
+constexpr size_t MaxRoomLights = 16;
+
+/**
+ * Selects up to @p maxLights of @p candidates with the highest influence on an axis-aligned box, using the same
+ * attenuation as the shaders at the point of the box closest to the light. Lights with a negligible influence are
+ * dropped.
+ */
+[[nodiscard]] extern std::vector<ShaderLight> selectLights(const std::vector<ShaderLight>& candidates,
+                                                           const glm::vec3& boxMin,
+                                                           const glm::vec3& boxMax,
+                                                           size_t maxLights);
+
 struct Lighting
 {
   core::Brightness ambient{-1.0f};
 
   Lighting() = default;
 
+  //! Uses all lights affecting the geometry of @p baseRoom.
   void update(const core::Shade& shade, const world::Room& baseRoom);
 
+  /**
+   * Uses the lights of @p baseRoom with the most influence on a sphere. The selection is only re-evaluated if the
+   * sphere moved, or the room or its lights changed.
+   */
+  void update(const core::Shade& shade, const world::Room& baseRoom, const glm::vec3& center, float radius);
+
   void bind(render::scene::Node& node, const world::World& world) const;
 
 private:
@@ -76,5 +101,13 @@ private:
   }
 
   gslu::nn_shared<gl::ShaderStorageBuffer<ShaderLight>> m_buffer{ShaderLight::getEmptyBuffer()};
+
+  //! Identifies the light collection the selection was made from, which is replaced when the lights are re-collected.
+  //! Held weakly, so a new collection allocated at the address of an expired one is not mistaken for it.
+  std::weak_ptr<gl::ShaderStorageBuffer<ShaderLight>> m_selectionSource{};
+  glm::vec3 m_selectionCenter{std::numeric_limits<float>::quiet_NaN()};
+  float m_selectionRadius = 0;
+  std::vector<ShaderLight> m_selectedLights{};
+  std::shared_ptr<gl::ShaderStorageBuffer<ShaderLight>> m_selectionBuffer{};
 };
 } // namespace engine
@@ -13,8 +13,7 @@
 #include "engine/objects/objectstate.h"
 #include "engine/particle.h"
 #include "engine/raycast.h"
-#include "engine/script/reflection.h"
-#include "engine/script/scriptengine.h"
+#include "engine/script/objectinfo.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/box.h"
@@ -484,7 +483,7 @@ AIAgent::AIAgent(const std::string& name,
     : ModelObject{name, world, room, item, true, animatedModel, true}
 {
   m_state.collidable = true;
-  const core::Angle v = util::rand15s(90_deg);
+  const core::Angle v = getWorld().getRandomStreams().ai.rand15s(90_deg);
   m_state.rotation.Y += v;
 
   loadObjectInfo(false);
@@ -506,17 +505,19 @@ void AIAgent::collide(CollisionInfo& collisionInfo)
   enemyPush(collisionInfo, enableSpaz, false);
 }
 
-bool AIAgent::canShootAtLara(const ai::EnemyLocation& enemyLocation) const
+bool AIAgent::canShootAtLara(const ai::EnemyLocation& enemyLocation)
 {
   if(!enemyLocation.enemyAhead || enemyLocation.enemyDistance >= util::square(7_sectors))
   {
     return false;
   }
 
-  return raycastLineOfSight(m_state.location.moved(0_len, -768_len, 0_len),
-                            getWorld().getObjectManager().getLara().m_state.location.position
-                              - core::TRVec{0_len, 768_len, 0_len},
-                            getWorld().getObjectManager())
+  return getWorld()
+    .getRaycastQueries()
+    .raycastLineOfSight(getWorld(),
+                        m_state.location.moved(0_len, -768_len, 0_len),
+                        getWorld().getObjectManager().getLara().m_state.location.position
+                          - core::TRVec{0_len, 768_len, 0_len})
     .first;
 }
 
@@ -530,7 +531,7 @@ bool AIAgent::tryShootAtLara(ModelObject& object,
   bool isHit = false;
   if(distance <= util::square(7_sectors))
   {
-    if(util::rand15() < (util::square(7_sectors) - distance) / util::square(40_len) - 8192)
+    if(getWorld().getRandomStreams().ai.rand15() < (util::square(7_sectors) - distance) / util::square(40_len) - 8192)
     {
       isHit = true;
     }
@@ -538,7 +539,8 @@ bool AIAgent::tryShootAtLara(ModelObject& object,
 
   if(isHit)
   {
-    lara.emitParticle(core::TRVec{}, util::rand15(lara.getSkeleton()->getBoneCount()), &createBloodSplat);
+    lara.emitParticle(
+      core::TRVec{}, getWorld().getRandomStreams().ai.rand15(lara.getSkeleton()->getBoneCount()), &createBloodSplat);
 
     if(!lara.isInWater())
       lara.playSoundEffect(TR1SoundEffect::BulletHitsLara);
@@ -546,9 +548,9 @@ bool AIAgent::tryShootAtLara(ModelObject& object,
   else
   {
     auto location = lara.m_state.location;
-    location.position.X += util::rand15s(1_sectors / 2);
+    location.position.X += getWorld().getRandomStreams().ai.rand15s(1_sectors / 2);
     location.position.Y = lara.m_state.floor;
-    location.position.Z += util::rand15s(1_sectors / 2);
+    location.position.Z += getWorld().getRandomStreams().ai.rand15s(1_sectors / 2);
     lara.emitRicochet(location);
   }
 
@@ -560,16 +562,11 @@ bool AIAgent::tryShootAtLara(ModelObject& object,
 
 void AIAgent::loadObjectInfo(bool withoutGameState)
 {
-  m_collisionRadius = core::Length{getWorld()
-                                     .getEngine()
-                                     .getScriptEngine()
-                                     .getGameflow()
-                                     .getObjectInfos()
-                                     .at(m_state.type.get_as<TR1ItemId>())
-                                     ->radius};
+  const auto& objectInfo = getWorld().getObjectInfo(m_state.type);
+  m_collisionRadius = core::Length{objectInfo.radius};
 
   if(!withoutGameState)
-    m_state.loadObjectInfo(getWorld().getEngine().getScriptEngine().getGameflow());
+    m_state.loadObjectInfo(objectInfo);
 }
 
 void AIAgent::hitLara(const core::Health& strength)
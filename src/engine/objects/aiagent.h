@@ -95,7 +95,7 @@ protected:
     return m_state.health;
   }
 
-  bool canShootAtLara(const ai::EnemyLocation& enemyLocation) const;
+  bool canShootAtLara(const ai::EnemyLocation& enemyLocation);
 
   bool tryShootAtLara(engine::objects::ModelObject& object,
                       const core::Area& distance,
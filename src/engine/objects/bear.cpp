@@ -62,7 +62,7 @@ void Bear::update()
         if(isEscaping())
           require(0_as);
       }
-      else if(util::rand15() < 80)
+      else if(getWorld().getRandomStreams().ai.rand15() < 80)
       {
         goal(GettingDown, Growling);
       }
@@ -92,9 +92,9 @@ void Bear::update()
         goal(RoaringStanding);
       else if(isEscaping())
         goal(RoaringStanding, 0_as);
-      else if(isBored() || util::rand15() < 80)
+      else if(isBored() || getWorld().getRandomStreams().ai.rand15() < 80)
         goal(RoaringStanding, Growling);
-      else if(enemyLocation.enemyDistance > util::square(2_sectors) || util::rand15() < 1536)
+      else if(enemyLocation.enemyDistance > util::square(2_sectors) || getWorld().getRandomStreams().ai.rand15() < 1536)
         goal(RoaringStanding, GettingDown);
       break;
     case Running.get():
@@ -109,7 +109,8 @@ void Bear::update()
       }
       else if(enemyLocation.enemyAhead && m_state.required_anim_state == 0_as)
       {
-        if(!m_hurt && enemyLocation.enemyDistance < util::square(2048_len) && util::rand15() < 768)
+        if(!m_hurt && enemyLocation.enemyDistance < util::square(2048_len)
+           && getWorld().getRandomStreams().ai.rand15() < 768)
           goal(GettingDown, RoaringStanding);
         else if(enemyLocation.enemyDistance < util::square(1_sectors))
           goal(RunningAttack);
@@ -30,5 +30,10 @@ public:
 
     y = m_state.location.position.Y + core::QuarterSectorSize;
   }
+
+  [[nodiscard]] bool patchesHeights() const override
+  {
+    return true;
+  }
 };
 } // namespace engine::objects
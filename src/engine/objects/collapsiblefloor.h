@@ -57,6 +57,11 @@ public:
     y = m_state.location.position.Y - 256_len;
   }
 
+  [[nodiscard]] bool patchesHeights() const override
+  {
+    return true;
+  }
+
   void serialize(const serialization::Serializer<world::World>& ser) override;
 };
 } // namespace engine::objects
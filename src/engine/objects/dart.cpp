@@ -58,7 +58,8 @@ void Dart::update()
   const auto [success, ricochetPos]
     = raycastLineOfSight(oldLocation, m_state.location.position, getWorld().getObjectManager());
 
-  auto particle = gsl::make_shared<RicochetParticle>(ricochetPos, getWorld());
+  auto particle = getWorld().getLevelArena().makeShared<RicochetParticle>(
+    ArenaCategory::Particles, ricochetPos, getWorld());
   setParent(particle, ricochetPos.room->node);
   particle->angle = m_state.rotation;
   particle->timePerSpriteFrame = 6;
@@ -72,7 +72,8 @@ void engine::objects::DartGun::update()
   auto& dartState = dart->m_state;
   dartState.triggerState = TriggerState::Active;
 
-  auto particle = gsl::make_shared<SmokeParticle>(dartState.location, getWorld(), dartState.rotation);
+  auto particle = getWorld().getLevelArena().makeShared<SmokeParticle>(
+    ArenaCategory::Particles, dartState.location, getWorld(), dartState.rotation);
   setParent(particle, dartState.location.room->node);
   getWorld().getObjectManager().registerParticle(std::move(particle));
 
@@ -9,6 +9,7 @@
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/box.h"
 #include "engine/world/room.h"
+#include "engine/world/sector.h"
 #include "engine/world/world.h"
 #include "laraobject.h"
 #include "modelobject.h"
@@ -25,6 +26,16 @@ namespace engine::objects
 {
 // #define NO_DOOR_BLOCK
 
+namespace
+{
+bool isSameLayout(const world::Sector& a, const world::Sector& b)
+{
+  return a.floorData == b.floorData && a.boundaryRoom == b.boundaryRoom && a.box == b.box
+         && a.roomBelow == b.roomBelow && a.floorHeight == b.floorHeight && a.roomAbove == b.roomAbove
+         && a.ceilingHeight == b.ceilingHeight;
+}
+} // namespace
+
 Door::Door(const std::string& name,
            const gsl::not_null<world::World*>& world,
            const gsl::not_null<const world::Room*>& room,
@@ -96,10 +107,12 @@ void Door::update()
     else
     {
 #ifndef NO_DOOR_BLOCK
-      m_info.open();
-      m_target.open();
-      m_alternateInfo.open();
-      m_alternateTarget.open();
+      bool changed = m_info.open();
+      changed |= m_target.open();
+      changed |= m_alternateInfo.open();
+      changed |= m_alternateTarget.open();
+      if(changed)
+        getWorld().notifySectorsChanged();
 #endif
     }
   }
@@ -112,10 +125,12 @@ void Door::update()
     else
     {
 #ifndef NO_DOOR_BLOCK
-      m_info.close();
-      m_target.close();
-      m_alternateInfo.close();
-      m_alternateTarget.close();
+      bool changed = m_info.close();
+      changed |= m_target.close();
+      changed |= m_alternateInfo.close();
+      changed |= m_alternateTarget.close();
+      if(changed)
+        getWorld().notifySectorsChanged();
 #endif
     }
   }
@@ -186,24 +201,28 @@ void Door::serialize(const serialization::Serializer<world::World>& ser)
   }
 }
 
-void Door::Info::open() // NOLINT(readability-make-member-function-const)
+bool Door::Info::open() // NOLINT(readability-make-member-function-const)
 {
   if(wingsSector == nullptr)
-    return;
+    return false;
 
+  const bool changed = !isSameLayout(*wingsSector, originalSector);
   *wingsSector = originalSector;
   if(wingsBox != nullptr)
     wingsBox->blocked = false;
+  return changed;
 }
 
-void Door::Info::close() // NOLINT(readability-make-member-function-const)
+bool Door::Info::close() // NOLINT(readability-make-member-function-const)
 {
   if(wingsSector == nullptr)
-    return;
+    return false;
 
+  const bool changed = !isSameLayout(*wingsSector, world::Sector{});
   *wingsSector = world::Sector{};
   if(wingsBox != nullptr)
     wingsBox->blocked = true;
+  return changed;
 }
 
 void Door::Info::init(const world::Room& room, const core::TRVec& position)
@@ -56,8 +56,10 @@ private:
     world::Sector originalSector;
     world::Box* wingsBox{nullptr};
 
-    void open();
-    void close();
+    //! Returns true if the sector was modified.
+    bool open();
+    //! Returns true if the sector was modified.
+    bool close();
     void init(const world::Room& room, const core::TRVec& position);
     void serialize(const serialization::Serializer<world::World>& ser);
   };
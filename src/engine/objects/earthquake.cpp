@@ -16,12 +16,12 @@ void Earthquake::update()
   if(!m_state.updateActivationTimeout())
     return;
 
-  if(util::rand15() < 256)
+  if(getWorld().getRandomStreams().simulation.rand15() < 256)
   {
     getWorld().getCameraController().setBounce(-150_len);
     getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::RollingBall, nullptr);
   }
-  else if(util::rand15() < 1024)
+  else if(getWorld().getRandomStreams().simulation.rand15() < 1024)
   {
     getWorld().getCameraController().setBounce(50_len);
     getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::TRexFootstep, nullptr);
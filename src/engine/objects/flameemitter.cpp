@@ -19,7 +19,8 @@ void FlameEmitter::update()
     if(m_flame != nullptr)
       return;
 
-    m_flame = std::make_shared<FlameParticle>(m_state.location, getWorld());
+    m_flame = getWorld().getLevelArena().makeShared<FlameParticle>(
+      ArenaCategory::Particles, m_state.location, getWorld());
     setParent(gsl::not_null{m_flame}, m_state.location.room->node);
     getWorld().getObjectManager().registerParticle(gsl::not_null{m_flame});
   }
@@ -72,7 +72,7 @@ void Gorilla::update()
       }
       else
       {
-        const auto r = util::rand15(1024);
+        const auto r = getWorld().getRandomStreams().ai.rand15(1024);
         if(r < 160)
         {
           goal(10_as);
@@ -111,7 +111,7 @@ void Gorilla::update()
       }
       else if(!isEscaping())
       {
-        const auto r = util::rand15();
+        const auto r = getWorld().getRandomStreams().ai.rand15();
         if(r < 160)
           goal(1_as, 10_as);
         else if(r < 320)
@@ -153,8 +153,8 @@ void Gorilla::update()
   }
   else if(m_state.current_anim_state != 5_as)
   {
-    getSkeleton()->setAnim(
-      gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Gorilla)->animations[7 + util::rand15(2)]});
+    getSkeleton()->setAnim(gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Gorilla)
+                                            ->animations[7 + getWorld().getRandomStreams().ai.rand15(2)]});
     m_state.current_anim_state = 5_as;
   }
   rotateCreatureHead(headRot);
@@ -383,7 +383,8 @@ void LaraObject::update()
         surfaceLocation.position.Y = *waterSurfaceHeight;
         surfaceLocation.position.Z = m_state.location.position.Z;
 
-        auto particle = gsl::make_shared<SplashParticle>(surfaceLocation, getWorld(), false);
+        auto particle = getWorld().getLevelArena().makeShared<SplashParticle>(
+          ArenaCategory::Particles, surfaceLocation, getWorld(), false);
         setParent(particle, surfaceLocation.room->node);
         getWorld().getObjectManager().registerParticle(particle);
       }
@@ -438,13 +439,13 @@ void LaraObject::update()
     const auto boneSpheres = getSkeleton()->getBoneCollisionSpheres();
     const auto position
       = core::TRVec{boneSpheres.at(BoneHips).relative(core::TRVec{0_len, 20_len, -50_len}.toRenderSystem())};
-    auto bubbleCount = util::rand15(2);
+    auto bubbleCount = getWorld().getRandomStreams().particles.rand15(2);
     while(bubbleCount-- > 0)
     {
-      auto particle
-        = gsl::make_shared<BubbleParticle>(Location{m_state.location.room, position}, getWorld(), false, true);
+      auto particle = getWorld().getLevelArena().makeShared<BubbleParticle>(
+        ArenaCategory::Particles, Location{m_state.location.room, position}, getWorld(), false, true);
       setParent(particle, nullptr);
-      particle->scale = util::rand15(0.8f) + 0.2f;
+      particle->scale = getWorld().getRandomStreams().particles.rand15(0.8f) + 0.2f;
       m_state.location.room->particles.registerParticle(particle);
     }
   }
@@ -638,7 +639,8 @@ void LaraObject::handleUnderwaterCurrent(CollisionInfo& collisionInfo)
     return;
 
   core::TRVec targetPos;
-  if(!m_underwaterRoute.calculateTarget(getWorld(), targetPos, m_state.location.position, m_state.getCurrentBox()))
+  if(!m_underwaterRoute.calculateTarget(
+       getWorld(), targetPos, m_state.location.position, m_state.getCurrentBox(), getWorld().getRandomStreams().ai))
     return;
 
   targetPos -= m_state.location.position;
@@ -1042,7 +1044,9 @@ void LaraObject::findTarget(const Weapon& weapon)
   Location weaponLocation{m_state.location};
   weaponLocation.position.Y -= weapon.weaponHeight;
   aimAt.reset();
-  core::Angle bestYAngle{std::numeric_limits<core::Angle::type>::max()};
+  std::vector<std::shared_ptr<ModelObject>> candidates;
+  std::vector<core::Angle> candidateYAngles;
+  std::vector<LineOfSightRay> rays;
   for(const auto& currentEnemy : getWorld().getObjectManager().getObjects() | boost::adaptors::map_values)
   {
     if(currentEnemy->m_state.isDead() || currentEnemy.get() == getWorld().getObjectManager().getLaraPtr())
@@ -1071,22 +1075,28 @@ void LaraObject::findTarget(const Weapon& weapon)
     if(util::square(d.X) + util::square(d.Y) + util::square(d.Z) >= util::square(weapon.targetDist))
       continue;
 
+    // the line of sight is tested after all cheaper checks for all candidates at once
     auto enemyPos = getUpperThirdBBoxCtr(*std::dynamic_pointer_cast<const ModelObject>(currentEnemy.get()));
-    if(!raycastLineOfSight(weaponLocation, enemyPos.position, getWorld().getObjectManager()).first)
-      continue;
-
     auto aimAngle = getVectorAngles(enemyPos.position - weaponLocation.position);
     aimAngle.X -= m_torsoRotation.X + m_state.rotation.X;
     aimAngle.Y -= m_torsoRotation.Y + m_state.rotation.Y;
     if(!weapon.lockAngles.y.contains(aimAngle.Y) || !weapon.lockAngles.x.contains(aimAngle.X))
       continue;
 
-    const auto absY = abs(aimAngle.Y);
-    if(absY >= bestYAngle)
+    candidates.emplace_back(modelEnemy);
+    candidateYAngles.emplace_back(abs(aimAngle.Y));
+    rays.emplace_back(LineOfSightRay{weaponLocation, enemyPos.position});
+  }
+
+  const auto lineOfSight = getWorld().getRaycastQueries().raycastLineOfSight(getWorld(), rays);
+  core::Angle bestYAngle{std::numeric_limits<core::Angle::type>::max()};
+  for(size_t i = 0; i < candidates.size(); ++i)
+  {
+    if(!lineOfSight[i].first || candidateYAngles[i] >= bestYAngle)
       continue;
 
-    bestYAngle = absY;
-    aimAt = modelEnemy;
+    bestYAngle = candidateYAngles[i];
+    aimAt = candidates[i];
   }
   updateAimingState(weapon);
 }
@@ -1189,12 +1199,14 @@ void LaraObject::tryShootShotgun()
 
   --getWorld().getPlayer().getInventory().getAmmo(WeaponType::Shotgun).shots;
 
+  // the target can't move between the rounds
+  updateTargetSpheres(aimAt);
   const auto rounds = getWorld().getPlayer().getInventory().getAmmo(WeaponType::Shotgun).roundsPerShot;
   for(size_t i = 0; i < rounds; ++i)
   {
     core::TRRotationXY aimAngle;
-    aimAngle.Y = util::rand15s(+10_deg) + m_state.rotation.Y + leftArm.aimRotation.Y;
-    aimAngle.X = util::rand15s(+10_deg) + leftArm.aimRotation.X;
+    aimAngle.Y = getWorld().getRandomStreams().simulation.rand15s(+10_deg) + m_state.rotation.Y + leftArm.aimRotation.Y;
+    aimAngle.X = getWorld().getRandomStreams().simulation.rand15s(+10_deg) + leftArm.aimRotation.X;
     hitscanSingleRound(WeaponType::Shotgun, aimAt, *this, aimAngle);
   }
 
@@ -1257,10 +1269,25 @@ bool LaraObject::tryShootShot(const WeaponType weaponType,
   }
 
   --ammo.shots;
+  updateTargetSpheres(targetObject);
   hitscanSingleRound(weaponType, targetObject, weaponHolder, aimAngle);
   return true;
 }
 
+void LaraObject::updateTargetSpheres(const std::shared_ptr<ModelObject>& targetObject)
+{
+  m_targetSpheres.clear();
+  if(targetObject == nullptr)
+    return;
+
+  const auto spheres = targetObject->getSkeleton()->getBoneCollisionSpheres();
+  m_targetSpheres.reserve(spheres.size());
+  for(const auto& sphere : spheres)
+  {
+    m_targetSpheres.add(sphere.getCollisionPosition(), util::square(sphere.radius).get<float>());
+  }
+}
+
 void LaraObject::hitscanSingleRound(const WeaponType weaponType,
                                     const std::shared_ptr<ModelObject>& targetObject,
                                     const ModelObject& weaponHolder,
@@ -1273,34 +1300,15 @@ void LaraObject::hitscanSingleRound(const WeaponType weaponType,
   const auto weapon = &Weapon::get(weaponType);
   core::TRVec weaponPosition = weaponHolder.m_state.location.position;
   weaponPosition.Y -= weapon->weaponHeight;
+  auto& random = getWorld().getRandomStreams().simulation;
   const core::TRRotation shootVector{
-    util::rand15s(weapon->shotInaccuracy) + aimAngle.X, util::rand15s(weapon->shotInaccuracy) + aimAngle.Y, +0_deg};
+    random.rand15s(weapon->shotInaccuracy) + aimAngle.X, random.rand15s(weapon->shotInaccuracy) + aimAngle.Y, +0_deg};
 
-  std::vector<SkeletalModelNode::Sphere> spheres;
-  if(targetObject != nullptr)
-  {
-    spheres = targetObject->getSkeleton()->getBoneCollisionSpheres();
-  }
   const auto bulletDir = normalize(glm::vec3(shootVector.toMatrix()[2])); // +Z is our shooting direction
   std::optional<glm::vec3> bestHitPos;
-  float bestHitDistance = std::numeric_limits<float>::max();
-  for(const auto& sphere : spheres)
+  if(const auto hit = m_targetSpheres.nearestHit(weaponPosition.toRenderSystem(), bulletDir); hit.has_value())
   {
-    // https://viclw17.github.io/2018/07/16/raytracing-ray-sphere-intersection/
-    const auto oc = weaponPosition.toRenderSystem() - sphere.getCollisionPosition();
-    const auto b = glm::dot(oc, bulletDir) * 2;
-    const auto c = glm::dot(oc, oc) - util::square(sphere.radius).get<float>();
-    const auto discriminant = b * b - 4 * c;
-    if(discriminant < 0)
-      continue;
-
-    const auto t = (-b - glm::sqrt(discriminant)) / 2;
-    if(bestHitPos.has_value() && t > bestHitDistance)
-      continue;
-
-    const auto hitPos = weaponPosition.toRenderSystem() + t * bulletDir;
-    bestHitDistance = t;
-    bestHitPos = hitPos;
+    bestHitPos = weaponPosition.toRenderSystem() + hit->distance * bulletDir;
   }
 
   if(!bestHitPos.has_value())
@@ -1868,7 +1876,8 @@ void LaraObject::burnIfAlive()
 
   for(size_t i = 0; i < 10; ++i)
   {
-    auto particle = gsl::make_shared<FlameParticle>(m_state.location, getWorld(), true);
+    auto particle = getWorld().getLevelArena().makeShared<FlameParticle>(
+      ArenaCategory::Particles, m_state.location, getWorld(), true);
     setParent(particle, m_state.location.room->node);
     getWorld().getObjectManager().registerParticle(particle);
   }
@@ -17,6 +17,7 @@
 #include "qs/qs.h"
 #include "render/scene/node.h"
 #include "serialization/serialization_fwd.h"
+#include "util/raysphere.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -400,10 +401,13 @@ private:
   uint8_t m_cheatIdx = 0;
   core::Angle m_cheatLastRotation = 0_deg;
   float m_cheatTotalRotation = 0;
+  //! Bone collision spheres of the current target, re-used for all rounds of a shot.
+  util::SphereSet m_targetSpheres;
 
   void initMuzzleFlashes();
   void updateCheats();
   void smoothlyRevertHeadRotation();
+  void updateTargetSpheres(const std::shared_ptr<ModelObject>& targetObject);
   void hitscanSingleRound(WeaponType weaponType,
                           const std::shared_ptr<ModelObject>& targetObject,
                           const ModelObject& weaponHolder,
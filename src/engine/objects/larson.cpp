@@ -46,7 +46,7 @@ void Larson::update()
       }
       else if(isBored())
       {
-        if(util::rand15() >= 96)
+        if(getWorld().getRandomStreams().ai.rand15() >= 96)
           goal(2_as); // walking
         else
           goal(6_as); // standing
@@ -62,7 +62,7 @@ void Larson::update()
       break;
     case 2: // walking
       getCreatureInfo()->maxTurnSpeed = 3_deg / 1_frame;
-      if(isBored() && util::rand15() < 96)
+      if(isBored() && getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 6_as);
       else if(isEscaping())
         goal(1_as, 3_as);
@@ -74,7 +74,7 @@ void Larson::update()
     case 3: // running
       getCreatureInfo()->maxTurnSpeed = 6_deg / 1_frame;
       tiltRot = creatureTurn / 2;
-      if(isBored() && util::rand15() < 96)
+      if(isBored() && getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 6_as);
       else if(canShootAtLara(enemyLocation))
         goal(1_as, 4_as);
@@ -92,7 +92,7 @@ void Larson::update()
     case 6: // standing
       if(!isBored())
         goal(1_as); // standing/holding weapon
-      else if(util::rand15() < 96)
+      else if(getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 2_as);
       break;
     case 7: // firing
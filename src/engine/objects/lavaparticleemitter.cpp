@@ -16,7 +16,8 @@ namespace engine::objects
 {
 void LavaParticleEmitter::update()
 {
-  auto particle = gsl::make_shared<LavaParticle>(m_state.location, getWorld());
+  auto particle = getWorld().getLevelArena().makeShared<LavaParticle>(
+    ArenaCategory::Particles, m_state.location, getWorld());
   setParent(particle, m_state.location.room->node);
   getWorld().getObjectManager().registerParticle(particle);
 
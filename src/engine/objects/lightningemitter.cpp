@@ -173,7 +173,7 @@ void LightningEmitter::update()
   if(m_shooting)
   {
     m_shooting = false;
-    m_chargeTimeout = 35 + util::rand15(45);
+    m_chargeTimeout = 35 + getWorld().getRandomStreams().simulation.rand15(45);
     m_laraHit = false;
     if(getWorld().roomsAreSwapped())
       getWorld().swapAllRooms();
@@ -211,8 +211,8 @@ void LightningEmitter::update()
   {
     // select a random "pole"
     const auto objectSpheres = getSkeleton()->getBoneCollisionSpheres();
-    m_mainBoltEnd = core::TRVec{objectSpheres[util::rand15(objectSpheres.size() - 1) + 1].getCollisionPosition()}
-                    - m_state.location.position;
+    const auto& pole = objectSpheres[getWorld().getRandomStreams().simulation.rand15(objectSpheres.size() - 1) + 1];
+    m_mainBoltEnd = core::TRVec{pole.getCollisionPosition()} - m_state.location.position;
     m_mainBoltEnd
       = core::TRVec{glm::vec3((-m_state.rotation).toMatrix() * glm::vec4(m_mainBoltEnd.toRenderSystem(), 1.0f))};
   }
@@ -229,7 +229,7 @@ void LightningEmitter::collide(CollisionInfo& /*info*/)
     return;
 
   auto& lara = getWorld().getObjectManager().getLara();
-  lara.hit_direction = static_cast<core::Axis>(util::rand15(4));
+  lara.hit_direction = static_cast<core::Axis>(getWorld().getRandomStreams().simulation.rand15(4));
   lara.hit_frame += 1_frame;
   if(lara.hit_frame > 34_frame)
     lara.hit_frame = 34_frame;
@@ -256,6 +256,7 @@ void LightningEmitter::prepareRender()
 
   for(const auto& childBolt : m_childBolts)
   {
+    // purely visual, so this must not advance the simulation streams
     const auto end
       = m_mainBoltEnd
         + core::TRVec{util::rand15s(core::QuarterSectorSize / 2), 0_len, util::rand15s(core::QuarterSectorSize / 2)};
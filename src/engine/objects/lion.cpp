@@ -61,7 +61,7 @@ void Lion::update()
       getCreatureInfo()->maxTurnSpeed = 2_deg / 1_frame;
       if(!isBored())
         goal(1_as);
-      else if(util::rand15() < 128)
+      else if(getWorld().getRandomStreams().ai.rand15() < 128)
         goal(1_as, 6_as);
       break;
     case 3:
@@ -73,7 +73,7 @@ void Lion::update()
         goal(1_as);
       else if(enemyLocation.enemyAhead && touched(0x380066UL))
         goal(1_as);
-      else if(!isEscaping() && util::rand15() < 128)
+      else if(!isEscaping() && getWorld().getRandomStreams().ai.rand15() < 128)
         goal(1_as, 6_as);
       break;
     case 4:
@@ -102,18 +102,18 @@ void Lion::update()
     {
       if(m_state.type == TR1ItemId::Panther)
       {
-        getSkeleton()->setAnim(
-          gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Panther)->animations[4 + util::rand15(2)]});
+        getSkeleton()->setAnim(gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Panther)
+                                                ->animations[4 + getWorld().getRandomStreams().ai.rand15(2)]});
       }
       else if(m_state.type == TR1ItemId::LionMale)
       {
-        getSkeleton()->setAnim(
-          gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::LionMale)->animations[7 + util::rand15(2)]});
+        getSkeleton()->setAnim(gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::LionMale)
+                                                ->animations[7 + getWorld().getRandomStreams().ai.rand15(2)]});
       }
       else
       {
-        getSkeleton()->setAnim(
-          gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::LionFemale)->animations[7 + util::rand15(2)]});
+        getSkeleton()->setAnim(gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::LionFemale)
+                                                ->animations[7 + getWorld().getRandomStreams().ai.rand15(2)]});
       }
       m_state.current_anim_state = 5_as;
     }
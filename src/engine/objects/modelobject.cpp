@@ -27,6 +27,7 @@
 #include <boost/assert.hpp>
 #include <cstdint>
 #include <exception>
+#include <glm/common.hpp>
 #include <glm/geometric.hpp>
 #include <optional>
 #include <vector>
@@ -41,7 +42,8 @@ ModelObject::ModelObject(const std::string& name,
                          const gsl::not_null<const world::SkeletalModelType*>& model,
                          bool shadowCaster)
     : Object{world, room, item, hasUpdateFunction}
-    , m_skeleton{std::make_shared<SkeletalModelNode>(name, world, model, shadowCaster)}
+    , m_skeleton{world->getLevelArena().makeShared<SkeletalModelNode>(
+        ArenaCategory::SkeletalModels, name, world, model, shadowCaster)}
 {
   SkeletalModelNode::buildMesh(m_skeleton, m_state.current_anim_state);
   m_lighting.bind(*m_skeleton, *world);
@@ -346,7 +348,14 @@ gslu::nn_shared<Particle> ModelObject::emitParticle(
 
 void ModelObject::updateLighting()
 {
-  m_lighting.update(core::Shade{core::Shade::type{-1}}, *m_state.location.room);
+  // a sphere around the origin containing the bounding box in any orientation
+  const auto bbox = getBoundingBox();
+  const auto extent = glm::max(glm::abs(core::TRVec{bbox.x.min, bbox.y.min, bbox.z.min}.toRenderSystem()),
+                               glm::abs(core::TRVec{bbox.x.max, bbox.y.max, bbox.z.max}.toRenderSystem()));
+  m_lighting.update(core::Shade{core::Shade::type{-1}},
+                    *m_state.location.room,
+                    m_state.location.position.toRenderSystem(),
+                    glm::length(extent));
 }
 
 void ModelObject::serialize(const serialization::Serializer<world::World>& ser)
@@ -159,7 +159,7 @@ void FlyingMutant::update()
       }
       else if(isBored() || (isStalking() && enemyLocation.zoneId != enemyLocation.enemyZoneId))
       {
-        if(util::rand15() < 80)
+        if(getWorld().getRandomStreams().ai.rand15() < 80)
         {
           goal(6_as);
         }
@@ -205,10 +205,10 @@ void FlyingMutant::update()
       {
         if(enemyLocation.enemyDistance >= util::square(4608_len))
           goal(DoPrepareAttack);
-        else if(enemyLocation.zoneId == enemyLocation.enemyZoneId || util::rand15() < 256)
+        else if(enemyLocation.zoneId == enemyLocation.enemyZoneId || getWorld().getRandomStreams().ai.rand15() < 256)
           goal(DoWalk);
       }
-      else if(isBored() && util::rand15() < 256)
+      else if(isBored() && getWorld().getRandomStreams().ai.rand15() < 256)
       {
         goal(DoWalk);
       }
@@ -340,7 +340,7 @@ void CentaurMutant::update()
         goal(1_as, 6_as);
       else if(canShootAtLara(enemyLocation))
         goal(1_as, 4_as);
-      else if(util::rand15() < 96)
+      else if(getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 6_as);
       break;
     case 4:
@@ -445,7 +445,7 @@ void TorsoBoss::update()
       }
       else if(getWorld().getObjectManager().getLara().m_state.health > core::LaraHealth / 2)
       {
-        if(util::rand15(2) == 0)
+        if(getWorld().getRandomStreams().ai.rand15(2) == 0)
           goal(Attack2);
         else
           goal(Attack1);
@@ -66,7 +66,7 @@ void Natla::update()
     const auto canShoot = abs(enemyLocation.angleToEnemy) < 30_deg && canShootAtLara(enemyLocation);
     if(m_state.current_anim_state == AimFlying && m_attemptToFly)
     {
-      if(canShoot && util::rand15() < 256)
+      if(canShoot && getWorld().getRandomStreams().ai.rand15() < 256)
         m_attemptToFly = false;
 
       if(!m_attemptToFly)
@@ -134,9 +134,9 @@ void Natla::update()
         auto particle = emitParticle(bulletEmissionPos, bulletEmissionBoneIdx, &createMutantGrenade);
         headRot = particle->angle.X;
         particle = emitParticle(bulletEmissionPos, bulletEmissionBoneIdx, &createMutantGrenade);
-        particle->angle.Y += util::rand15s(45_deg);
+        particle->angle.Y += getWorld().getRandomStreams().ai.rand15s(45_deg);
         particle = emitParticle(bulletEmissionPos, bulletEmissionBoneIdx, &createMutantGrenade);
-        particle->angle.Y += util::rand15s(45_deg);
+        particle->angle.Y += getWorld().getRandomStreams().ai.rand15s(45_deg);
         require(AimDispatch);
       }
       break;
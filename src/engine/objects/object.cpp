@@ -6,7 +6,6 @@
 #include "engine/objectmanager.h"
 #include "engine/particle.h"
 #include "engine/presenter.h"
-#include "engine/script/scriptengine.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/room.h"
 #include "engine/world/sector.h"
@@ -56,7 +55,7 @@ Object::Object(const gsl::not_null<world::World*>& world,
     m_state.location.updateRoom();
   }
 
-  m_state.loadObjectInfo(world->getEngine().getScriptEngine().getGameflow());
+  m_state.loadObjectInfo(world->getObjectInfo(m_state.type));
 
   m_state.rotation.Y = item.rotation;
   m_state.activationState = floordata::ActivationState(item.activationState);
@@ -164,7 +163,8 @@ bool InteractionLimits::canInteract(const ObjectState& objectState, const Object
 
 void Object::emitRicochet(const Location& location)
 {
-  const auto particle = gsl::make_shared<RicochetParticle>(location, getWorld());
+  const auto particle = getWorld().getLevelArena().makeShared<RicochetParticle>(
+    ArenaCategory::Particles, location, getWorld());
   setParent(particle, m_state.location.room->node);
   getWorld().getObjectManager().registerParticle(particle);
   getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Ricochet, gsl::not_null{particle.get().get()});
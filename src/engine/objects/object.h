@@ -142,6 +142,12 @@ public:
   {
   }
 
+  //! Whether patchFloor() or patchCeiling() may change heights, depending on the object's position and state.
+  [[nodiscard]] virtual bool patchesHeights() const
+  {
+    return false;
+  }
+
   void activate();
 
   void deactivate();
@@ -127,8 +127,12 @@ struct ModelFactory : public ObjectFactory
     const auto room = gsl::not_null{&world.getRooms().at(item.room.get())};
     const auto& model = world.findAnimatedModelForType(item.type);
     gsl_Assert(model != nullptr);
-    auto object = gsl::make_shared<T>(
-      makeObjectName(item.type.get_as<TR1ItemId>(), id), gsl::not_null{&world}, room, item, gsl::not_null{model.get()});
+    auto object = world.getLevelArena().makeShared<T>(ArenaCategory::Objects,
+                                                      makeObjectName(item.type.get_as<TR1ItemId>(), id),
+                                                      gsl::not_null{&world},
+                                                      room,
+                                                      item,
+                                                      gsl::not_null{model.get()});
     addChild(gsl::not_null{room->node}, gsl::not_null{object->getNode()});
     object->applyTransform();
     return object;
@@ -137,7 +141,8 @@ struct ModelFactory : public ObjectFactory
   [[nodiscard]] gslu::nn_shared<Object>
     createFromSave(const Location& location, const serialization::Serializer<world::World>& ser) const override
   {
-    auto object = gsl::make_shared<T>(gsl::not_null{&ser.context}, location);
+    auto object
+      = ser.context.getLevelArena().makeShared<T>(ArenaCategory::Objects, gsl::not_null{&ser.context}, location);
     object->serialize(ser);
     return object;
   }
@@ -156,8 +161,12 @@ struct SpriteFactory : public ObjectFactory
     gsl_Assert(spriteSequence != nullptr && !spriteSequence->sprites.empty());
 
     const world::Sprite& sprite = spriteSequence->sprites[0];
-    return gsl::make_shared<T>(
-      makeObjectName(item.type.get_as<TR1ItemId>(), id), gsl::not_null{&world}, room, item, gsl::not_null{&sprite});
+    return world.getLevelArena().makeShared<T>(ArenaCategory::Objects,
+                                               makeObjectName(item.type.get_as<TR1ItemId>(), id),
+                                               gsl::not_null{&world},
+                                               room,
+                                               item,
+                                               gsl::not_null{&sprite});
   }
 
   [[nodiscard]] gslu::nn_shared<Object>
@@ -165,7 +174,8 @@ struct SpriteFactory : public ObjectFactory
   {
     std::string spriteName;
     ser(S_NV("@name", spriteName));
-    auto object = gsl::make_shared<T>(spriteName, gsl::not_null{&ser.context}, location);
+    auto object = ser.context.getLevelArena().makeShared<T>(
+      ArenaCategory::Objects, spriteName, gsl::not_null{&ser.context}, location);
     object->serialize(ser);
     return object;
   }
@@ -197,8 +207,12 @@ struct WalkingMutantFactory : public ObjectFactory
     const auto room = gsl::not_null{&world.getRooms().at(item.room.get())};
     const auto& model = world.findAnimatedModelForType(TR1ItemId::FlyingMutant);
     gsl_Assert(model != nullptr);
-    auto object = gsl::make_shared<WalkingMutant>(
-      makeObjectName(item.type.get_as<TR1ItemId>(), id), gsl::not_null{&world}, room, item, gsl::not_null{model.get()});
+    auto object = world.getLevelArena().makeShared<WalkingMutant>(ArenaCategory::Objects,
+                                                                  makeObjectName(item.type.get_as<TR1ItemId>(), id),
+                                                                  gsl::not_null{&world},
+                                                                  room,
+                                                                  item,
+                                                                  gsl::not_null{model.get()});
     addChild(gsl::not_null{room->node}, gsl::not_null{object->getNode()});
     object->applyTransform();
     return object;
@@ -207,7 +221,8 @@ struct WalkingMutantFactory : public ObjectFactory
   [[nodiscard]] gslu::nn_shared<Object>
     createFromSave(const Location& location, const serialization::Serializer<world::World>& ser) const override
   {
-    auto object = gsl::make_shared<WalkingMutant>(gsl::not_null{&ser.context}, location);
+    auto object = ser.context.getLevelArena().makeShared<WalkingMutant>(
+      ArenaCategory::Objects, gsl::not_null{&ser.context}, location);
     object->serialize(ser);
     return object;
   }
@@ -387,8 +402,12 @@ std::shared_ptr<Object> createObject(world::World& world, loader::file::Item& it
 
   if(const auto& model = world.findAnimatedModelForType(item.type))
   {
-    auto object = std::make_shared<StubObject>(
-      makeObjectName(item.type.get_as<TR1ItemId>(), id), gsl::not_null{&world}, room, item, gsl::not_null{model.get()});
+    auto object = world.getLevelArena().makeShared<StubObject>(ArenaCategory::Objects,
+                                                               makeObjectName(item.type.get_as<TR1ItemId>(), id),
+                                                               gsl::not_null{&world},
+                                                               room,
+                                                               item,
+                                                               gsl::not_null{model.get()});
     BOOST_LOG_TRIVIAL(warning) << "Unimplemented object type " << toString(item.type.get_as<TR1ItemId>());
 
     addChild(gsl::not_null{room->node}, gsl::not_null{object->getNode()});
@@ -406,13 +425,14 @@ std::shared_ptr<Object> createObject(world::World& world, loader::file::Item& it
     std::shared_ptr<Object> object;
 
     BOOST_LOG_TRIVIAL(warning) << "Unimplemented object type " << toString(item.type.get_as<TR1ItemId>());
-    return std::make_shared<SpriteObject>(makeObjectName(item.type.get_as<TR1ItemId>(), id),
-                                          gsl::not_null{&world},
-                                          room,
-                                          item,
-                                          true,
-                                          gsl::not_null{&sprite},
-                                          false);
+    return world.getLevelArena().makeShared<SpriteObject>(ArenaCategory::Objects,
+                                                          makeObjectName(item.type.get_as<TR1ItemId>(), id),
+                                                          gsl::not_null{&world},
+                                                          room,
+                                                          item,
+                                                          true,
+                                                          gsl::not_null{&sprite},
+                                                          false);
   }
 
   BOOST_LOG_TRIVIAL(error) << "Failed to find an appropriate animated model for object type " << int(item.type.get());
@@ -6,7 +6,7 @@
 #include "core/vec.h"
 #include "engine/items_tr1.h"
 #include "engine/objectmanager.h"
-#include "engine/script/reflection.h"
+#include "engine/script/objectinfo.h"
 #include "engine/world/box.h"
 #include "engine/world/room.h"
 #include "engine/world/sector.h"
@@ -86,9 +86,9 @@ glm::vec3 ObjectState::getPosition() const
   return location.position.toRenderSystem();
 }
 
-void ObjectState::loadObjectInfo(const script::Gameflow& gameflow)
+void ObjectState::loadObjectInfo(const script::ObjectInfo& objectInfo)
 {
-  health = core::Health{gameflow.getObjectInfos().at(type.get_as<TR1ItemId>())->hit_points};
+  health = core::Health{objectInfo.hit_points};
 }
 
 void ObjectState::serialize(const serialization::Serializer<world::World>& ser)
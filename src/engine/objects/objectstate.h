@@ -30,7 +30,7 @@ struct Room;
 
 namespace engine::script
 {
-class Gameflow;
+struct ObjectInfo;
 }
 
 namespace engine::objects
@@ -123,7 +123,7 @@ public:
 
   const world::Sector* getCurrentSector() const;
 
-  void loadObjectInfo(const script::Gameflow& gameflow);
+  void loadObjectInfo(const script::ObjectInfo& objectInfo);
 
   bool isDead() const
   {
@@ -88,7 +88,7 @@ void Pierre::update()
       }
       else if(isBored())
       {
-        if(util::rand15() >= 96)
+        if(getWorld().getRandomStreams().ai.rand15() >= 96)
           goal(2_as);
         else
           goal(6_as);
@@ -104,7 +104,7 @@ void Pierre::update()
       break;
     case 2:
       getCreatureInfo()->maxTurnSpeed = 3_deg / 1_frame;
-      if(isBored() && util::rand15() < 96)
+      if(isBored() && getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 6_as);
       else if(isEscaping())
         goal(1_as, 3_as);
@@ -116,7 +116,7 @@ void Pierre::update()
     case 3:
       getCreatureInfo()->maxTurnSpeed = 6_deg / 1_frame;
       tiltRot = creatureTurn / 2;
-      if(isBored() && util::rand15() < 96)
+      if(isBored() && getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 6_as);
       else if(canShootAtLara(enemyLocation))
         goal(1_as, 4_as);
@@ -134,7 +134,7 @@ void Pierre::update()
     case 6:
       if(!isBored())
         goal(1_as);
-      else if(util::rand15() < 96)
+      else if(getWorld().getRandomStreams().ai.rand15() < 96)
         goal(1_as, 2_as);
       break;
     case 7:
@@ -146,7 +146,7 @@ void Pierre::update()
           hitLara(25_hp);
         require(4_as);
       }
-      if(isEscaping() && util::rand15() > 8192)
+      if(isEscaping() && getWorld().getRandomStreams().ai.rand15() > 8192)
         require(1_as);
       break;
     default:
@@ -113,8 +113,11 @@ void PuzzleHole::initMesh()
 
   const auto parent = m_skeleton->getParent().lock();
   setParent(gsl::not_null{m_skeleton}, nullptr);
-  m_skeleton = std::make_shared<SkeletalModelNode>(
-    toString(m_state.type.get_as<TR1ItemId>()), gsl::not_null{&getWorld()}, gsl::not_null{model.get()}, false);
+  m_skeleton = getWorld().getLevelArena().makeShared<SkeletalModelNode>(ArenaCategory::SkeletalModels,
+                                                                        toString(m_state.type.get_as<TR1ItemId>()),
+                                                                        gsl::not_null{&getWorld()},
+                                                                        gsl::not_null{model.get()},
+                                                                        false);
   m_skeleton->setAnimation(
     m_state.current_anim_state, gsl::not_null{&model->animations[0]}, model->animations->firstFrame);
   setParent(gsl::not_null{m_skeleton}, parent);
@@ -56,7 +56,7 @@ void Raptor::update()
       getCreatureInfo()->maxTurnSpeed = 1_deg / 1_frame;
       if(!isBored())
         goal(1_as);
-      else if(enemyLocation.enemyAhead && util::rand15() < 256)
+      else if(enemyLocation.enemyAhead && getWorld().getRandomStreams().ai.rand15() < 256)
         goal(1_as, 6_as);
       break;
     case 3:
@@ -70,13 +70,13 @@ void Raptor::update()
       {
         if(m_state.goal_anim_state == 3_as)
         {
-          if(util::rand15() >= 8192)
+          if(getWorld().getRandomStreams().ai.rand15() >= 8192)
             goal(7_as);
           else
             goal(1_as);
         }
       }
-      else if(enemyLocation.enemyAhead && !isEscaping() && util::rand15() < 256)
+      else if(enemyLocation.enemyAhead && !isEscaping() && getWorld().getRandomStreams().ai.rand15() < 256)
         goal(1_as, 6_as);
       else if(isBored())
         goal(1_as);
@@ -123,8 +123,8 @@ void Raptor::update()
   }
   else if(m_state.current_anim_state != 5_as)
   {
-    getSkeleton()->setAnim(
-      gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Raptor)->animations[9 + util::rand15(2)]});
+    getSkeleton()->setAnim(gsl::not_null{&getWorld().findAnimatedModelForType(TR1ItemId::Raptor)
+                                            ->animations[9 + getWorld().getRandomStreams().ai.rand15(2)]});
     m_state.current_anim_state = 5_as;
   }
 
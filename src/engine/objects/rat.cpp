@@ -162,7 +162,7 @@ void Rat::update()
           goal(1_as);
         else if(enemyLocation.canAttackForward && enemyLocation.enemyDistance < util::square(1536_len))
           goal(2_as);
-        else if(enemyLocation.enemyAhead && util::rand15() < 256)
+        else if(enemyLocation.enemyAhead && getWorld().getRandomStreams().ai.rand15() < 256)
           goal(1_as, 6_as);
         break;
       case 4:
@@ -174,7 +174,7 @@ void Rat::update()
         }
         break;
       case 6:
-        if(!isBored() || util::rand15() < 256)
+        if(!isBored() || getWorld().getRandomStreams().ai.rand15() < 256)
           goal(1_as);
         break;
       default:
@@ -138,14 +138,15 @@ void RollingBall::collide(CollisionInfo& collisionInfo)
       lara.m_state.fallspeed = 0_spd;
     }
 
+    auto& random = getWorld().getRandomStreams().simulation;
     for(int i = 0; i < 15; ++i)
     {
       const auto tmp = lara.m_state.location.position
-                       + core::TRVec{util::rand15s(128_len), -util::rand15s(512_len), util::rand15s(128_len)};
+                       + core::TRVec{random.rand15s(128_len), -random.rand15s(512_len), random.rand15s(128_len)};
       auto fx = createBloodSplat(getWorld(),
                                  Location{m_state.location.room, tmp},
                                  2 * m_state.speed,
-                                 util::rand15s(22.5_deg) + m_state.rotation.Y);
+                                 random.rand15s(22.5_deg) + m_state.rotation.Y);
       getWorld().getObjectManager().registerParticle(fx);
     }
     return;
@@ -120,10 +120,11 @@ void ScionPiece3::update()
 
   if(m_deadTime % 10_frame == 0_frame)
   {
+    auto& random = getWorld().getRandomStreams().simulation;
     const auto pos = m_state.location.position
-                     + core::TRVec{util::rand15s(512_len), util::rand15s(64_len) - 500_len, util::rand15s(512_len)};
-    const auto particle = gsl::make_shared<ExplosionParticle>(
-      Location{m_state.location.room, pos}, getWorld(), 0_spd, core::TRRotation{});
+                     + core::TRVec{random.rand15s(512_len), random.rand15s(64_len) - 500_len, random.rand15s(512_len)};
+    const auto particle = getWorld().getLevelArena().makeShared<ExplosionParticle>(
+      ArenaCategory::Particles, Location{m_state.location.room, pos}, getWorld(), 0_spd, core::TRRotation{});
     setParent(particle, m_state.location.room->node);
     getWorld().getObjectManager().registerParticle(particle);
     getWorld().getAudioEngine().playSoundEffect(TR1SoundEffect::Explosion2, gsl::not_null{particle.get().get()});
@@ -57,7 +57,8 @@ bool shatterModel(ModelObject& object, const std::bitset<32>& meshMask, const co
     object.getSkeleton()->rebuildMesh();
     world::RenderMeshDataCompositor compositor;
     compositor.append(*modelType->bones[i].mesh, gl::SRGBA8{0, 0, 0, 0});
-    auto particle = gsl::make_shared<MeshShrapnelParticle>(
+    auto particle = object.getWorld().getLevelArena().makeShared<MeshShrapnelParticle>(
+      ArenaCategory::Particles,
       Location{object.m_state.location.room, core::TRVec{object.getSkeleton()->getMeshPartTranslationWorld(i)}},
       object.getWorld(),
       compositor.toMesh(
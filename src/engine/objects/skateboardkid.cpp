@@ -32,8 +32,12 @@ namespace engine::objects
 {
 SkateboardKid::SkateboardKid(const gsl::not_null<world::World*>& world, const Location& location)
     : AIAgent{world, location}
-    , m_skateboard{std::make_shared<SkeletalModelNode>(
-        "skateboard", world, gsl::not_null{world->findAnimatedModelForType(TR1ItemId::Skateboard).get()}, true)}
+    , m_skateboard{world->getLevelArena().makeShared<SkeletalModelNode>(
+        ArenaCategory::SkeletalModels,
+        "skateboard",
+        world,
+        gsl::not_null{world->findAnimatedModelForType(TR1ItemId::Skateboard).get()},
+        true)}
 {
 }
 
@@ -43,8 +47,12 @@ SkateboardKid::SkateboardKid(const std::string& name,
                              const loader::file::Item& item,
                              const gsl::not_null<const world::SkeletalModelType*>& animatedModel)
     : AIAgent{name, world, room, item, animatedModel}
-    , m_skateboard{std::make_shared<SkeletalModelNode>(
-        "skateboard", world, gsl::not_null{world->findAnimatedModelForType(TR1ItemId::Skateboard).get()}, true)}
+    , m_skateboard{world->getLevelArena().makeShared<SkeletalModelNode>(
+        ArenaCategory::SkeletalModels,
+        "skateboard",
+        world,
+        gsl::not_null{world->findAnimatedModelForType(TR1ItemId::Skateboard).get()},
+        true)}
 {
   m_state.current_anim_state = 2_as;
   SkeletalModelNode::buildMesh(m_skateboard, m_state.current_anim_state);
@@ -115,7 +123,7 @@ void SkateboardKid::update()
       break;
     case 2:
       m_triedShoot = false;
-      if(util::rand15() < 512)
+      if(getWorld().getRandomStreams().ai.rand15() < 512)
       {
         goal(3_as);
       }
@@ -133,7 +141,7 @@ void SkateboardKid::update()
       }
       break;
     case 3:
-      if(util::rand15() < 1024)
+      if(getWorld().getRandomStreams().ai.rand15() < 1024)
       {
         goal(2_as);
       }
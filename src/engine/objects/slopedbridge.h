@@ -75,6 +75,11 @@ public:
     y = tmp + core::QuarterSectorSize;
   }
 
+  [[nodiscard]] bool patchesHeights() const final
+  {
+    return true;
+  }
+
   void serialize(const serialization::Serializer<world::World>& ser) override;
 
 private:
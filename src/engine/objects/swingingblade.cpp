@@ -43,14 +43,15 @@ void SwingingBlade::update()
     getWorld().getObjectManager().getLara().m_state.is_hit = true;
     getWorld().getObjectManager().getLara().m_state.health -= 100_hp;
 
+    auto& random = getWorld().getRandomStreams().simulation;
     const core::TRVec splatPos{
-      getWorld().getObjectManager().getLara().m_state.location.position.X + util::rand15s(128_len),
-      getWorld().getObjectManager().getLara().m_state.location.position.Y - util::rand15(745_len),
-      getWorld().getObjectManager().getLara().m_state.location.position.Z + util::rand15s(128_len)};
+      getWorld().getObjectManager().getLara().m_state.location.position.X + random.rand15s(128_len),
+      getWorld().getObjectManager().getLara().m_state.location.position.Y - random.rand15(745_len),
+      getWorld().getObjectManager().getLara().m_state.location.position.Z + random.rand15s(128_len)};
     auto fx = createBloodSplat(getWorld(),
                                Location{m_state.location.room, splatPos},
                                getWorld().getObjectManager().getLara().m_state.speed,
-                               getWorld().getObjectManager().getLara().m_state.rotation.Y + util::rand15s(+22_deg));
+                               getWorld().getObjectManager().getLara().m_state.rotation.Y + random.rand15s(+22_deg));
     getWorld().getObjectManager().registerParticle(fx);
   }
 
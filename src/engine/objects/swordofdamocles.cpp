@@ -72,12 +72,13 @@ void SwordOfDamocles::collide(CollisionInfo& collisionInfo)
     return;
 
   getWorld().getObjectManager().getLara().m_state.health -= 100_hp;
+  auto& random = getWorld().getRandomStreams().simulation;
   const auto tmp = getWorld().getObjectManager().getLara().m_state.location.position
-                   + core::TRVec{util::rand15s(128_len), -util::rand15(745_len), util::rand15s(128_len)};
+                   + core::TRVec{random.rand15s(128_len), -random.rand15(745_len), random.rand15s(128_len)};
   auto fx = createBloodSplat(getWorld(),
                              Location{m_state.location.room, tmp},
                              getWorld().getObjectManager().getLara().m_state.speed,
-                             util::rand15s(22.5_deg) + m_state.rotation.Y);
+                             random.rand15s(22.5_deg) + m_state.rotation.Y);
   getWorld().getObjectManager().registerParticle(fx);
 }
 
@@ -101,9 +102,10 @@ SwordOfDamocles::SwordOfDamocles(const std::string& name,
                                  const gsl::not_null<const world::SkeletalModelType*>& animatedModel)
     : ModelObject{name, world, room, item, true, animatedModel, true}
 {
-  m_state.rotation.Y += util::rand15s(180_deg) + util::rand15s(180_deg);
+  auto& random = getWorld().getRandomStreams().simulation;
+  m_state.rotation.Y += random.rand15s(180_deg) + random.rand15s(180_deg);
   m_state.fallspeed = 50_spd;
-  m_rotateSpeed = util::rand15s(2048_au / 1_frame);
+  m_rotateSpeed = random.rand15s(2048_au / 1_frame);
   getSkeleton()->getRenderState().setScissorTest(false);
 }
 } // namespace engine::objects
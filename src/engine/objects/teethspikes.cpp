@@ -25,7 +25,7 @@ void engine::objects::TeethSpikes::collide(CollisionInfo& collisionInfo)
      && isNear(getWorld().getObjectManager().getLara(), collisionInfo.collisionRadius)
      && testBoneCollision(getWorld().getObjectManager().getLara()))
   {
-    int bloodSplats = util::rand15(2);
+    int bloodSplats = getWorld().getRandomStreams().simulation.rand15(2);
     if(!getWorld().getObjectManager().getLara().m_state.falling)
     {
       if(getWorld().getObjectManager().getLara().m_state.speed < 30_spd)
@@ -43,15 +43,16 @@ void engine::objects::TeethSpikes::collide(CollisionInfo& collisionInfo)
       }
     }
     getWorld().getObjectManager().getLara().m_state.health -= 15_hp;
+    auto& random = getWorld().getRandomStreams().simulation;
     while(bloodSplats-- > 0)
     {
       auto fx = createBloodSplat(
         getWorld(),
         Location{getWorld().getObjectManager().getLara().m_state.location.room,
                  getWorld().getObjectManager().getLara().m_state.location.position
-                   + core::TRVec{util::rand15s(128_len), -util::rand15(512_len), util::rand15s(128_len)}},
+                   + core::TRVec{random.rand15s(128_len), -random.rand15(512_len), random.rand15s(128_len)}},
         20_spd,
-        util::rand15(+180_deg));
+        random.rand15(+180_deg));
       getWorld().getObjectManager().registerParticle(fx);
     }
     if(getWorld().getObjectManager().getLara().isDead())
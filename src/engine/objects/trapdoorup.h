@@ -47,6 +47,11 @@ public:
 
   void patchCeiling(const core::TRVec& pos, core::Length& y) override;
 
+  [[nodiscard]] bool patchesHeights() const override
+  {
+    return true;
+  }
+
   void serialize(const serialization::Serializer<world::World>& ser) override;
 
 private:
@@ -85,7 +85,7 @@ void TRex::update()
       getCreatureInfo()->maxTurnSpeed = 2_deg / 1_frame;
       if(!isBored() || !m_wantAttack)
         goal(Think);
-      else if(enemyLocation.enemyAhead && util::rand15() < 512)
+      else if(enemyLocation.enemyAhead && getWorld().getRandomStreams().ai.rand15() < 512)
         goal(Think, 6_as);
       break;
     case RunningAttack.get():
@@ -94,7 +94,7 @@ void TRex::update()
         goal(Think); // NOLINT(bugprone-branch-clone)
       else if(m_wantAttack)
         goal(Think);
-      else if(!isEscaping() && enemyLocation.enemyAhead && util::rand15() < 512)
+      else if(!isEscaping() && enemyLocation.enemyAhead && getWorld().getRandomStreams().ai.rand15() < 512)
         goal(Think, 6_as);
       else if(isBored())
         goal(Think);
@@ -27,7 +27,8 @@ void WaterfallMist::update()
   if(abs(d.X) > 20_sectors || abs(d.Y) > 20_sectors || abs(d.Z) > 20_sectors)
     return;
 
-  auto particle = gsl::make_shared<SplashParticle>(m_state.location, getWorld(), true);
+  auto particle = getWorld().getLevelArena().makeShared<SplashParticle>(
+    ArenaCategory::Particles, m_state.location, getWorld(), true);
   setParent(particle, m_state.location.room->node);
   getWorld().getObjectManager().registerParticle(particle);
 }
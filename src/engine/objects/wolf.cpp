@@ -58,7 +58,7 @@ void Wolf::update()
       pitch = 0_deg;
       if(isEscaping() || enemyLocation.canReachEnemyZone())
         goal(Walking, PrepareToStrike);
-      else if(util::rand15() < 32)
+      else if(getWorld().getRandomStreams().ai.rand15() < 32)
         goal(Walking, Running);
       break;
     case Walking.get():
@@ -71,7 +71,7 @@ void Wolf::update()
       getCreatureInfo()->maxTurnSpeed = 2_deg / 1_frame;
       if(!isBored())
         goal(Stalking, 0_as);
-      else if(util::rand15() < 32)
+      else if(getWorld().getRandomStreams().ai.rand15() < 32)
         goal(Walking, LyingDown);
       break;
     case PrepareToStrike.get():
@@ -111,7 +111,7 @@ void Wolf::update()
             goal(Jumping);
           }
         }
-        else if(util::rand15() >= 384)
+        else if(getWorld().getRandomStreams().ai.rand15() >= 384)
         {
           if(isBored())
             goal(PrepareToStrike);
@@ -175,7 +175,7 @@ void Wolf::update()
   }
   else if(m_state.current_anim_state != Dying)
   {
-    const auto r = util::rand15(3);
+    const auto r = getWorld().getRandomStreams().ai.rand15(3);
     getSkeleton()->setAnimation(m_state.current_anim_state,
                                 gsl::not_null{&getWorld().findAnimatedModelForType(m_state.type)->animations[20 + r]},
                                 0_frame);
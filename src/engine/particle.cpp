@@ -28,6 +28,8 @@
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
 #include <gl/renderstate.h>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
@@ -161,6 +163,8 @@ void Particle::applyTransform()
   m_lighting.update(m_shade.value_or(core::Shade{core::Shade::type{-1}}), *location.room);
 
   auto l = location.position.toRenderSystem();
+  if(m_previousPosition.has_value() && glm::distance(*m_previousPosition, l) < core::SectorSize.cast<float>().get())
+    l = glm::mix(*m_previousPosition, l, m_positionInterpolation);
   if(!m_withoutParent)
     l -= location.room->position.toRenderSystem();
 
@@ -239,13 +243,13 @@ SplashParticle::SplashParticle(const Location& location, world::World& world, co
 {
   if(!waterfall)
   {
-    speed = util::rand15(128_spd);
-    angle.Y = core::auToAngle(2 * util::rand15s());
+    speed = world.getRandomStreams().particles.rand15(128_spd);
+    angle.Y = core::auToAngle(2 * world.getRandomStreams().particles.rand15s());
   }
   else
   {
-    this->location.position.X += util::rand15s(1_sectors);
-    this->location.position.Z += util::rand15s(1_sectors);
+    this->location.position.X += world.getRandomStreams().particles.rand15s(1_sectors);
+    this->location.position.Z += world.getRandomStreams().particles.rand15s(1_sectors);
   }
   getRenderState().setScissorTest(false);
 }
@@ -260,9 +264,9 @@ BubbleParticle::BubbleParticle(const Location& location, world::World& world, bo
                instanced}
     , m_onlyInWater{onlyInWater}
 {
-  speed = 10_spd + util::rand15(6_spd);
+  speed = 10_spd + world.getRandomStreams().particles.rand15(6_spd);
 
-  const int n = util::rand15(3);
+  const int n = world.getRandomStreams().particles.rand15(3);
   for(int i = 0; i < n; ++i)
     nextFrame();
 }
@@ -297,9 +301,10 @@ FlameParticle::FlameParticle(const Location& location, world::World& world, bool
 
   if(randomize)
   {
-    timePerSpriteFrame
-      = -util::rand15(static_cast<int16_t>(world.getObjectManager().getLara().getSkeleton()->getBoneCount())) - 1;
-    for(auto n = util::rand15(getLength()); n != 0; --n)
+    timePerSpriteFrame = -world.getRandomStreams().particles.rand15(
+                           static_cast<int16_t>(world.getObjectManager().getLara().getSkeleton()->getBoneCount()))
+                         - 1;
+    for(auto n = world.getRandomStreams().particles.rand15(getLength()); n != 0; --n)
       nextFrame();
   }
 }
@@ -347,7 +352,8 @@ bool FlameParticle::update(world::World& world)
 
         if(!alreadyAttachedToLara)
         {
-          const auto particle = gsl::make_shared<FlameParticle>(location, world);
+          const auto particle = world.getLevelArena().makeShared<FlameParticle>(
+            ArenaCategory::Particles, location, world);
           particle->timePerSpriteFrame = -1;
           if(!withoutParent())
             setParent(particle, location.room->node);
@@ -430,7 +436,8 @@ bool MeshShrapnelParticle::update(world::World& world)
   if(!explode)
     return true;
 
-  const auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
+  const auto particle = world.getLevelArena().makeShared<ExplosionParticle>(
+    ArenaCategory::Particles, location, world, fall_speed, angle);
   if(!withoutParent())
     setParent(particle, location.room->node);
   world.getObjectManager().registerParticle(particle);
@@ -454,9 +461,9 @@ MeshShrapnelParticle::MeshShrapnelParticle(const Location& location,
 {
   clearMeshes();
 
-  angle.Y = core::Angle{util::rand15s() * 2};
-  speed = util::rand15(256_spd);
-  fall_speed = util::rand15(-256_spd);
+  angle.Y = core::Angle{world.getRandomStreams().particles.rand15s() * 2};
+  speed = world.getRandomStreams().particles.rand15(256_spd);
+  fall_speed = world.getRandomStreams().particles.rand15(-256_spd);
   if(!torsoBoss)
   {
     speed /= 2;
@@ -473,9 +480,9 @@ void MutantAmmoParticle::aimLaraChest(world::World& world)
 {
   const auto d = world.getObjectManager().getLara().m_state.location.position - location.position;
   const auto bbox = world.getObjectManager().getLara().getSkeleton()->getBoundingBox();
-  angle.X = util::rand15s(256_au)
+  angle.X = world.getRandomStreams().particles.rand15s(256_au)
             - angleFromAtan(bbox.y.max - bbox.y.size() * 3 / 4 + d.Y, sqrt(util::square(d.X) + util::square(d.Z)));
-  angle.Y = util::rand15s(256_au) + angleFromAtan(d.X, d.Z);
+  angle.Y = world.getRandomStreams().particles.rand15s(256_au) + angleFromAtan(d.X, d.Z);
 }
 
 bool MutantBulletParticle::update(world::World& world)
@@ -488,7 +495,7 @@ bool MutantBulletParticle::update(world::World& world)
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
-    auto particle = gsl::make_shared<RicochetParticle>(location, world);
+    auto particle = world.getLevelArena().makeShared<RicochetParticle>(ArenaCategory::Particles, location, world);
     particle->timePerSpriteFrame = 6;
     if(!withoutParent())
       setParent(particle, location.room->node);
@@ -500,7 +507,8 @@ bool MutantBulletParticle::update(world::World& world)
   {
     auto& laraState = world.getObjectManager().getLara().m_state;
     laraState.health -= 30_hp;
-    auto particle = gsl::make_shared<BloodSplatterParticle>(location, speed, angle.Y, world);
+    auto particle = world.getLevelArena().makeShared<BloodSplatterParticle>(
+      ArenaCategory::Particles, location, speed, angle.Y, world);
     if(!withoutParent())
       setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
@@ -527,7 +535,8 @@ bool MutantGrenadeParticle::update(world::World& world)
      || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
           >= location.position.Y)
   {
-    auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
+    auto particle = world.getLevelArena().makeShared<ExplosionParticle>(
+      ArenaCategory::Particles, location, world, fall_speed, angle);
     if(!withoutParent())
       setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
@@ -547,7 +556,8 @@ bool MutantGrenadeParticle::update(world::World& world)
   else if(world.getObjectManager().getLara().isNearInexact(location.position, 200_len))
   {
     world.getObjectManager().getLara().m_state.health -= 100_hp;
-    auto particle = gsl::make_shared<ExplosionParticle>(location, world, fall_speed, angle);
+    auto particle = world.getLevelArena().makeShared<ExplosionParticle>(
+      ArenaCategory::Particles, location, world, fall_speed, angle);
     if(!withoutParent())
       setParent(particle, location.room->node);
     world.getObjectManager().registerParticle(particle);
@@ -575,10 +585,10 @@ bool MutantGrenadeParticle::update(world::World& world)
 LavaParticle::LavaParticle(const Location& location, world::World& world)
     : Particle{"lava", TR1ItemId::LavaParticles, location, world, render::material::SpriteMaterialMode::Billboard}
 {
-  angle.Y = util::rand15(180_deg) * 2;
-  speed = util::rand15(32_spd);
-  fall_speed = -util::rand15(165_spd);
-  negSpriteFrameId = util::rand15(int16_t{-4});
+  angle.Y = world.getRandomStreams().particles.rand15(180_deg) * 2;
+  speed = world.getRandomStreams().particles.rand15(32_spd);
+  fall_speed = -world.getRandomStreams().particles.rand15(165_spd);
+  negSpriteFrameId = world.getRandomStreams().particles.rand15(int16_t{-4});
 }
 
 bool LavaParticle::update(world::World& world)
@@ -633,13 +643,13 @@ MuzzleFlashParticle::MuzzleFlashParticle(const Location& location, world::World&
   setShade(core::Shade{core::Shade::type{4096}});
 }
 
-bool MuzzleFlashParticle::update(world::World&)
+bool MuzzleFlashParticle::update(world::World& world)
 {
   --timePerSpriteFrame;
   if(timePerSpriteFrame == 0)
     return false;
 
-  angle.Z = util::rand15s(+180_deg);
+  angle.Z = world.getRandomStreams().particles.rand15s(+180_deg);
   applyTransform();
   return true;
 }
@@ -695,7 +705,7 @@ RicochetParticle::RicochetParticle(const Location& location, world::World& world
 {
   timePerSpriteFrame = 4;
 
-  const int n = util::rand15(3);
+  const int n = world.getRandomStreams().particles.rand15(3);
   for(int i = 0; i < n; ++i)
     nextFrame();
 }
@@ -713,7 +723,8 @@ gslu::nn_shared<Particle> createMuzzleFlash(world::World& world,
                                             const core::Speed& /*speed*/,
                                             const core::Angle& angle)
 {
-  auto particle = gsl::make_shared<MuzzleFlashParticle>(location, world, angle);
+  auto particle = world.getLevelArena().makeShared<MuzzleFlashParticle>(
+    ArenaCategory::Particles, location, world, angle);
   setParent(particle, location.room->node);
   return particle;
 }
@@ -723,7 +734,8 @@ gslu::nn_shared<Particle> createMutantBullet(world::World& world,
                                              const core::Speed& /*speed*/,
                                              const core::Angle& angle)
 {
-  auto particle = gsl::make_shared<MutantBulletParticle>(location, world, angle);
+  auto particle = world.getLevelArena().makeShared<MutantBulletParticle>(
+    ArenaCategory::Particles, location, world, angle);
   setParent(particle, location.room->node);
   return particle;
 }
@@ -733,7 +745,8 @@ gslu::nn_shared<Particle> createMutantGrenade(world::World& world,
                                               const core::Speed& /*speed*/,
                                               const core::Angle& angle)
 {
-  auto particle = gsl::make_shared<MutantGrenadeParticle>(location, world, angle);
+  auto particle = world.getLevelArena().makeShared<MutantGrenadeParticle>(
+    ArenaCategory::Particles, location, world, angle);
   setParent(particle, location.room->node);
   return particle;
 }
@@ -741,7 +754,8 @@ gslu::nn_shared<Particle> createMutantGrenade(world::World& world,
 gslu::nn_shared<Particle>
   createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle)
 {
-  auto particle = gsl::make_shared<BloodSplatterParticle>(location, speed, angle, world);
+  auto particle = world.getLevelArena().makeShared<BloodSplatterParticle>(
+    ArenaCategory::Particles, location, speed, angle, world);
   setParent(particle, location.room->node);
   return particle;
 }
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <deque>
 #include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
@@ -61,6 +62,8 @@ private:
   Lighting m_lighting;
   std::optional<core::Shade> m_shade{std::nullopt};
   const bool m_withoutParent;
+  std::optional<glm::vec3> m_previousPosition{std::nullopt};
+  float m_positionInterpolation = 1;
 
   void initRenderables(world::World& world, render::material::SpriteMaterialMode mode);
 
@@ -105,6 +108,18 @@ public:
 
   void applyTransform();
 
+  //! Records the current position as the one to interpolate from until the next tick.
+  void capturePreviousPosition()
+  {
+    m_previousPosition = location.position.toRenderSystem();
+  }
+
+  //! Sets the position between the previous and the current tick that is presented, in the range [0, 1].
+  void setPositionInterpolation(float alpha)
+  {
+    m_positionInterpolation = alpha;
+  }
+
   [[nodiscard]] bool withoutParent() const
   {
     return m_withoutParent;
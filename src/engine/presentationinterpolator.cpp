@@ -0,0 +1,183 @@
+#include "presentationinterpolator.h"
+
+#include "cameracontroller.h"
+#include "core/magic.h"
+#include "objectmanager.h"
+#include "objects/modelobject.h"
+#include "objects/object.h"
+#include "particle.h"
+#include "render/scene/camera.h"
+#include "render/scene/node.h"
+#include "skeletalmodelnode.h"
+#include "world/room.h"
+#include "world/world.h"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vector_relational.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+
+namespace engine
+{
+namespace
+{
+struct Decomposed
+{
+  glm::vec3 translation;
+  glm::quat rotation;
+  glm::vec3 scale;
+};
+
+std::optional<Decomposed> decompose(const glm::mat4& m)
+{
+  glm::mat3 rotation{m};
+  const glm::vec3 scale{glm::length(rotation[0]), glm::length(rotation[1]), glm::length(rotation[2])};
+  if(glm::any(glm::lessThanEqual(scale, glm::vec3{0.0f})))
+    return std::nullopt;
+
+  rotation[0] /= scale.x;
+  rotation[1] /= scale.y;
+  rotation[2] /= scale.z;
+  return Decomposed{glm::vec3{m[3]}, glm::quat_cast(rotation), scale};
+}
+
+//! Interpolates translation, rotation and scale of two affine transforms separately.
+std::optional<glm::mat4> interpolate(const glm::mat4& previous, const glm::mat4& current, float alpha)
+{
+  if(previous == current)
+    return std::nullopt;
+
+  const auto a = decompose(previous);
+  const auto b = decompose(current);
+  if(!a.has_value() || !b.has_value()
+     || glm::distance(a->translation, b->translation) > core::SectorSize.cast<float>().get())
+    return std::nullopt;
+
+  auto result = glm::mat4_cast(glm::slerp(a->rotation, b->rotation, alpha));
+  const auto scale = glm::mix(a->scale, b->scale, alpha);
+  result[0] *= scale.x;
+  result[1] *= scale.y;
+  result[2] *= scale.z;
+  result[3] = glm::vec4{glm::mix(a->translation, b->translation, alpha), 1.0f};
+  return result;
+}
+} // namespace
+
+void PresentationInterpolator::capture(const world::World& world)
+{
+  gsl_Expects(!m_applied);
+
+  m_nodes.clear();
+  m_skeletons.clear();
+  m_particles.clear();
+
+  const auto captureObject = [this](const objects::Object& object)
+  {
+    if(const auto node = object.getNode())
+      m_nodes.emplace_back(NodeState{node, node->getModelMatrix()});
+
+    if(const auto modelObject = dynamic_cast<const objects::ModelObject*>(&object))
+    {
+      if(const auto& skeleton = modelObject->getSkeleton())
+      {
+        skeleton->capturePreviousPose();
+        m_skeletons.emplace_back(skeleton);
+      }
+    }
+  };
+
+  const auto& objectManager = world.getObjectManager();
+  for(const auto& [id, object] : objectManager.getObjects())
+    captureObject(*object);
+  for(const auto& object : objectManager.getDynamicObjects())
+    captureObject(*object);
+
+  const auto captureParticle = [this](const gslu::nn_shared<Particle>& particle)
+  {
+    particle->capturePreviousPosition();
+    m_particles.emplace_back(particle.get());
+  };
+
+  for(const auto& particle : objectManager.getParticles())
+    captureParticle(particle);
+  for(const auto& room : world.getRooms())
+    for(const auto& particle : room.particles)
+      captureParticle(particle);
+
+  m_previousView = world.getCameraController().getCamera()->getViewMatrix();
+}
+
+void PresentationInterpolator::apply(const world::World& world, float alpha)
+{
+  gsl_Expects(!m_applied);
+  m_applied = true;
+
+  for(auto& state : m_nodes)
+  {
+    const auto node = state.node.lock();
+    if(node == nullptr)
+      continue;
+
+    state.localMatrix = node->getLocalMatrix();
+    const auto interpolated = interpolate(state.previous, node->getModelMatrix(), alpha);
+    if(!interpolated.has_value())
+      continue;
+
+    if(const auto parent = node->getParent().lock())
+      node->setLocalMatrix(glm::inverse(parent->getModelMatrix()) * *interpolated);
+    else
+      node->setLocalMatrix(*interpolated);
+  }
+
+  for(const auto& skeleton : m_skeletons)
+    if(const auto tmp = skeleton.lock())
+      tmp->setPoseInterpolation(alpha);
+
+  for(const auto& particle : m_particles)
+  {
+    if(const auto tmp = particle.lock())
+    {
+      tmp->setPositionInterpolation(alpha);
+      tmp->applyTransform();
+    }
+  }
+
+  const auto& camera = world.getCameraController().getCamera();
+  m_currentView = camera->getViewMatrix();
+  if(m_previousView.has_value())
+  {
+    // interpolate the camera's transform instead of its view matrix, so that it moves along a straight line
+    if(const auto interpolated = interpolate(glm::inverse(*m_previousView), glm::inverse(m_currentView), alpha))
+      camera->setViewMatrix(glm::inverse(*interpolated));
+  }
+}
+
+void PresentationInterpolator::restore(const world::World& world)
+{
+  gsl_Expects(m_applied);
+  m_applied = false;
+
+  for(const auto& state : m_nodes)
+    if(const auto node = state.node.lock())
+      node->setLocalMatrix(state.localMatrix);
+
+  for(const auto& skeleton : m_skeletons)
+    if(const auto tmp = skeleton.lock())
+      tmp->setPoseInterpolation(1);
+
+  for(const auto& particle : m_particles)
+  {
+    if(const auto tmp = particle.lock())
+    {
+      tmp->setPositionInterpolation(1);
+      tmp->applyTransform();
+    }
+  }
+
+  world.getCameraController().getCamera()->setViewMatrix(m_currentView);
+}
+} // namespace engine
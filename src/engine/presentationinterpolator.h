@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace render::scene
+{
+class Node;
+}
+
+namespace engine::world
+{
+class World;
+}
+
+namespace engine
+{
+class Particle;
+class SkeletalModelNode;
+
+/**
+ * Presents the world between its last two simulation ticks.
+ *
+ * Before each tick, the transforms of all objects, skeletal poses, particles and the camera are recorded. When
+ * rendering, they are moved to the state between the recorded and the current one, and moved back afterwards, so the
+ * simulation never sees an interpolated state. Anything that moved farther than a sector within a single tick is
+ * considered to have teleported, and is presented without interpolation.
+ */
+class PresentationInterpolator final
+{
+public:
+  //! Records the state to interpolate from; must be called before every simulation tick.
+  void capture(const world::World& world);
+
+  //! Moves everything to the state at @p alpha between the recorded state (0) and the current state (1).
+  void apply(const world::World& world, float alpha);
+
+  //! Restores the current state after rendering.
+  void restore(const world::World& world);
+
+private:
+  struct NodeState
+  {
+    std::weak_ptr<render::scene::Node> node;
+    glm::mat4 previous;
+    glm::mat4 localMatrix{1.0f};
+  };
+
+  std::vector<NodeState> m_nodes;
+  std::vector<std::weak_ptr<SkeletalModelNode>> m_skeletons;
+  std::vector<std::weak_ptr<Particle>> m_particles;
+  std::optional<glm::mat4> m_previousView;
+  glm::mat4 m_currentView{1.0f};
+  bool m_applied = false;
+};
+} // namespace engine
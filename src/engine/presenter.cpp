@@ -21,6 +21,7 @@
 #include "render/rendersettings.h"
 #include "render/scene/camera.h"
 #include "render/scene/csm.h"
+#include "render/scene/frustumculler.h"
 #include "render/scene/mesh.h"
 #include "render/scene/node.h"
 #include "render/scene/renderable.h"
@@ -28,13 +29,17 @@
 #include "render/scene/renderer.h"
 #include "render/scene/screenoverlay.h"
 #include "render/scene/visitor.h"
+#include "screencapture.h"
 #include "ui/text.h"
 #include "ui/ui.h"
+#include "ui/uirenderer.h"
 #include "util/helpers.h"
 #include "video/videoplayer.h"
 #include "world/room.h"
 
 #include <algorithm>
+#include <array>
+#include <boost/log/trivial.hpp>
 #include <cstdint>
 #include <cstdlib>
 #include <gl/cimgwrapper.h>
@@ -43,6 +48,7 @@
 #include <gl/framebuffer.h>
 #include <gl/glassert.h>
 #include <gl/glfw.h>
+#include <gl/glyphatlas.h>
 #include <gl/image.h>
 #include <gl/pixel.h>
 #include <gl/program.h>
@@ -64,6 +70,7 @@
 namespace
 {
 constexpr int StatusLineFontSize = 40;
+constexpr int GlyphAtlasSize = 1024;
 
 constexpr auto HealthChangeDuration = 1_sec * core::FrameRate;
 constexpr auto HealthChangeDeltaPerFrame = core::LaraHealth * 1_frame / HealthChangeDuration;
@@ -133,29 +140,68 @@ void Presenter::renderWorld(const std::vector<world::Room>& rooms,
     gl::RenderState::getWantedState().setDepthClamp(true);
     m_csm->updateCamera(*m_renderer->getCamera());
 
-    for(const auto& texture : m_csm->getDepthTextures())
-      texture->clear(gl::ScalarDepth{1.0f});
+    std::vector<const render::scene::Node*> staticCasters;
+    std::vector<const render::scene::Node*> dynamicCasters;
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
       SOGLB_DEBUGGROUP("csm-pass/" + std::to_string(i));
 
       m_csm->setActiveSplit(i);
-      m_csm->getActiveFramebuffer()->bind();
-      gl::RenderState::getWantedState() = m_csm->getActiveFramebuffer()->getRenderState();
 
-      render::scene::RenderContext context{render::material::RenderMode::CSMDepthOnly,
-                                           m_csm->getActiveMatrix(glm::mat4{1.0f})};
-      render::scene::Visitor visitor{context, false};
+      staticCasters.clear();
+      dynamicCasters.clear();
       for(const auto& room : rooms)
       {
-        if(!room.node->isVisible())
+        // rooms are extended by a sector, as their children may extend beyond their geometry
+        static const glm::vec3 RoomMargin{(1_sectors).cast<float>().get()};
+        if(!room.node->isVisible()
+           || !m_csm->intersectsActiveSplit(
+             room.node->getModelMatrix(), room.verticesBBoxMin - RoomMargin, room.verticesBBoxMax + RoomMargin))
           continue;
 
         for(const auto& child : room.node->getChildren())
         {
-          visitor.visit(*child);
+          if(!child->isVisible())
+            continue;
+
+          const auto isStatic = std::any_of(room.sceneryNodes.begin(),
+                                            room.sceneryNodes.end(),
+                                            [&child](const auto& sceneryNode)
+                                            {
+                                              return sceneryNode.get() == child.get();
+                                            });
+          (isStatic ? staticCasters : dynamicCasters).emplace_back(child.get());
         }
       }
+
+      const auto lightViewProjection = m_csm->getActiveMatrix(glm::mat4{1.0f});
+      render::scene::FrustumCuller culler{lightViewProjection};
+      for(const auto& caster : staticCasters)
+        culler.gather(*caster);
+      for(const auto& caster : dynamicCasters)
+        culler.gather(*caster);
+      culler.cull();
+
+      render::scene::RenderContext context{render::material::RenderMode::CSMDepthOnly, lightViewProjection};
+      if(m_csm->updateActiveStaticCasters(staticCasters))
+      {
+        SOGLB_DEBUGGROUP("csm-pass-static/" + std::to_string(i));
+        m_csm->getActiveStaticFramebuffer()->bind();
+        gl::RenderState::getWantedState() = m_csm->getActiveStaticFramebuffer()->getRenderState();
+
+        render::scene::Visitor visitor{context, false, &culler};
+        for(const auto& caster : staticCasters)
+          visitor.visit(*caster);
+        visitor.render(glm::vec3{0.0f, 0.0f, std::numeric_limits<float>::lowest()});
+      }
+
+      m_csm->restoreActiveStaticDepth();
+      m_csm->getActiveFramebuffer()->bind();
+      gl::RenderState::getWantedState() = m_csm->getActiveFramebuffer()->getRenderState();
+
+      render::scene::Visitor visitor{context, false, &culler};
+      for(const auto& caster : dynamicCasters)
+        visitor.visit(*caster);
       visitor.render(glm::vec3{0.0f, 0.0f, std::numeric_limits<float>::lowest()});
       m_csm->beginActiveDepthSync();
     }
@@ -433,16 +479,21 @@ Presenter::Presenter(const std::filesystem::path& engineDataPath, const glm::ive
     , m_splashImageTexture{gsl::make_shared<gl::TextureHandle<gl::Texture2D<gl::PremultipliedSRGBA8>>>(
         gl::CImgWrapper{util::ensureFileExists(engineDataPath / "splash.png")}.toTexture("splash"),
         gsl::make_unique<gl::Sampler>("splash-sampler"))}
-    , m_trTTFFont{std::make_unique<gl::Font>(util::ensureFileExists(engineDataPath / "trfont.ttf"))}
-    , m_debugFont{std::make_unique<gl::Font>(util::ensureFileExists(engineDataPath / "DroidSansMono.ttf"))}
+    , m_glyphAtlas{std::make_shared<gl::GlyphAtlas>(glm::ivec2{GlyphAtlasSize, GlyphAtlasSize})}
+    , m_trTTFFont{std::make_unique<gl::Font>(util::ensureFileExists(engineDataPath / "trfont.ttf"), m_glyphAtlas)}
+    , m_debugFont{
+        std::make_unique<gl::Font>(util::ensureFileExists(engineDataPath / "DroidSansMono.ttf"), m_glyphAtlas)}
     , m_inputHandler{std::make_unique<hid::InputHandler>(m_window, engineDataPath / "gamecontrollerdb.txt")}
     , m_shaderCache{std::make_shared<render::material::ShaderCache>(engineDataPath / "shaders")}
     , m_materialManager{std::make_unique<render::material::MaterialManager>(m_shaderCache, m_renderer)}
+    , m_uiRenderer{std::make_shared<ui::UiRenderer>(m_materialManager->getUi())}
+    , m_screenCapture{std::make_unique<ScreenCapture>()}
     , m_csm{std::make_shared<render::scene::CSM>(1024, *m_materialManager)}
     , m_renderPipeline{std::make_unique<render::RenderPipeline>(
         *m_materialManager, getRenderViewport(), getUiViewport(), getDisplayViewport())}
 {
   m_materialManager->setCSM(gsl::not_null{m_csm});
+  m_materialManager->setGlyphAtlas(m_glyphAtlas);
   scaleSplashImage();
   drawLoadingScreen(_("Booting"));
 }
@@ -452,7 +503,8 @@ Presenter::~Presenter() = default;
 void Presenter::scaleSplashImage()
 {
   // scale splash image so that its aspect ratio is preserved, but the boundaries match
-  const auto viewport = glm::vec2{getDisplayViewport()};
+  m_splashImageViewport = getDisplayViewport();
+  const auto viewport = glm::vec2{m_splashImageViewport};
   const auto srcTexture
     = m_splashImageTextureOverride != nullptr ? m_splashImageTextureOverride : m_splashImageTexture.get();
   const auto sourceSize = glm::vec2{srcTexture->getTexture()->size()};
@@ -479,21 +531,8 @@ void Presenter::drawLoadingScreen(const std::string& state)
   if(!preFrame())
     return;
 
-  if(m_screenOverlay == nullptr)
-    m_screenOverlay = std::make_unique<render::scene::ScreenOverlay>();
-
-  if(m_screenOverlay->getImage()->getSize() != getDisplayViewport())
-  {
-    m_screenOverlay->init(*m_materialManager, getDisplayViewport());
+  if(m_splashImageViewport != getDisplayViewport())
     scaleSplashImage();
-  }
-
-  m_screenOverlay->getImage()->fill(gl::PremultipliedSRGBA8{0, 0, 0, 0});
-  m_trTTFFont->drawText(*m_screenOverlay->getImage(),
-                        state.c_str(),
-                        glm::ivec2{40, m_screenOverlay->getImage()->getSize().y - 100},
-                        gl::PremultipliedSRGBA8{255, 255, 255, 255},
-                        StatusLineFontSize);
 
   m_renderPipeline->bindBackbuffer();
 
@@ -501,20 +540,29 @@ void Presenter::drawLoadingScreen(const std::string& state)
   render::scene::RenderContext context{render::material::RenderMode::Full, std::nullopt};
   getSplashImageMeshOrOverride()->getRenderState().setViewport(getDisplayViewport());
   getSplashImageMeshOrOverride()->render(nullptr, context);
-  m_screenOverlay->setAlphaMultiplier(0.8f);
-  m_screenOverlay->render(nullptr, context);
+
+  // there is no level palette while loading
+  std::array<gl::SRGBA8, 256> palette;
+  palette.fill(gl::SRGBA8{0, 0, 0, 0});
+  ui::Ui ui{m_uiRenderer, palette, getDisplayViewport()};
+  ui.drawText(*m_trTTFFont,
+              state,
+              glm::ivec2{40, getDisplayViewport().y - 100},
+              StatusLineFontSize,
+              gl::SRGBA8{255, 255, 255, 204});
+  ui.render();
   updateSoundEngine();
   swapBuffers();
 }
 
-bool Presenter::preFrame()
+bool Presenter::preFrame(bool pollInput)
 {
   m_window->updateWindowSize();
   if(m_window->isMinimized())
     return false;
 
-  m_renderer->getCamera()->setViewport(getRenderViewport());
-  m_renderPipeline->resize(*m_materialManager, getRenderViewport(), getUiViewport(), getDisplayViewport());
+  m_renderer->getCamera()->setViewport(getSceneViewport());
+  m_renderPipeline->resize(*m_materialManager, getSceneViewport(), getUiViewport(), getDisplayViewport());
   if(m_screenOverlay != nullptr)
   {
     if(m_screenOverlay->getImage()->getSize() != getDisplayViewport())
@@ -525,7 +573,8 @@ bool Presenter::preFrame()
     m_screenOverlay->getImage()->fill({0, 0, 0, 0});
   }
 
-  m_inputHandler->update();
+  if(pollInput)
+    m_inputHandler->update();
 
   m_renderer->clear(
     gl::api::ClearBufferMask::ColorBufferBit | gl::api::ClearBufferMask::DepthBufferBit, {0, 0, 0, 0}, 1);
@@ -550,11 +599,13 @@ void Presenter::swapBuffers()
 {
   m_renderPipeline->renderBackbufferEffects();
   m_window->swapBuffers();
+  m_screenCapture->update();
 }
 
 void Presenter::clear()
 {
   m_renderer->resetRootNode();
+  m_csm->invalidateStaticDepth();
   m_renderer->getCamera()->setFieldOfView(DefaultFov);
 }
 
@@ -568,8 +619,21 @@ void Presenter::apply(const render::RenderSettings& renderSettings, const AudioS
 {
   m_renderResolutionDivisor = renderSettings.renderResolutionDivisorActive ? renderSettings.renderResolutionDivisor : 1;
   m_uiScale = renderSettings.uiScaleActive ? renderSettings.uiScaleMultiplier : 1;
-  m_renderer->getCamera()->setViewport(getRenderViewport());
+  // switching to fullscreen may change the video mode, so the refresh rate is only known afterwards
   setFullscreen(renderSettings.fullscreen);
+  const auto minScale = static_cast<float>(renderSettings.adaptiveResolutionMinPercent) / 100.0f;
+  const auto budget = util::ResolutionController::getFrameBudget(m_window->getRefreshRate());
+  if(m_adaptiveResolution != renderSettings.adaptiveResolutionActive
+     || m_resolutionController.getConfig().minScale != minScale || m_resolutionController.getConfig().budget != budget)
+  {
+    m_adaptiveResolution = renderSettings.adaptiveResolutionActive;
+    auto config = m_resolutionController.getConfig();
+    config.minScale = minScale;
+    config.budget = budget;
+    m_resolutionController.configure(config);
+    BOOST_LOG_TRIVIAL(debug) << "Adaptive resolution frame budget is " << budget.count() << "us";
+  }
+  m_renderer->getCamera()->setViewport(getSceneViewport());
   if(m_csm->getResolution() != renderSettings.getCSMResolution())
   {
     m_csm = gsl::make_shared<render::scene::CSM>(renderSettings.getCSMResolution(), *m_materialManager);
@@ -584,20 +648,6 @@ void Presenter::apply(const render::RenderSettings& renderSettings, const AudioS
   m_renderSettingsChanged = true;
 }
 
-gl::CImgWrapper Presenter::takeScreenshot() const
-{
-  const auto vp = getDisplayViewport();
-
-  std::vector<uint8_t> pixels;
-  pixels.resize(gsl::narrow<size_t>(vp.x) * gsl::narrow<size_t>(vp.y) * 4u);
-  GL_ASSERT(
-    gl::api::readPixel(0, 0, vp.x, vp.y, gl::api::PixelFormat::Rgba, gl::api::PixelType::UnsignedByte, pixels.data()));
-
-  gl::CImgWrapper img{pixels.data(), vp.x, vp.y, false};
-  img.fromScreenshot();
-  return img;
-}
-
 void Presenter::renderScreenOverlay()
 {
   if(m_screenOverlay == nullptr)
@@ -635,6 +685,21 @@ glm::ivec2 Presenter::getRenderViewport() const
   return m_window->getViewport() / static_cast<int>(m_renderResolutionDivisor);
 }
 
+glm::ivec2 Presenter::getSceneViewport() const
+{
+  if(!m_adaptiveResolution)
+    return getRenderViewport();
+
+  const auto scaled = glm::vec2{getRenderViewport()} * m_resolutionController.getScale();
+  return glm::max(glm::ivec2{scaled}, glm::ivec2{1});
+}
+
+void Presenter::addFrameTime(const std::chrono::microseconds& frameTime)
+{
+  if(m_adaptiveResolution && m_resolutionController.update(frameTime))
+    BOOST_LOG_TRIVIAL(debug) << "Adaptive resolution scale changed to " << m_resolutionController.getScale();
+}
+
 glm::ivec2 Presenter::getUiViewport() const
 {
   BOOST_ASSERT(m_uiScale > 0);
@@ -3,10 +3,11 @@
 #include "core/magic.h"
 #include "core/units.h"
 #include "qs/quantity.h"
+#include "util/resolutioncontroller.h"
 
 #include <array>
+#include <chrono>
 #include <filesystem>
-#include <gl/cimgwrapper.h>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h> // IWYU pragma: keep
 #include <gl/window.h>
@@ -29,6 +30,7 @@ namespace ui
 {
 class TRFont;
 class Ui;
+class UiRenderer;
 } // namespace ui
 
 namespace hid
@@ -67,6 +69,7 @@ namespace engine
 {
 class ObjectManager;
 class CameraController;
+class ScreenCapture;
 struct AudioSettings;
 
 class Presenter final
@@ -102,6 +105,11 @@ public:
     return m_materialManager;
   }
 
+  [[nodiscard]] const auto& getUiRenderer() const
+  {
+    return m_uiRenderer;
+  }
+
   void initHealthBarTimeout()
   {
     m_healthBarTimeout = DefaultHealthBarTimeout;
@@ -141,7 +149,8 @@ public:
   void apply(const render::RenderSettings& renderSettings, const AudioSettings& audioSettings);
 
   void drawLoadingScreen(const std::string& state);
-  bool preFrame();
+  //! @param pollInput Whether to update the input state; the fixed-step game loop polls it right before each tick.
+  bool preFrame(bool pollInput = true);
   [[nodiscard]] bool shouldClose() const;
 
   void setTrFont(std::unique_ptr<ui::TRFont>&& font);
@@ -164,9 +173,18 @@ public:
 
   [[nodiscard]] glm::ivec2 getRenderViewport() const;
 
+  //! The size the world is rendered at, i.e. the render viewport scaled by the adaptive resolution.
+  [[nodiscard]] glm::ivec2 getSceneViewport() const;
+
+  //! Feeds the duration of a game frame to the adaptive resolution.
+  void addFrameTime(const std::chrono::microseconds& frameTime);
+
   [[nodiscard]] glm::ivec2 getUiViewport() const;
 
-  [[nodiscard]] gl::CImgWrapper takeScreenshot() const;
+  [[nodiscard]] auto& getScreenCapture()
+  {
+    return *m_screenCapture;
+  }
 
   void disableScreenOverlay();
 
@@ -186,6 +204,8 @@ private:
   const gslu::nn_shared<gl::Window> m_window;
   uint8_t m_renderResolutionDivisor = 1;
   uint8_t m_uiScale = 1;
+  bool m_adaptiveResolution = false;
+  util::ResolutionController m_resolutionController{util::ResolutionController::Config{}};
 
   std::shared_ptr<audio::SoundEngine> m_soundEngine;
   const gslu::nn_shared<render::scene::Renderer> m_renderer;
@@ -193,6 +213,8 @@ private:
   std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::PremultipliedSRGBA8>>> m_splashImageTextureOverride;
   std::shared_ptr<render::scene::Mesh> m_splashImageMesh;
   std::shared_ptr<render::scene::Mesh> m_splashImageMeshOverride{};
+  glm::ivec2 m_splashImageViewport{0, 0};
+  const gslu::nn_shared<gl::GlyphAtlas> m_glyphAtlas;
   const gslu::nn_unique<gl::Font> m_trTTFFont;
   const gslu::nn_unique<gl::Font> m_debugFont;
   core::Health m_drawnHealth = core::LaraHealth;
@@ -203,6 +225,8 @@ private:
 
   const gslu::nn_shared<render::material::ShaderCache> m_shaderCache;
   const gslu::nn_unique<render::material::MaterialManager> m_materialManager;
+  const gslu::nn_shared<ui::UiRenderer> m_uiRenderer;
+  const gslu::nn_unique<ScreenCapture> m_screenCapture;
   gslu::nn_shared<render::scene::CSM> m_csm;
 
   const gslu::nn_unique<render::RenderPipeline> m_renderPipeline;
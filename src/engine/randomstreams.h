@@ -0,0 +1,45 @@
+#pragma once
+
+#include "serialization/serialization_fwd.h"
+#include "util/random.h"
+
+#include <cstdint>
+
+namespace engine
+{
+/**
+ * The random number streams of a world.
+ *
+ * Each subsystem draws from its own stream, so that e.g. the number of particles spawned doesn't change the decisions
+ * of the AI. All streams are stored in savegames, which makes simulation runs reproducible.
+ */
+struct RandomStreams
+{
+  static constexpr uint64_t DefaultSeed = 0x7a7b1996u;
+
+  util::RandomStream particles;
+  util::RandomStream ai;
+  util::RandomStream audio;
+  //! Everything else affecting the simulation, e.g. traps, weapons and the camera.
+  util::RandomStream simulation;
+
+  explicit RandomStreams(uint64_t seed = DefaultSeed)
+  {
+    this->seed(seed);
+  }
+
+  void seed(uint64_t seed)
+  {
+    particles.seed(seed, 1);
+    ai.seed(seed, 2);
+    audio.seed(seed, 3);
+    simulation.seed(seed, 4);
+  }
+
+  template<typename TContext>
+  void serialize(const serialization::Serializer<TContext>& ser)
+  {
+    ser(S_NV("particles", particles), S_NV("ai", ai), S_NV("audio", audio), S_NV("simulation", simulation));
+  }
+};
+} // namespace engine
@@ -9,10 +9,12 @@
 #include "objectmanager.h"
 #include "qs/qs.h"
 #include "world/room.h"
+#include "world/world.h"
 
 #include <boost/assert.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <tuple>
+#include <vector>
 
 namespace engine::world
 {
@@ -23,12 +25,37 @@ namespace engine
 {
 namespace
 {
-bool clampY(const core::TRVec& start, Location& goal, const ObjectManager& objectManager)
+//! Queries the heights of sectors without caching.
+class DirectProbe final
+{
+public:
+  explicit DirectProbe(const ObjectManager& objectManager)
+      : m_objectManager{objectManager}
+  {
+  }
+
+  [[nodiscard]] core::Length getFloor(const Location& location, const gsl::not_null<const world::Sector*>& sector) const
+  {
+    return HeightInfo::fromFloor(sector, location.position, m_objectManager.getObjects()).y;
+  }
+
+  [[nodiscard]] core::Length getCeiling(const Location& location,
+                                        const gsl::not_null<const world::Sector*>& sector) const
+  {
+    return HeightInfo::fromCeiling(sector, location.position, m_objectManager.getObjects()).y;
+  }
+
+private:
+  const ObjectManager& m_objectManager;
+};
+
+template<typename TProbe>
+bool clampY(const core::TRVec& start, Location& goal, TProbe& probe)
 {
   const auto sector = goal.updateRoom();
   const auto delta = goal.position - start;
 
-  const auto goalFloor = HeightInfo::fromFloor(sector, goal.position, objectManager.getObjects()).y;
+  const auto goalFloor = probe.getFloor(goal, sector);
   if(goalFloor < goal.position.Y && goalFloor > start.Y)
   {
     goal.position.Y = goalFloor;
@@ -39,7 +66,7 @@ bool clampY(const core::TRVec& start, Location& goal, const ObjectManager& objec
     return false;
   }
 
-  const auto goalCeiling = HeightInfo::fromCeiling(sector, goal.position, objectManager.getObjects()).y;
+  const auto goalCeiling = probe.getCeiling(goal, sector);
   if(goalCeiling > goal.position.Y && goalCeiling < start.Y)
   {
     goal.position.Y = goalCeiling;
@@ -60,9 +87,10 @@ enum class CollisionType
   None      // resulting position is valid and needs no further adjustment
 };
 
+template<typename TProbe>
 std::pair<CollisionType, Location> clampSteps(const Location& start,
                                               const core::TRVec& goal,
-                                              const ObjectManager& objectManager,
+                                              TProbe& probe,
                                               core::Length(core::TRVec::*stepAxis),
                                               core::Length(core::TRVec::*secondaryAxis))
 {
@@ -88,11 +116,11 @@ std::pair<CollisionType, Location> clampSteps(const Location& start,
   result.position.*secondaryAxis += sectorStep.*secondaryAxis * deltaStep / sectorStep.*stepAxis;
   result.position.Y += sectorStep.Y * deltaStep / sectorStep.*stepAxis;
 
-  auto testVerticalHit = [&objectManager](Location& location)
+  auto testVerticalHit = [&probe](Location& location)
   {
     const auto sector = location.updateRoom();
-    const auto floor = HeightInfo::fromFloor(sector, location.position, objectManager.getObjects()).y;
-    const auto ceiling = HeightInfo::fromCeiling(sector, location.position, objectManager.getObjects()).y;
+    const auto floor = probe.getFloor(location, sector);
+    const auto ceiling = probe.getCeiling(location, sector);
     return location.position.Y > floor || location.position.Y < ceiling;
   };
 
@@ -125,24 +153,22 @@ std::pair<CollisionType, Location> clampSteps(const Location& start,
   }
 }
 
-} // namespace
-
-std::pair<bool, Location>
-  raycastLineOfSight(const Location& start, const core::TRVec& goal, const ObjectManager& objectManager)
+template<typename TProbe>
+std::pair<bool, Location> castRay(const Location& start, const core::TRVec& goal, TProbe& probe)
 {
-  auto collide = [&start, &goal, &objectManager](
+  auto collide = [&start, &goal, &probe](
                    core::Length(core::TRVec::*firstStepAxis),
                    core::Length(core::TRVec::*secondStepAxis)) -> std::tuple<CollisionType, CollisionType, Location>
   {
-    auto [firstType, firstPos] = clampSteps(start, goal, objectManager, firstStepAxis, secondStepAxis);
-    auto [secondType, secondPos] = clampSteps(start, firstPos.position, objectManager, secondStepAxis, firstStepAxis);
+    auto [firstType, firstPos] = clampSteps(start, goal, probe, firstStepAxis, secondStepAxis);
+    auto [secondType, secondPos] = clampSteps(start, firstPos.position, probe, secondStepAxis, firstStepAxis);
     BOOST_ASSERT(secondPos.room->getSectorByAbsolutePosition(secondPos.position) != nullptr);
     return {firstType, secondType, secondPos};
   };
 
-  auto [firstCollision, secondCollision, result] = abs(goal.Z - start.position.Z) <= abs(goal.X - start.position.X)
-                                                     ? collide(&core::TRVec::Z, &core::TRVec::X)
-                                                     : collide(&core::TRVec::X, &core::TRVec::Z);
+  const bool zFirst = abs(goal.Z - start.position.Z) <= abs(goal.X - start.position.X);
+  auto [firstCollision, secondCollision, result]
+    = zFirst ? collide(&core::TRVec::Z, &core::TRVec::X) : collide(&core::TRVec::X, &core::TRVec::Z);
   const auto invariantCheck = gsl::finally(
     [&result = result]()
     {
@@ -154,12 +180,125 @@ std::pair<bool, Location>
     return {false, result};
   }
 
-  bool success = clampY(start.position, result, objectManager) && firstCollision == CollisionType::None
+  const auto raycastResult = result;
+  bool success = clampY(start.position, result, probe) && firstCollision == CollisionType::None
                  && secondCollision == CollisionType::None;
   // redo raycasting to properly calculate the correct room, possibly fixes EE-432
-  result = abs(result.position.Z - start.position.Z) <= abs(result.position.X - start.position.X)
-             ? std::get<2>(collide(&core::TRVec::Z, &core::TRVec::X))
-             : std::get<2>(collide(&core::TRVec::X, &core::TRVec::Z));
+  if(zFirst == (abs(result.position.Z - start.position.Z) <= abs(result.position.X - start.position.X)))
+  {
+    // the raycast is towards the same goal along the same axes, so it would yield exactly the same result
+    result = raycastResult;
+  }
+  else
+  {
+    result = zFirst ? std::get<2>(collide(&core::TRVec::X, &core::TRVec::Z))
+                    : std::get<2>(collide(&core::TRVec::Z, &core::TRVec::X));
+  }
   return {success, result};
 }
+
+[[maybe_unused]] bool isSameResult(const std::pair<bool, Location>& a, const std::pair<bool, Location>& b)
+{
+  return a.first == b.first && a.second.room == b.second.room && a.second.position == b.second.position;
+}
+} // namespace
+
+std::pair<bool, Location>
+  raycastLineOfSight(const Location& start, const core::TRVec& goal, const ObjectManager& objectManager)
+{
+  DirectProbe probe{objectManager};
+  return castRay(start, goal, probe);
+}
+
+//! Queries the heights of sectors from the cache, if possible.
+class RaycastQueries::Probe final
+{
+public:
+  Probe(RaycastQueries& queries, const ObjectManager& objectManager)
+      : m_queries{queries}
+      , m_objectManager{objectManager}
+  {
+  }
+
+  [[nodiscard]] core::Length getFloor(const Location& location, const gsl::not_null<const world::Sector*>& sector)
+  {
+    if(const auto heights = m_queries.getSectorHeights(location, sector); heights != nullptr)
+      return heights->getFloor(location.position, m_objectManager.getObjects());
+    return HeightInfo::fromFloor(sector, location.position, m_objectManager.getObjects()).y;
+  }
+
+  [[nodiscard]] core::Length getCeiling(const Location& location, const gsl::not_null<const world::Sector*>& sector)
+  {
+    if(const auto heights = m_queries.getSectorHeights(location, sector); heights != nullptr)
+      return heights->getCeiling(location.position, m_objectManager.getObjects());
+    return HeightInfo::fromCeiling(sector, location.position, m_objectManager.getObjects()).y;
+  }
+
+private:
+  RaycastQueries& m_queries;
+  const ObjectManager& m_objectManager;
+};
+
+void RaycastQueries::beginFrame(const world::World& world)
+{
+  clear();
+  m_sectorsRevision = world.getSectorsRevision();
+}
+
+std::pair<bool, Location>
+  RaycastQueries::raycastLineOfSight(const world::World& world, const Location& start, const core::TRVec& goal)
+{
+  validate(world);
+  Probe probe{*this, world.getObjectManager()};
+  auto result = castRay(start, goal, probe);
+  // the cache must not change any result
+  BOOST_ASSERT(isSameResult(result, engine::raycastLineOfSight(start, goal, world.getObjectManager())));
+  return result;
+}
+
+std::vector<std::pair<bool, Location>> RaycastQueries::raycastLineOfSight(const world::World& world,
+                                                                          const gsl::span<const LineOfSightRay>& rays)
+{
+  validate(world);
+  Probe probe{*this, world.getObjectManager()};
+  std::vector<std::pair<bool, Location>> results;
+  results.reserve(rays.size());
+  for(const auto& ray : rays)
+  {
+    results.emplace_back(castRay(ray.start, ray.goal, probe));
+    BOOST_ASSERT(
+      isSameResult(results.back(), engine::raycastLineOfSight(ray.start, ray.goal, world.getObjectManager())));
+  }
+  return results;
+}
+
+void RaycastQueries::clear()
+{
+  m_sectors.clear();
+  m_sectorsRevision.reset();
+}
+
+void RaycastQueries::validate(const world::World& world)
+{
+  if(m_sectorsRevision == world.getSectorsRevision())
+    return;
+
+  m_sectors.clear();
+  m_sectorsRevision = world.getSectorsRevision();
+}
+
+SectorHeights* RaycastQueries::getSectorHeights(const Location& location,
+                                                const gsl::not_null<const world::Sector*>& sector)
+{
+  // boundary sectors are also used for positions outside of the room, but the sectors above and below them depend on
+  // the actual position then
+  const auto& room = *location.room;
+  const auto dx = sectorOf(location.position.X - room.position.X);
+  const auto dz = sectorOf(location.position.Z - room.position.Z);
+  if(dx < 0 || dx >= room.sectorCountX || dz < 0 || dz >= room.sectorCountZ
+     || &room.sectors[gsl::narrow_cast<size_t>(room.sectorCountZ * dx + dz)] != sector.get())
+    return nullptr;
+
+  return &m_sectors.try_emplace(sector.get(), sector, location.position).first->second;
+}
 } // namespace engine
@@ -1,14 +1,68 @@
 #pragma once
 
 #include "core/vec.h"
+#include "heightinfo.h"
+#include "location.h"
 
+#include <cstddef>
+#include <gsl/gsl-lite.hpp>
+#include <optional>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+namespace engine::world
+{
+class World;
+struct Sector;
+} // namespace engine::world
 
 namespace engine
 {
 class ObjectManager;
-struct Location;
 
 extern std::pair<bool, Location>
   raycastLineOfSight(const Location& start, const core::TRVec& goal, const ObjectManager& objectManager);
+
+struct LineOfSightRay
+{
+  Location start;
+  core::TRVec goal;
+};
+
+/**
+ * Casts line of sight rays with the same results as raycastLineOfSight(), sharing sector lookups between them.
+ *
+ * The rays of a frame mostly pass the same few sectors, e.g. the ones around Lara for all enemies aiming at her. Each
+ * ray still steps through its sectors on its own, but the sectors above and below a passed sector and its decoded
+ * floor data are kept until the next frame, or until sectors change (doors, blocks, flip maps). Heights are evaluated
+ * at the exact positions, and objects patching heights are queried for every ray.
+ */
+class RaycastQueries final
+{
+public:
+  //! Must be called before the queries of a frame.
+  void beginFrame(const world::World& world);
+
+  [[nodiscard]] std::pair<bool, Location>
+    raycastLineOfSight(const world::World& world, const Location& start, const core::TRVec& goal);
+
+  //! The results are in the same order as the rays.
+  [[nodiscard]] std::vector<std::pair<bool, Location>> raycastLineOfSight(const world::World& world,
+                                                                          const gsl::span<const LineOfSightRay>& rays);
+
+  void clear();
+
+private:
+  class Probe;
+
+  std::optional<size_t> m_sectorsRevision;
+  std::unordered_map<const world::Sector*, SectorHeights> m_sectors;
+
+  void validate(const world::World& world);
+
+  //! Returns the cached heights of @p sector, or @c nullptr if the position of @p location is outside of it.
+  [[nodiscard]] SectorHeights* getSectorHeights(const Location& location,
+                                                const gsl::not_null<const world::Sector*>& sector);
+};
 } // namespace engine
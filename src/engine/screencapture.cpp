@@ -0,0 +1,140 @@
+#include "screencapture.h"
+
+#include <boost/log/trivial.hpp>
+#include <exception>
+#include <gl/api/gl.hpp>
+#include <gl/cimgwrapper.h>
+#include <gl/glassert.h>
+#include <gsl/gsl-lite.hpp>
+#include <utility>
+
+namespace engine
+{
+ScreenCapture::ScreenCapture()
+{
+  m_workerThread = std::thread{&ScreenCapture::workerLoop, this};
+}
+
+ScreenCapture::~ScreenCapture()
+{
+  for(size_t i = 0; i < m_readbacks.size(); ++i)
+  {
+    auto& readback = m_readbacks.at((m_nextReadback + i) % m_readbacks.size());
+    if(readback.fence != nullptr)
+      finish(readback);
+  }
+
+  {
+    std::lock_guard lock{m_queueMutex};
+    m_shutdown = true;
+  }
+  m_queueCondition.notify_all();
+  m_workerThread.join();
+}
+
+void ScreenCapture::capture(const glm::ivec2& size, const std::filesystem::path& path, Continuation continuation)
+{
+  gsl_Expects(size.x > 0 && size.y > 0);
+
+  auto& readback = m_readbacks.at(m_nextReadback);
+  if(readback.fence != nullptr)
+  {
+    // both buffers are in use, so wait for the oldest readback
+    finish(readback);
+  }
+
+  const auto bufferSize = gsl::narrow<size_t>(size.x) * gsl::narrow<size_t>(size.y) * 4u;
+  if(readback.buffer == nullptr || readback.buffer->size() != bufferSize)
+  {
+    readback.buffer
+      = std::make_unique<gl::PixelPackBuffer<uint8_t>>("screen-capture", gl::api::BufferUsage::StreamRead, bufferSize);
+  }
+
+  readback.buffer->bind();
+  // with a bound pixel pack buffer, the data pointer is an offset into the buffer
+  GL_ASSERT(
+    gl::api::readPixel(0, 0, size.x, size.y, gl::api::PixelFormat::Rgba, gl::api::PixelType::UnsignedByte, nullptr));
+  readback.buffer->unbind();
+  readback.fence = std::make_unique<gl::FenceSync>();
+  readback.size = size;
+  readback.path = path;
+  readback.continuation = std::move(continuation);
+
+  m_nextReadback = (m_nextReadback + 1) % m_readbacks.size();
+}
+
+void ScreenCapture::update()
+{
+  // keep the order of the captures
+  for(size_t i = 0; i < m_readbacks.size(); ++i)
+  {
+    auto& readback = m_readbacks.at((m_nextReadback + i) % m_readbacks.size());
+    if(readback.fence == nullptr)
+      continue;
+    if(!readback.fence->isSignaled())
+      break;
+
+    finish(readback);
+  }
+}
+
+void ScreenCapture::finish(Readback& readback)
+{
+  gsl_Expects(readback.buffer != nullptr && readback.fence != nullptr);
+
+  readback.fence->clientWait();
+  readback.fence.reset();
+
+  Job job{readback.size, {}, std::move(readback.path), std::move(readback.continuation)};
+  {
+    const auto mapped = readback.buffer->map();
+    job.pixels.assign(mapped.begin(), mapped.end());
+  }
+  readback.path.clear();
+  readback.continuation = nullptr;
+
+  {
+    std::lock_guard lock{m_queueMutex};
+    m_queue.emplace_back(std::move(job));
+  }
+  m_queueCondition.notify_all();
+}
+
+void ScreenCapture::workerLoop()
+{
+  while(true)
+  {
+    Job job;
+    {
+      std::unique_lock lock{m_queueMutex};
+      m_queueCondition.wait(lock,
+                            [this]()
+                            {
+                              return m_shutdown || !m_queue.empty();
+                            });
+      if(m_queue.empty())
+        return;
+
+      job = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+
+    try
+    {
+      gl::CImgWrapper img{job.pixels.data(), job.size.x, job.size.y, false};
+      img.fromScreenshot();
+      if(job.path.has_parent_path())
+        std::filesystem::create_directories(job.path.parent_path());
+      img.savePng(job.path);
+      BOOST_LOG_TRIVIAL(info) << "Screenshot written to " << job.path;
+
+      if(job.continuation)
+        job.continuation();
+    }
+    catch(std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(error) << "Failed to write screenshot " << job.path << ": " << ex.what();
+    }
+  }
+}
+} // namespace engine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <gl/buffer.h>
+#include <gl/fencesync.h>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+/**
+ * Reads back the backbuffer asynchronously and writes it as a PNG file.
+ *
+ * The pixels are transferred into one of two pixel pack buffers, which are mapped only after the GPU has signaled
+ * that the transfer is complete. Encoding and file I/O is done by a background thread.
+ */
+class ScreenCapture final
+{
+public:
+  //! Called by the background thread after the image has been written.
+  using Continuation = std::function<void()>;
+
+  explicit ScreenCapture();
+  ~ScreenCapture();
+
+  ScreenCapture(const ScreenCapture&) = delete;
+  ScreenCapture(ScreenCapture&&) = delete;
+  ScreenCapture& operator=(const ScreenCapture&) = delete;
+  ScreenCapture& operator=(ScreenCapture&&) = delete;
+
+  void capture(const glm::ivec2& size, const std::filesystem::path& path, Continuation continuation = {});
+
+  //! Passes all completed readbacks to the background thread, must be called once per frame.
+  void update();
+
+private:
+  struct Readback
+  {
+    std::unique_ptr<gl::PixelPackBuffer<uint8_t>> buffer;
+    std::unique_ptr<gl::FenceSync> fence;
+    glm::ivec2 size{0, 0};
+    std::filesystem::path path;
+    Continuation continuation;
+  };
+
+  struct Job
+  {
+    glm::ivec2 size;
+    std::vector<uint8_t> pixels;
+    std::filesystem::path path;
+    Continuation continuation;
+  };
+
+  std::array<Readback, 2> m_readbacks;
+  //! The oldest pending readback, and the next one to be used.
+  size_t m_nextReadback = 0;
+
+  std::deque<Job> m_queue;
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  bool m_shutdown = false;
+  std::thread m_workerThread;
+
+  void finish(Readback& readback);
+  void workerLoop();
+};
+} // namespace engine
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "core/magic.h"
+#include "core/units.h"
+
+namespace engine::script
+{
+struct ObjectInfo
+{
+  bool ai_agent = false;
+  core::Length::type radius = 10;
+  core::Health::type hit_points = -16384;
+  core::Length::type pivot_length = 0;
+  int target_update_chance = 0;
+  core::Length::type step_limit = core::QuarterSectorSize.get();
+  core::Length::type drop_limit = -core::QuarterSectorSize.get();
+  core::Length::type fly_limit = 0;
+  bool cannot_visit_blocked = true;
+  bool cannot_visit_blockable = false;
+};
+} // namespace engine::script
@@ -75,8 +75,11 @@ std::unique_ptr<loader::file::level::Level>
   loadLevel(Engine& engine, const std::string& localPath, const std::string& title)
 {
   engine.getPresenter().drawLoadingScreen(_("Loading %1%", title));
-  auto level = loader::file::level::Level::createLoader(engine.getAssetDataPath() / localPath,
-                                                        loader::file::level::Game::Unknown);
+  const auto path = engine.getAssetDataPath() / localPath;
+  if(auto level = engine.getLevelPrefetcher().take(path))
+    return level;
+
+  auto level = loader::file::level::Level::createLoader(path, loader::file::level::Game::Unknown);
   level->loadFileData();
   return level;
 }
@@ -87,6 +90,7 @@ std::pair<RunResult, std::optional<size_t>> Video::run(Engine& engine,
                                                        const std::shared_ptr<Player>& /*levelStartPlayer*/)
 {
   engine.getPresenter().getSoundEngine()->reset();
+  engine.getLevelPrefetcher().start();
   for(const auto& path : m_paths)
   {
     if(auto asset = engine.getAssetDataPath() / path; std::filesystem::is_regular_file(asset))
@@ -323,6 +327,7 @@ std::pair<RunResult, std::optional<size_t>> SplashScreen::run(Engine& engine,
                                                               const std::shared_ptr<Player>& /*player*/,
                                                               const std::shared_ptr<Player>& /*levelStartPlayer*/)
 {
+  engine.getLevelPrefetcher().start();
   Throttler throttler{};
 
   glm::ivec2 size{-1, -1};
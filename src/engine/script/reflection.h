@@ -4,6 +4,7 @@
 #include "core/magic.h"
 #include "core/units.h"
 #include "engine/items_tr1.h"
+#include "engine/script/objectinfo.h"
 #include "engine/tracks_tr1.h"
 #include "qs/quantity.h"
 
@@ -36,20 +37,6 @@ class World;
 
 namespace engine::script
 {
-struct ObjectInfo
-{
-  bool ai_agent = false;
-  core::Length::type radius = 10;
-  core::Health::type hit_points = -16384;
-  core::Length::type pivot_length = 0;
-  int target_update_chance = 0;
-  core::Length::type step_limit = core::QuarterSectorSize.get();
-  core::Length::type drop_limit = -core::QuarterSectorSize.get();
-  core::Length::type fly_limit = 0;
-  bool cannot_visit_blocked = true;
-  bool cannot_visit_blockable = false;
-};
-
 struct TrackInfo
 {
   TrackInfo(const std::vector<std::string>& paths, size_t slot, bool looping, uint32_t fadeDurationSeconds)
@@ -87,6 +74,12 @@ public:
   [[nodiscard]] virtual bool isLevel(const std::filesystem::path& path) const = 0;
   [[nodiscard]] virtual std::vector<std::filesystem::path>
     getFilepathsIfInvalid(const std::filesystem::path& dataRoot) const = 0;
+
+  //! The level file loaded by this item, relative to the asset root, if any.
+  [[nodiscard]] virtual std::optional<std::filesystem::path> getLevelFilepath() const
+  {
+    return std::nullopt;
+  }
 };
 
 class Level : public LevelSequenceItem
@@ -148,6 +141,11 @@ public:
 
   [[nodiscard]] std::vector<std::filesystem::path>
     getFilepathsIfInvalid(const std::filesystem::path& dataRoot) const override;
+
+  [[nodiscard]] std::optional<std::filesystem::path> getLevelFilepath() const override
+  {
+    return std::filesystem::path{m_name};
+  }
 };
 
 class ModifyInventory : public LevelSequenceItem
@@ -278,6 +276,10 @@ public:
 
   [[nodiscard]] std::vector<std::filesystem::path>
     getFilepathsIfInvalid(const std::filesystem::path& dataRoot) const override;
+  [[nodiscard]] std::optional<std::filesystem::path> getLevelFilepath() const override
+  {
+    return std::filesystem::path{m_name};
+  }
 };
 
 class SplashScreen : public LevelSequenceItem
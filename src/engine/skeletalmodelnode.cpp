@@ -27,12 +27,12 @@
 #include "world/transition.h"
 #include "world/world.h"
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <exception>
 #include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/vec2.hpp>
-#include <initializer_list>
+#include <iterator>
 #include <stack>
 #include <utility>
 
@@ -239,6 +239,8 @@ void SkeletalModelNode::serialize(const serialization::Serializer<world::World>&
   if(ser.loading)
     ser << [this](const serialization::Serializer<world::World>&)
     {
+      // the resident mesh may have been built for a different shadow caster state or part count
+      m_residentMesh.reset();
       m_forceMeshRebuild = true;
       rebuildMesh();
       updatePose();
@@ -252,10 +254,12 @@ void serialize(std::shared_ptr<SkeletalModelNode>& data, const serialization::Se
     const world::SkeletalModelType* model = nullptr;
     bool shadowCaster;
     ser(S_NV("model", model), S_NV("shadowCaster", shadowCaster));
-    data = std::make_shared<SkeletalModelNode>(create(serialization::TypeId<std::string>{}, ser["id"]),
-                                               gsl::not_null{&ser.context},
-                                               gsl::not_null{model},
-                                               shadowCaster);
+    data = ser.context.getLevelArena().makeShared<SkeletalModelNode>(
+      ArenaCategory::SkeletalModels,
+      create(serialization::TypeId<std::string>{}, ser["id"]),
+      gsl::not_null{&ser.context},
+      gsl::not_null{model},
+      shadowCaster);
   }
   else
   {
@@ -296,58 +300,46 @@ void SkeletalModelNode::rebuildMesh()
 
   m_forceMeshRebuild = false;
 
-  world::RenderMeshDataCompositor compositor;
   for(auto& part : m_meshParts)
   {
-    if(part.mesh == nullptr || !part.visible)
-      compositor.appendEmpty();
-    else
-      compositor.append(*part.mesh, part.reflective);
-
     part.currentVisible = part.visible;
     part.currentMesh = part.mesh;
     part.currentReflective = part.reflective;
   }
 
-  if(compositor.empty())
-    setRenderable(nullptr);
-  else
-    setRenderable(compositor.toMesh(
-      *m_world->getPresenter().getMaterialManager(),
-      true,
-      m_shadowCaster,
-      [&engine = m_world->getEngine()]()
-      {
-        return engine.getEngineConfig()->animSmoothing;
-      },
-      [&engine = m_world->getEngine()]()
-      {
-        const auto& settings = engine.getEngineConfig()->renderSettings;
-        return !settings.lightingModeActive ? 0 : settings.lightingMode;
-      },
-      getName()));
+  if(m_residentMesh == nullptr || m_residentMesh->getPartCount() != m_meshParts.size())
+    m_residentMesh = std::make_shared<world::ResidentRenderMesh>(m_meshParts.size(), getName());
+
+  for(size_t i = 0; i < m_meshParts.size(); ++i)
+  {
+    const auto& part = m_meshParts[i];
+    m_residentMesh->setPart(i, part.visible ? part.mesh : nullptr, part.reflective);
+  }
+
+  setRenderable(m_residentMesh->update(
+    *m_world->getPresenter().getMaterialManager(),
+    m_shadowCaster,
+    [&engine = m_world->getEngine()]()
+    {
+      return engine.getEngineConfig()->animSmoothing;
+    },
+    [&engine = m_world->getEngine()]()
+    {
+      const auto& settings = engine.getEngineConfig()->renderSettings;
+      return !settings.lightingModeActive ? 0 : settings.lightingMode;
+    }));
 }
 
-bool SkeletalModelNode::canBeCulled(const glm::mat4& viewProjection) const
+std::optional<render::scene::BoundingSphere> SkeletalModelNode::getBoundingSphere() const
 {
+  // the first frame doesn't cover the whole animation, so the box is enlarged by half its size in each direction
   auto bbox = getInterpolationInfo().firstFrame->bbox.toBBox();
   bbox.x = bbox.x.broadened(bbox.x.size() / 2);
-  bbox.y = bbox.x.broadened(bbox.y.size() / 2);
-  bbox.z = bbox.x.broadened(bbox.z.size() / 2);
-
-  glm::vec2 min{1000.0f}, max{-1000.0f};
-  for(const auto& x : {bbox.x.min, bbox.x.max})
-    for(const auto& y : {bbox.y.min, bbox.y.max})
-      for(const auto& z : {bbox.z.min, bbox.z.max})
-      {
-        const auto v = core::TRVec{x, y, z}.toRenderSystem();
-        auto proj = viewProjection * getModelMatrix() * glm::vec4{v, 1.0f};
-        proj /= proj.w;
-        min = glm::min(min, glm::vec2{proj});
-        max = glm::max(max, glm::vec2{proj});
-      }
-
-  return min.x > 1 || min.y > 1 || max.x < -1 || max.y < -1;
+  bbox.y = bbox.y.broadened(bbox.y.size() / 2);
+  bbox.z = bbox.z.broadened(bbox.z.size() / 2);
+
+  return render::scene::BoundingSphere::fromCorners(core::TRVec{bbox.x.min, bbox.y.min, bbox.z.min}.toRenderSystem(),
+                                                    core::TRVec{bbox.x.max, bbox.y.max, bbox.z.max}.toRenderSystem());
 }
 
 void SkeletalModelNode::setAnim(const gsl::not_null<const world::Animation*>& anim,
@@ -369,25 +361,15 @@ void SkeletalModelNode::replaceAnim(const gsl::not_null<const world::Animation*>
 
 const gl::ShaderStorageBuffer<glm::mat4>& SkeletalModelNode::getMeshMatricesBuffer(std::function<bool()> smooth) const
 {
-  if(smooth())
-  {
-    for(auto& part : m_meshParts)
-    {
-      static constexpr float Smoothing = 0.2f;
-      if(!part.poseMatrixSmooth.has_value())
-        part.poseMatrixSmooth = part.poseMatrix;
-      else
-        part.poseMatrixSmooth = Smoothing * *part.poseMatrixSmooth + (1 - Smoothing) * part.poseMatrix;
-    }
-  }
-
   std::vector<glm::mat4> matrices;
   std::transform(m_meshParts.begin(),
                  m_meshParts.end(),
                  std::back_inserter(matrices),
-                 [smooth](const auto& part)
+                 [this, interpolate = smooth()](const auto& part) -> glm::mat4
                  {
-                   return smooth() ? *part.poseMatrixSmooth : part.poseMatrix;
+                   if(!interpolate || !part.previousPoseMatrix.has_value())
+                     return part.poseMatrix;
+                   return (1 - m_poseInterpolation) * *part.previousPoseMatrix + m_poseInterpolation * part.poseMatrix;
                  });
 
   if(m_meshMatricesBuffer == nullptr || m_meshMatricesBuffer->size() != matrices.size())
@@ -37,6 +37,7 @@ struct Animation;
 struct SkeletalModelType;
 class World;
 class RenderMeshData;
+class ResidentRenderMesh;
 } // namespace engine::world
 
 namespace engine::objects
@@ -133,7 +134,7 @@ public:
 
   void rebuildMesh();
 
-  [[nodiscard]] bool canBeCulled(const glm::mat4& viewProjection) const override;
+  [[nodiscard]] std::optional<render::scene::BoundingSphere> getBoundingSphere() const override;
 
   void setMeshPart(size_t idx, const std::shared_ptr<world::RenderMeshData>& mesh)
   {
@@ -191,6 +192,7 @@ public:
   void clearParts()
   {
     m_meshParts.clear();
+    m_residentMesh.reset();
     m_forceMeshRebuild = true;
     rebuildMesh();
   }
@@ -212,14 +214,30 @@ public:
     return m_anim;
   }
 
+  //! Drops the pose of the previous simulation tick, so that the current pose is presented without interpolation.
   void resetInterpolation()
   {
     for(auto& part : m_meshParts)
     {
-      part.poseMatrixSmooth.reset();
+      part.previousPoseMatrix.reset();
     }
   }
 
+  //! Records the current pose as the one to interpolate from until the next tick.
+  void capturePreviousPose()
+  {
+    for(auto& part : m_meshParts)
+    {
+      part.previousPoseMatrix = part.poseMatrix;
+    }
+  }
+
+  //! Sets the position between the previous and the current pose that is presented, in the range [0, 1].
+  void setPoseInterpolation(float alpha)
+  {
+    m_poseInterpolation = alpha;
+  }
+
 protected:
   bool handleStateTransitions(core::AnimStateId& animState, const core::AnimStateId& goal);
 
@@ -233,7 +251,7 @@ private:
 
     glm::mat4 patch{1.0f};
     glm::mat4 poseMatrix{1.0f};
-    mutable std::optional<glm::mat4> poseMatrixSmooth;
+    std::optional<glm::mat4> previousPoseMatrix;
     std::shared_ptr<world::RenderMeshData> mesh{nullptr};
     std::shared_ptr<world::RenderMeshData> currentMesh{nullptr};
     bool visible = true;
@@ -255,9 +273,13 @@ private:
   std::vector<MeshPart> m_meshParts{};
   mutable std::unique_ptr<gl::ShaderStorageBuffer<glm::mat4>> m_meshMatricesBuffer;
   bool m_forceMeshRebuild = false;
+  //! Keeps the composed mesh on the GPU, so that changing parts, e.g. when drawing or holstering weapons, doesn't
+  //! create new buffers.
+  std::shared_ptr<world::ResidentRenderMesh> m_residentMesh;
 
   const world::Animation* m_anim = nullptr;
   core::Frame m_frame = 0_frame;
+  float m_poseInterpolation = 1;
 
   void updatePose(const InterpolationInfo& framePair);
 
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "core/id.h"
+#include "engine/items_tr1.h"
+#include "engine/script/objectinfo.h"
+
+#include <boost/throw_exception.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace engine::world
+{
+/**
+ * A snapshot of the gameflow's object infos, taken when a level starts.
+ *
+ * The infos are queried by objects and the AI every frame, so they are copied into a table indexed by the object type
+ * instead of going through the script engine each time.
+ */
+class ObjectInfoTable final
+{
+public:
+  explicit ObjectInfoTable(const std::map<TR1ItemId, std::shared_ptr<script::ObjectInfo>>& objectInfos)
+  {
+    for(const auto& [type, objectInfo] : objectInfos)
+    {
+      const auto idx = static_cast<size_t>(type);
+      if(idx >= m_objectInfos.size())
+        m_objectInfos.resize(idx + 1);
+      m_objectInfos[idx] = *objectInfo;
+    }
+  }
+
+  [[nodiscard]] const script::ObjectInfo& at(const core::TypeId& type) const
+  {
+    const auto idx = static_cast<size_t>(type.get());
+    if(idx >= m_objectInfos.size() || !m_objectInfos[idx].has_value())
+      BOOST_THROW_EXCEPTION(
+        std::out_of_range(std::string{"no object info for type "} + toString(type.get_as<TR1ItemId>())));
+    return *m_objectInfos[idx];
+  }
+
+private:
+  std::vector<std::optional<script::ObjectInfo>> m_objectInfos;
+};
+} // namespace engine::world
@@ -18,215 +18,198 @@
 #include "render/material/shaderprogram.h"
 #include "render/scene/mesh.h"
 
+#include <algorithm>
 #include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
 #include <cstddef>
+#include <cstring>
+#include <functional>
 #include <gl/buffer.h>
 #include <gl/pixel.h>
+#include <gl/program.h>
 #include <gl/renderstate.h>
 #include <gl/vertexarray.h>
 #include <gl/vertexbuffer.h>
+#include <glm/geometric.hpp>
 #include <glm/vec2.hpp>
 #include <gslu.h>
 #include <initializer_list>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
-namespace gl
+namespace engine::world
 {
-class Program;
-}
+namespace
+{
+struct RenderVertexHash
+{
+  size_t operator()(const RenderMeshData::RenderVertex& vertex) const noexcept
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return std::hash<std::string_view>{}({reinterpret_cast<const char*>(&vertex), sizeof(vertex)});
+  }
+};
 
-namespace engine::world
+struct RenderVertexEqual
 {
+  bool operator()(const RenderMeshData::RenderVertex& a, const RenderMeshData::RenderVertex& b) const noexcept
+  {
+    return std::memcmp(&a, &b, sizeof(RenderMeshData::RenderVertex)) == 0;
+  }
+};
+} // namespace
+
 RenderMeshData::RenderMeshData(const loader::file::Mesh& mesh,
                                const std::vector<engine::world::AtlasTile>& atlasTiles,
                                const std::array<gl::SRGBA8, 256>& palette)
 {
+  static_assert(sizeof(RenderVertex) == 60, "RenderVertex must not contain padding, as vertices are compared bytewise");
+
+  std::unordered_map<RenderVertex, IndexType, RenderVertexHash, RenderVertexEqual> uniqueVertices;
+  const auto addVertex = [this, &uniqueVertices](const RenderVertex& vertex)
+  {
+    const auto [it, inserted] = uniqueVertices.emplace(vertex, gsl::narrow<IndexType>(m_vertices.size()));
+    if(inserted)
+      m_vertices.emplace_back(vertex);
+    m_indices.emplace_back(it->second);
+  };
+
+  const auto getNormal = [&mesh](const loader::file::VertexIndex& vertexIndex, const glm::vec3& faceNormal)
+  {
+    if(mesh.isFlatShaded() || mesh.normals.empty())
+      return toPackedNormal(faceNormal);
+
+    const auto& normal = vertexIndex.from(mesh.normals);
+    if(normal == core::TRVec{0_len, 0_len, 0_len})
+      return toPackedNormal(faceNormal);
+
+    return toPackedNormal(glm::normalize(normal.toRenderSystem()));
+  };
+
+  const auto generateFaceNormal = [&mesh](const auto& face, size_t i0, size_t i1, size_t i2)
+  {
+    return generateNormal(face.vertices[i0].from(mesh.vertices),
+                          face.vertices[i1].from(mesh.vertices),
+                          face.vertices[i2].from(mesh.vertices));
+  };
+
   for(const auto& quad : mesh.textured_rectangles)
   {
     const auto& tile = atlasTiles.at(quad.tileId.get());
 
-    const auto firstVertex = m_vertices.size();
+    const bool useQuadHandling = isDistortedQuad(quad.vertices[0].from(mesh.vertices).toRenderSystem(),
+                                                 quad.vertices[1].from(mesh.vertices).toRenderSystem(),
+                                                 quad.vertices[2].from(mesh.vertices).toRenderSystem(),
+                                                 quad.vertices[3].from(mesh.vertices).toRenderSystem());
+    glm::uint32 quadIndex = 0;
+    if(useQuadHandling)
+    {
+      for(const auto& v : quad.vertices)
+        m_quadVertices.emplace_back(v.from(mesh.vertices).toRenderSystem(), 1.0f);
+      quadIndex = gsl::narrow<glm::uint32>(m_quadVertices.size() / 4);
+    }
 
-    bool useQuadHandling = isDistortedQuad(quad.vertices[0].from(mesh.vertices).toRenderSystem(),
-                                           quad.vertices[1].from(mesh.vertices).toRenderSystem(),
-                                           quad.vertices[2].from(mesh.vertices).toRenderSystem(),
-                                           quad.vertices[3].from(mesh.vertices).toRenderSystem());
+    // the quad is rendered as the triangles 0-1-2 and 0-2-3
+    const std::array<glm::vec3, 2> faceNormals{generateFaceNormal(quad, 0, 1, 2), generateFaceNormal(quad, 0, 2, 3)};
 
-    for(int i = 0; i < 4; ++i)
+    std::array<RenderVertex, 4> vertices{};
+    for(size_t i = 0; i < 4; ++i)
     {
-      RenderVertex iv{};
+      auto& iv = vertices[i];
       if(useQuadHandling)
       {
-        iv.isQuad = 1;
-        iv.quadVert1 = quad.vertices[0].from(mesh.vertices).toRenderSystem();
-        iv.quadVert2 = quad.vertices[1].from(mesh.vertices).toRenderSystem();
-        iv.quadVert3 = quad.vertices[2].from(mesh.vertices).toRenderSystem();
-        iv.quadVert4 = quad.vertices[3].from(mesh.vertices).toRenderSystem();
-        iv.quadUv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
-        iv.quadUv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+        iv.quadIndex = quadIndex;
+        iv.quadUv12 = toPackedUv(tile.uvCoordinates[0], tile.uvCoordinates[1]);
+        iv.quadUv34 = toPackedUv(tile.uvCoordinates[2], tile.uvCoordinates[3]);
       }
 
       if(mesh.normals.empty())
         iv.color = glm::vec4(glm::vec3{toBrightness(quad.vertices[i].from(mesh.vertex_shades)).get()}, 1.0f);
 
-      if(mesh.isFlatShaded() || mesh.normals.empty()
-         || quad.vertices[i].from(mesh.normals) == core::TRVec{0_len, 0_len, 0_len})
-      {
-        if(i <= 2)
-        {
-          static const std::array<int, 3> indices{0, 1, 2};
-          iv.normal = engine::world::generateNormal(quad.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-        }
-        else
-        {
-          static const std::array<int, 3> indices{0, 2, 3};
-          iv.normal = engine::world::generateNormal(quad.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-        }
-      }
-      else
-      {
-        iv.normal = quad.vertices[i].from(mesh.normals).toRenderSystem();
-      }
-
-      iv.position = quad.vertices[i].from(mesh.vertices).toRenderSystem();
-      iv.uv = glm::vec3{tile.uvCoordinates[i], tile.textureKey.tileAndFlag & loader::file::TextureIndexMask};
-      m_vertices.emplace_back(iv);
+      iv.normal = getNormal(quad.vertices[i], faceNormals[i <= 2 ? 0 : 1]);
+      iv.position = toPackedPosition(quad.vertices[i].from(mesh.vertices).toRenderSystem());
+      iv.uv = toPackedUv(tile.uvCoordinates[i]);
+      iv.textureIndex = gsl::narrow<glm::int16>(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask);
     }
 
     for(size_t i : {0, 1, 2, 0, 2, 3})
-    {
-      // cppcheck-suppress useStlAlgorithm
-      m_indices.emplace_back(gsl::narrow<IndexType>(firstVertex + i));
-    }
+      addVertex(vertices[i]);
   }
   for(const auto& quad : mesh.colored_rectangles)
   {
     const auto color = glm::vec4{palette.at(quad.tileId.get() & 0xffu).channels} / 255.0f;
+    const std::array<glm::vec3, 2> faceNormals{generateFaceNormal(quad, 0, 1, 2), generateFaceNormal(quad, 0, 2, 3)};
 
-    const auto firstVertex = m_vertices.size();
-    for(int i = 0; i < 4; ++i)
+    std::array<RenderVertex, 4> vertices{};
+    for(size_t i = 0; i < 4; ++i)
     {
-      RenderVertex iv{};
-      iv.position = quad.vertices[i].from(mesh.vertices).toRenderSystem();
-      iv.uv = glm::vec3{0, 0, -1};
+      auto& iv = vertices[i];
+      iv.position = toPackedPosition(quad.vertices[i].from(mesh.vertices).toRenderSystem());
       iv.color = color;
       if(mesh.normals.empty())
         iv.color *= toBrightness(quad.vertices[i].from(mesh.vertex_shades)).get();
 
-      if(mesh.isFlatShaded() || mesh.normals.empty()
-         || quad.vertices[i].from(mesh.normals) == core::TRVec{0_len, 0_len, 0_len})
-      {
-        if(i <= 2)
-        {
-          static const std::array<int, 3> indices{0, 1, 2};
-          iv.normal = engine::world::generateNormal(quad.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-        }
-        else
-        {
-          static const std::array<int, 3> indices{0, 2, 3};
-          iv.normal = engine::world::generateNormal(quad.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                    quad.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-        }
-      }
-      else
-      {
-        iv.normal = quad.vertices[i].from(mesh.normals).toRenderSystem();
-      }
-      m_vertices.emplace_back(iv);
+      iv.normal = getNormal(quad.vertices[i], faceNormals[i <= 2 ? 0 : 1]);
     }
+
     for(size_t i : {0, 1, 2, 0, 2, 3})
-    {
-      // cppcheck-suppress useStlAlgorithm
-      m_indices.emplace_back(gsl::narrow<IndexType>(firstVertex + i));
-    }
+      addVertex(vertices[i]);
   }
 
   for(const auto& tri : mesh.textured_triangles)
   {
     const auto& tile = atlasTiles.at(tri.tileId.get());
+    const auto faceNormal = generateFaceNormal(tri, 0, 1, 2);
 
-    for(int i = 0; i < 3; ++i)
+    for(size_t i = 0; i < 3; ++i)
     {
       RenderVertex iv{};
-      iv.position = tri.vertices[i].from(mesh.vertices).toRenderSystem();
-      iv.uv = glm::vec3{tile.uvCoordinates[i], tile.textureKey.tileAndFlag & loader::file::TextureIndexMask};
+      iv.position = toPackedPosition(tri.vertices[i].from(mesh.vertices).toRenderSystem());
+      iv.uv = toPackedUv(tile.uvCoordinates[i]);
+      iv.textureIndex = gsl::narrow<glm::int16>(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask);
       if(mesh.normals.empty())
         iv.color = glm::vec4{glm::vec3{toBrightness(tri.vertices[i].from(mesh.vertex_shades)).get()}, 1.0f};
 
-      if(mesh.isFlatShaded() || mesh.normals.empty()
-         || tri.vertices[i].from(mesh.normals) == core::TRVec{0_len, 0_len, 0_len})
-      {
-        static const std::array<int, 3> indices{0, 1, 2};
-        iv.normal = engine::world::generateNormal(tri.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                  tri.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                  tri.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-      }
-      else
-      {
-        iv.normal = tri.vertices[i].from(mesh.normals).toRenderSystem();
-      }
-      m_indices.emplace_back(gsl::narrow<IndexType>(m_vertices.size()));
-      m_vertices.emplace_back(iv);
+      iv.normal = getNormal(tri.vertices[i], faceNormal);
+      addVertex(iv);
     }
   }
 
   for(const auto& tri : mesh.colored_triangles)
   {
     const auto color = glm::vec4{palette.at(tri.tileId.get() & 0xffu).channels} / 255.0f;
+    const auto faceNormal = generateFaceNormal(tri, 0, 1, 2);
 
-    for(int i = 0; i < 3; ++i)
+    for(size_t i = 0; i < 3; ++i)
     {
       RenderVertex iv{};
-      iv.position = tri.vertices[i].from(mesh.vertices).toRenderSystem();
-      iv.uv = glm::vec3{0, 0, -1};
+      iv.position = toPackedPosition(tri.vertices[i].from(mesh.vertices).toRenderSystem());
       iv.color = color;
       if(mesh.normals.empty())
         iv.color *= glm::vec4{glm::vec3{toBrightness(tri.vertices[i].from(mesh.vertex_shades)).get()}, 1.0f};
 
-      if(mesh.isFlatShaded() || mesh.normals.empty()
-         || tri.vertices[i].from(mesh.normals) == core::TRVec{0_len, 0_len, 0_len})
-      {
-        static const std::array<int, 3> indices{0, 1, 2};
-        iv.normal = engine::world::generateNormal(tri.vertices[indices[(i + 0) % 3]].from(mesh.vertices),
-                                                  tri.vertices[indices[(i + 1) % 3]].from(mesh.vertices),
-                                                  tri.vertices[indices[(i + 2) % 3]].from(mesh.vertices));
-      }
-      else
-      {
-        iv.normal = tri.vertices[i].from(mesh.normals).toRenderSystem();
-      }
-      m_indices.emplace_back(gsl::narrow<IndexType>(m_vertices.size()));
-      m_vertices.emplace_back(iv);
+      iv.normal = getNormal(tri.vertices[i], faceNormal);
+      addVertex(iv);
     }
   }
 }
 
-gslu::nn_shared<render::scene::Mesh>
-  RenderMeshDataCompositor::toMesh(render::material::MaterialManager& materialManager,
-                                   bool skeletal,
-                                   bool shadowCaster,
-                                   std::function<bool()> smooth,
-                                   std::function<int32_t()> lightingMode,
-                                   const std::string& label)
+namespace
+{
+gslu::nn_shared<render::scene::MeshImpl<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>
+  createMesh(render::material::MaterialManager& materialManager,
+             const gslu::nn_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>& indexBuffer,
+             const gslu::nn_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>& vb,
+             const std::shared_ptr<gl::ShaderStorageBuffer<glm::vec4>>& quadVertices,
+             bool skeletal,
+             bool shadowCaster,
+             std::function<bool()> smooth,
+             std::function<int32_t()> lightingMode,
+             const std::string& label)
 {
-  auto vb = gsl::make_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>(
-    RenderMeshData::RenderVertex::getLayout(), label, gl::api::BufferUsage::StaticDraw, m_vertices);
-
-#ifndef NDEBUG
-  for(auto idx : m_indices)
-  {
-    BOOST_ASSERT(idx < m_vertices.size());
-  }
-#endif
-  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>(
-    label, gl::api::BufferUsage::StaticDraw, m_indices);
-
   const auto material = materialManager.getGeometry(false, skeletal, false, smooth, lightingMode);
   const auto materialCSMDepthOnly = materialManager.getCSMDepthOnly(skeletal, smooth);
   const auto materialDepthOnly = materialManager.getDepthOnly(skeletal, smooth);
@@ -249,10 +232,278 @@ gslu::nn_shared<render::scene::Mesh>
     mesh->getMaterialGroup().set(render::material::RenderMode::CSMDepthOnly, materialCSMDepthOnly);
   }
 
+  if(quadVertices != nullptr)
+  {
+    mesh->bind("b_quadVertices",
+               [quadVertices](const render::scene::Node* /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::ShaderStorageBlock& shaderStorageBlock)
+               {
+                 shaderStorageBlock.bind(*quadVertices);
+               });
+  }
+
   mesh->getRenderState().setDepthTest(true);
   mesh->getRenderState().setDepthWrite(true);
   mesh->getRenderState().setDepthFunction(gl::api::DepthFunction::Less);
 
   return mesh;
 }
+} // namespace
+
+gslu::nn_shared<render::scene::Mesh>
+  RenderMeshDataCompositor::toMesh(render::material::MaterialManager& materialManager,
+                                   bool skeletal,
+                                   bool shadowCaster,
+                                   std::function<bool()> smooth,
+                                   std::function<int32_t()> lightingMode,
+                                   const std::string& label)
+{
+  auto vb = gsl::make_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>(
+    RenderMeshData::RenderVertex::getLayout(), label, gl::api::BufferUsage::StaticDraw, m_vertices);
+
+#ifndef NDEBUG
+  for(auto idx : m_indices)
+  {
+    BOOST_ASSERT(idx < m_vertices.size());
+  }
+#endif
+  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>(
+    label, gl::api::BufferUsage::StaticDraw, m_indices);
+
+  std::shared_ptr<gl::ShaderStorageBuffer<glm::vec4>> quadVertices;
+  if(!m_quadVertices.empty())
+  {
+    quadVertices = std::make_shared<gl::ShaderStorageBuffer<glm::vec4>>(
+      label + "-quads", gl::api::BufferUsage::StaticDraw, m_quadVertices);
+  }
+
+  return createMesh(materialManager,
+                    indexBuffer,
+                    vb,
+                    quadVertices,
+                    skeletal,
+                    shadowCaster,
+                    std::move(smooth),
+                    std::move(lightingMode),
+                    label);
+}
+
+ResidentRenderMesh::ResidentRenderMesh(const size_t partCount, std::string label)
+    : m_label{std::move(label)}
+    , m_parts(partCount)
+{
+}
+
+void ResidentRenderMesh::setPart(const size_t idx,
+                                 const std::shared_ptr<RenderMeshData>& data,
+                                 const gl::SRGBA8& reflective)
+{
+  auto& part = m_parts.at(idx);
+  if(part.data == data && (data == nullptr || part.reflective == reflective))
+    return;
+
+  part.data = data;
+  part.reflective = reflective;
+  part.dirty = true;
+}
+
+std::shared_ptr<render::scene::Mesh>
+  ResidentRenderMesh::update(render::material::MaterialManager& materialManager,
+                             const bool shadowCaster,
+                             const std::function<bool()>& smooth,
+                             const std::function<int32_t()>& lightingMode)
+{
+  const auto anyDirty = std::any_of(m_parts.begin(),
+                                    m_parts.end(),
+                                    [](const Part& part)
+                                    {
+                                      return part.dirty;
+                                    });
+  if(m_mesh != nullptr && shadowCaster == m_shadowCaster && !anyDirty)
+    return m_indices.empty() ? nullptr : m_mesh;
+
+  const auto fits = std::all_of(m_parts.begin(),
+                                m_parts.end(),
+                                [](const Part& part)
+                                {
+                                  return part.fits();
+                                });
+  if(m_mesh == nullptr || shadowCaster != m_shadowCaster || !fits || getIndexCount() > m_indexCapacity)
+  {
+    allocate(materialManager, shadowCaster, smooth, lightingMode);
+  }
+  else
+  {
+    for(size_t i = 0; i < m_parts.size(); ++i)
+    {
+      auto& part = m_parts[i];
+      if(!part.dirty)
+        continue;
+
+      part.dirty = false;
+      if(part.data == nullptr)
+        continue;
+
+      m_vertices.clear();
+      m_quadVertices.clear();
+      appendPart(i);
+      m_vb->setSubData(m_vertices, gsl::narrow<gl::api::core::SizeType>(part.vertexOffset));
+      if(!m_quadVertices.empty())
+        m_quadBuffer->setSubData(m_quadVertices, gsl::narrow<gl::api::core::SizeType>(4 * part.quadOffset));
+    }
+
+    buildIndices();
+    if(!m_indices.empty())
+      m_indexBuffer->setSubData(m_indices, 0);
+  }
+
+  if(m_mesh == nullptr || m_indices.empty())
+    return nullptr;
+
+  m_mesh->setIndexCount(gsl::narrow<gl::api::core::SizeType>(m_indices.size()));
+  return m_mesh;
+}
+
+size_t ResidentRenderMesh::getIndexCount() const
+{
+  size_t count = 0;
+  for(const auto& part : m_parts)
+  {
+    if(part.data != nullptr)
+      count += part.data->getIndices().size();
+  }
+  return count;
+}
+
+void ResidentRenderMesh::layout()
+{
+  const auto assign = [this](const size_t headroom)
+  {
+    size_t vertexOffset = 0;
+    size_t quadOffset = 0;
+    for(auto& part : m_parts)
+    {
+      const auto vertexCount = part.data == nullptr ? 0 : part.data->getVertices().size();
+      const auto quadCount = part.data == nullptr ? 0 : part.data->getQuadVertices().size() / 4;
+      part.vertexOffset = vertexOffset;
+      part.vertexCapacity = std::max(part.vertexCapacity, headroom * vertexCount);
+      part.quadOffset = quadOffset;
+      part.quadCapacity = std::max(part.quadCapacity, headroom * quadCount);
+      vertexOffset += part.vertexCapacity;
+      quadOffset += part.quadCapacity;
+    }
+    return vertexOffset;
+  };
+
+  // leave room for bigger meshes, e.g. the hands holding weapons, but stay addressable by the index type
+  static constexpr size_t MaxVertices = size_t{std::numeric_limits<RenderMeshData::IndexType>::max()} + 1;
+  if(assign(2) > MaxVertices)
+  {
+    for(auto& part : m_parts)
+    {
+      part.vertexCapacity = 0;
+      part.quadCapacity = 0;
+    }
+    assign(1);
+  }
+
+  m_indexCapacity = std::max(m_indexCapacity, 2 * getIndexCount());
+}
+
+void ResidentRenderMesh::allocate(render::material::MaterialManager& materialManager,
+                                  const bool shadowCaster,
+                                  const std::function<bool()>& smooth,
+                                  const std::function<int32_t()>& lightingMode)
+{
+  if(m_mesh != nullptr)
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Reallocating resident mesh " << m_label;
+  }
+
+  layout();
+
+  m_vertices.clear();
+  m_quadVertices.clear();
+  for(size_t i = 0; i < m_parts.size(); ++i)
+  {
+    auto& part = m_parts[i];
+    part.dirty = false;
+    m_vertices.resize(part.vertexOffset);
+    m_quadVertices.resize(4 * part.quadOffset);
+    appendPart(i);
+  }
+  if(!m_parts.empty())
+  {
+    m_vertices.resize(m_parts.back().vertexOffset + m_parts.back().vertexCapacity);
+    m_quadVertices.resize(4 * (m_parts.back().quadOffset + m_parts.back().quadCapacity));
+  }
+
+  buildIndices();
+  m_shadowCaster = shadowCaster;
+  if(m_vertices.empty() || m_indexCapacity == 0)
+  {
+    m_mesh.reset();
+    return;
+  }
+
+  auto indices = m_indices;
+  indices.resize(m_indexCapacity, 0);
+
+  m_vb = gsl::make_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>(
+    RenderMeshData::RenderVertex::getLayout(), m_label, gl::api::BufferUsage::DynamicDraw, m_vertices);
+  m_indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>(
+    m_label, gl::api::BufferUsage::DynamicDraw, indices);
+  m_quadBuffer.reset();
+  if(!m_quadVertices.empty())
+  {
+    m_quadBuffer = std::make_shared<gl::ShaderStorageBuffer<glm::vec4>>(
+      m_label + "-quads", gl::api::BufferUsage::DynamicDraw, m_quadVertices);
+  }
+
+  m_mesh = createMesh(materialManager,
+                      gsl::not_null{m_indexBuffer},
+                      gsl::not_null{m_vb},
+                      m_quadBuffer,
+                      true,
+                      shadowCaster,
+                      smooth,
+                      lightingMode,
+                      m_label);
+}
+
+void ResidentRenderMesh::appendPart(const size_t idx)
+{
+  const auto& part = m_parts.at(idx);
+  if(part.data == nullptr)
+    return;
+
+  const auto quadOffset = gsl::narrow<glm::uint32>(part.quadOffset);
+  for(auto v : part.data->getVertices())
+  {
+    v.boneIndex = gsl::narrow<glm::int16>(idx);
+    v.reflective = part.reflective.channels;
+    if(v.quadIndex != 0)
+      v.quadIndex += quadOffset;
+    m_vertices.emplace_back(v);
+  }
+  m_quadVertices.insert(
+    m_quadVertices.end(), part.data->getQuadVertices().begin(), part.data->getQuadVertices().end());
+}
+
+void ResidentRenderMesh::buildIndices()
+{
+  m_indices.clear();
+  for(const auto& part : m_parts)
+  {
+    if(part.data == nullptr)
+      continue;
+
+    for(auto i : part.data->getIndices())
+    {
+      // cppcheck-suppress useStlAlgorithm
+      m_indices.emplace_back(gsl::narrow<RenderMeshData::IndexType>(i + part.vertexOffset));
+    }
+  }
+}
 } // namespace engine::world
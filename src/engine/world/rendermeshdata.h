@@ -5,10 +5,16 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <functional>
 #include <gl/api/gl.hpp>
+#include <gl/buffer.h>
 #include <gl/pixel.h>
 #include <gl/vertexbuffer.h>
 #include <glm/ext/scalar_int_sized.hpp>
+#include <glm/ext/scalar_uint_sized.hpp>
+#include <glm/ext/vector_int4_sized.hpp>
+#include <glm/ext/vector_uint2_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
 #include <glm/fwd.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
@@ -26,6 +32,8 @@ class MaterialManager;
 namespace render::scene
 {
 class Mesh;
+template<typename IndexT, typename... VertexTs>
+class MeshImpl;
 } // namespace render::scene
 
 namespace loader::file
@@ -42,38 +50,34 @@ class RenderMeshData final
 public:
   using IndexType = uint16_t;
 
+  //! A compact vertex, the coordinates of distorted quads are stored separately in the quad vertices.
   struct RenderVertex
   {
-    glm::vec3 position;
-    glm::vec3 normal;
+    glm::i16vec4 position{0};
+    glm::i8vec4 normal{0};
     glm::vec4 color{1.0f};
-    glm::vec3 uv;
-    glm::int32 boneIndex{-1};
-    glm::int32 isQuad{0};
-    glm::vec3 quadVert1;
-    glm::vec3 quadVert2;
-    glm::vec3 quadVert3;
-    glm::vec3 quadVert4;
-    glm::vec4 quadUv12;
-    glm::vec4 quadUv34;
-    glm::vec4 reflective{0, 0, 0, 0};
+    glm::u16vec2 uv{0};
+    glm::int16 textureIndex{-1};
+    glm::int16 boneIndex{-1};
+    glm::u16vec4 quadUv12{0};
+    glm::u16vec4 quadUv34{0};
+    //! 1-based index of the distorted quad in the quad vertices, or 0 if this isn't part of a distorted quad.
+    glm::uint32 quadIndex{0};
+    glm::u8vec4 reflective{0};
 
     static const gl::VertexLayout<RenderVertex>& getLayout()
     {
       static const gl::VertexLayout<RenderVertex> layout{
         {VERTEX_ATTRIBUTE_POSITION_NAME, &RenderVertex::position},
-        {VERTEX_ATTRIBUTE_NORMAL_NAME, &RenderVertex::normal},
+        {VERTEX_ATTRIBUTE_NORMAL_NAME, {&RenderVertex::normal, true}},
         {VERTEX_ATTRIBUTE_COLOR_NAME, &RenderVertex::color},
-        {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, &RenderVertex::uv},
+        {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, {&RenderVertex::uv, true}},
+        {VERTEX_ATTRIBUTE_TEXTURE_INDEX_NAME, &RenderVertex::textureIndex},
         {VERTEX_ATTRIBUTE_BONE_INDEX_NAME, &RenderVertex::boneIndex},
-        {VERTEX_ATTRIBUTE_IS_QUAD, &RenderVertex::isQuad},
-        {VERTEX_ATTRIBUTE_QUAD_VERT1, &RenderVertex::quadVert1},
-        {VERTEX_ATTRIBUTE_QUAD_VERT2, &RenderVertex::quadVert2},
-        {VERTEX_ATTRIBUTE_QUAD_VERT3, &RenderVertex::quadVert3},
-        {VERTEX_ATTRIBUTE_QUAD_VERT4, &RenderVertex::quadVert4},
-        {VERTEX_ATTRIBUTE_QUAD_UV12, &RenderVertex::quadUv12},
-        {VERTEX_ATTRIBUTE_QUAD_UV34, &RenderVertex::quadUv34},
-        {VERTEX_ATTRIBUTE_REFLECTIVE_NAME, &RenderVertex::reflective},
+        {VERTEX_ATTRIBUTE_QUAD_INDEX, &RenderVertex::quadIndex},
+        {VERTEX_ATTRIBUTE_QUAD_UV12, {&RenderVertex::quadUv12, true}},
+        {VERTEX_ATTRIBUTE_QUAD_UV34, {&RenderVertex::quadUv34, true}},
+        {VERTEX_ATTRIBUTE_REFLECTIVE_NAME, {&RenderVertex::reflective, true}},
       };
 
       return layout;
@@ -94,9 +98,16 @@ public:
     return m_indices;
   }
 
+  [[nodiscard]] const auto& getQuadVertices() const
+  {
+    return m_quadVertices;
+  }
+
 private:
   std::vector<RenderVertex> m_vertices{};
   std::vector<IndexType> m_indices{};
+  //! The four corners of each distorted quad.
+  std::vector<glm::vec4> m_quadVertices{};
 };
 
 class RenderMeshDataCompositor final
@@ -105,12 +116,16 @@ public:
   void append(const RenderMeshData& data, const gl::SRGBA8& reflective)
   {
     const auto vertexOffset = gsl::narrow<RenderMeshData::IndexType>(m_vertices.size());
+    const auto quadOffset = gsl::narrow<glm::uint32>(m_quadVertices.size() / 4);
     for(auto v : data.getVertices())
     {
       v.boneIndex = m_boneIndex;
-      v.reflective = glm::vec4(reflective.channels) / 255.0f;
+      v.reflective = reflective.channels;
+      if(v.quadIndex != 0)
+        v.quadIndex += quadOffset;
       m_vertices.emplace_back(v);
     }
+    m_quadVertices.insert(m_quadVertices.end(), data.getQuadVertices().begin(), data.getQuadVertices().end());
 
     for(auto i : data.getIndices())
     {
@@ -141,6 +156,77 @@ public:
 private:
   std::vector<RenderMeshData::RenderVertex> m_vertices{};
   std::vector<RenderMeshData::IndexType> m_indices{};
-  glm::int32_t m_boneIndex = 0;
+  std::vector<glm::vec4> m_quadVertices{};
+  glm::int16 m_boneIndex = 0;
+};
+
+/**
+ * The composed mesh of a skeletal model, kept resident on the GPU while its parts change.
+ *
+ * Each part owns a fixed range of the vertex buffer with spare capacity. Replacing or hiding a part only uploads its
+ * vertices and the index list into the existing buffers, so e.g. drawing weapons doesn't create any GL objects. The
+ * buffers are only reallocated if a part outgrows its range.
+ */
+class ResidentRenderMesh final
+{
+public:
+  explicit ResidentRenderMesh(size_t partCount, std::string label);
+
+  [[nodiscard]] size_t getPartCount() const noexcept
+  {
+    return m_parts.size();
+  }
+
+  //! Sets the mesh of a part; a null mesh hides the part.
+  void setPart(size_t idx, const std::shared_ptr<RenderMeshData>& data, const gl::SRGBA8& reflective);
+
+  //! Uploads the changed parts, and returns the mesh, or nullptr if no part is visible.
+  [[nodiscard]] std::shared_ptr<render::scene::Mesh> update(render::material::MaterialManager& materialManager,
+                                                            bool shadowCaster,
+                                                            const std::function<bool()>& smooth,
+                                                            const std::function<int32_t()>& lightingMode);
+
+private:
+  struct Part
+  {
+    std::shared_ptr<RenderMeshData> data{nullptr};
+    gl::SRGBA8 reflective{0, 0, 0, 0};
+    size_t vertexOffset = 0;
+    size_t vertexCapacity = 0;
+    //! Offset and capacity in quads, i.e. four quad vertices each.
+    size_t quadOffset = 0;
+    size_t quadCapacity = 0;
+    bool dirty = true;
+
+    [[nodiscard]] bool fits() const
+    {
+      return data == nullptr
+             || (data->getVertices().size() <= vertexCapacity && data->getQuadVertices().size() / 4 <= quadCapacity);
+    }
+  };
+
+  const std::string m_label;
+  std::vector<Part> m_parts;
+  size_t m_indexCapacity = 0;
+  bool m_shadowCaster = false;
+
+  //! Scratch data for uploads, kept to avoid allocations.
+  std::vector<RenderMeshData::RenderVertex> m_vertices{};
+  std::vector<glm::vec4> m_quadVertices{};
+  std::vector<RenderMeshData::IndexType> m_indices{};
+
+  std::shared_ptr<gl::VertexBuffer<RenderMeshData::RenderVertex>> m_vb;
+  std::shared_ptr<gl::ElementArrayBuffer<RenderMeshData::IndexType>> m_indexBuffer;
+  std::shared_ptr<gl::ShaderStorageBuffer<glm::vec4>> m_quadBuffer;
+  std::shared_ptr<render::scene::MeshImpl<RenderMeshData::IndexType, RenderMeshData::RenderVertex>> m_mesh;
+
+  [[nodiscard]] size_t getIndexCount() const;
+  void layout();
+  void allocate(render::material::MaterialManager& materialManager,
+                bool shadowCaster,
+                const std::function<bool()>& smooth,
+                const std::function<int32_t()>& lightingMode);
+  void appendPart(size_t idx);
+  void buildIndices();
 };
 } // namespace engine::world
@@ -5,7 +5,6 @@
 #include "core/angle.h"
 #include "core/containeroffset.h"
 #include "core/genericvec.h"
-#include "core/i18n.h"
 #include "core/id.h"
 #include "engine/engine.h"
 #include "engine/engineconfig.h"
@@ -14,7 +13,6 @@
 #include "engine/objects/laraobject.h"
 #include "engine/objects/object.h"
 #include "engine/objects/objectstate.h"
-#include "engine/presenter.h"
 #include "loader/file/datatypes.h"
 #include "loader/file/primitives.h"
 #include "loader/file/texture.h"
@@ -28,6 +26,7 @@
 #include "render/scene/names.h"
 #include "render/scene/node.h"
 #include "render/textureanimator.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/serialization.h"
 #include "serialization/vector.h"
@@ -37,6 +36,8 @@
 #include "util.h"
 #include "world.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
 #include <cstdint>
@@ -47,6 +48,8 @@
 #include <gl/vertexarray.h>
 #include <gl/vertexbuffer.h>
 #include <glm/common.hpp>
+#include <glm/ext/scalar_uint_sized.hpp>
+#include <glm/ext/vector_int4_sized.hpp>
 #include <glm/geometric.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/mat4x4.hpp>
@@ -58,7 +61,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <limits>
-#include <set>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -67,73 +70,39 @@ namespace engine::world
 {
 namespace
 {
-#pragma pack(push, 1)
-
-struct RenderVertex
-{
-  glm::vec3 position{};
-  glm::vec4 color{1.0f};
-  glm::vec3 normal{0.0f};
-  glm::int32 isQuad{0};
-  glm::vec3 quadVert1{};
-  glm::vec3 quadVert2{};
-  glm::vec3 quadVert3{};
-  glm::vec3 quadVert4{};
-  glm::vec4 reflective{};
-
-  static const gl::VertexLayout<RenderVertex>& getLayout()
-  {
-    static const gl::VertexLayout<RenderVertex> layout{
-      {VERTEX_ATTRIBUTE_POSITION_NAME, &RenderVertex::position},
-      {VERTEX_ATTRIBUTE_NORMAL_NAME, &RenderVertex::normal},
-      {VERTEX_ATTRIBUTE_COLOR_NAME, &RenderVertex::color},
-      {VERTEX_ATTRIBUTE_IS_QUAD, &RenderVertex::isQuad},
-      {VERTEX_ATTRIBUTE_QUAD_VERT1, &RenderVertex::quadVert1},
-      {VERTEX_ATTRIBUTE_QUAD_VERT2, &RenderVertex::quadVert2},
-      {VERTEX_ATTRIBUTE_QUAD_VERT3, &RenderVertex::quadVert3},
-      {VERTEX_ATTRIBUTE_QUAD_VERT4, &RenderVertex::quadVert4},
-      {VERTEX_ATTRIBUTE_REFLECTIVE_NAME, &RenderVertex::reflective},
-    };
-
-    return layout;
-  }
-};
-
-#pragma pack(pop)
-
 struct RenderMesh
 {
-  using IndexType = uint16_t;
-  std::vector<IndexType> m_indices;
   std::shared_ptr<render::material::Material> m_materialFull;
   std::shared_ptr<render::material::Material> m_materialCSMDepthOnly;
   std::shared_ptr<render::material::Material> m_materialDepthOnly;
 
-  std::shared_ptr<render::scene::Mesh> toMesh(const gslu::nn_shared<gl::VertexBuffer<RenderVertex>>& vbuf,
+  std::shared_ptr<render::scene::Mesh> toMesh(const std::vector<RoomGeometry::IndexType>& indices,
+                                              const gslu::nn_shared<gl::VertexBuffer<RoomRenderVertex>>& vbuf,
                                               const gslu::nn_shared<gl::VertexBuffer<render::AnimatedUV>>& uvBuf,
                                               const std::string& label)
   {
 #ifndef NDEBUG
-    for(auto idx : m_indices)
+    for(auto idx : indices)
     {
       BOOST_ASSERT(idx < vbuf->size());
     }
 #endif
 
-    auto indexBuffer
-      = gsl::make_shared<gl::ElementArrayBuffer<IndexType>>(label, gl::api::BufferUsage::StaticDraw, m_indices);
+    auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<RoomGeometry::IndexType>>(
+      label, gl::api::BufferUsage::StaticDraw, indices);
 
     auto vBufs = std::make_tuple(vbuf, uvBuf);
 
-    auto mesh = std::make_shared<render::scene::MeshImpl<IndexType, RenderVertex, render::AnimatedUV>>(
-      gsl::make_shared<gl::VertexArray<IndexType, RenderVertex, render::AnimatedUV>>(
-        indexBuffer,
-        vBufs,
-        std::vector{&m_materialFull->getShaderProgram()->getHandle(),
-                    m_materialDepthOnly == nullptr ? nullptr : &m_materialDepthOnly->getShaderProgram()->getHandle(),
-                    m_materialCSMDepthOnly == nullptr ? nullptr
-                                                      : &m_materialCSMDepthOnly->getShaderProgram()->getHandle()},
-        label));
+    auto mesh
+      = std::make_shared<render::scene::MeshImpl<RoomGeometry::IndexType, RoomRenderVertex, render::AnimatedUV>>(
+        gsl::make_shared<gl::VertexArray<RoomGeometry::IndexType, RoomRenderVertex, render::AnimatedUV>>(
+          indexBuffer,
+          vBufs,
+          std::vector{&m_materialFull->getShaderProgram()->getHandle(),
+                      m_materialDepthOnly == nullptr ? nullptr : &m_materialDepthOnly->getShaderProgram()->getHandle(),
+                      m_materialCSMDepthOnly == nullptr ? nullptr
+                                                        : &m_materialCSMDepthOnly->getShaderProgram()->getHandle()},
+          label));
     mesh->getMaterialGroup()
       .set(render::material::RenderMode::Full, m_materialFull)
       .set(render::material::RenderMode::CSMDepthOnly, m_materialCSMDepthOnly)
@@ -143,6 +112,11 @@ struct RenderMesh
   }
 };
 
+glm::uint32 toAnimatedTile(const std::optional<glm::uint32>& slot, size_t corner)
+{
+  return slot.has_value() ? gsl::narrow<glm::uint32>(1 + *slot * 4 + corner) : 0;
+}
+
 template<size_t N>
 core::TRVec getCenter(const std::array<loader::file::VertexIndex, N>& faceVertices,
                       const std::vector<loader::file::RoomVertex>& roomVertices)
@@ -189,37 +163,14 @@ void Portal::buildMesh(const loader::file::Portal& srcPortal,
   mesh->getMaterialGroup().set(render::material::RenderMode::DepthOnly, material);
 }
 
-void Room::createSceneNode(const loader::file::Room& srcRoom,
-                           const size_t roomId,
-                           World& world,
-                           const std::vector<uint16_t>& textureAnimData,
-                           render::material::MaterialManager& materialManager)
+RoomGeometry Room::buildGeometry(const loader::file::Room& srcRoom,
+                                 const std::vector<AtlasTile>& atlasTiles,
+                                 const render::TextureAnimator& textureAnimator)
 {
-  RenderMesh renderMesh;
-  renderMesh.m_materialDepthOnly = materialManager.getDepthOnly(false,
-                                                                []()
-                                                                {
-                                                                  return false;
-                                                                });
-  renderMesh.m_materialCSMDepthOnly = nullptr;
-  renderMesh.m_materialFull = materialManager.getGeometry(
-    isWaterRoom,
-    false,
-    true,
-    []()
-    {
-      return false;
-    },
-    [&world]()
-    {
-      const auto& settings = world.getEngine().getEngineConfig()->renderSettings;
-      return !settings.lightingModeActive ? 0 : settings.lightingMode;
-    });
-
-  std::vector<RenderVertex> vbufData;
-  std::vector<render::AnimatedUV> uvCoordsData;
-
-  textureAnimator = std::make_unique<render::TextureAnimator>(textureAnimData);
+  RoomGeometry geometry;
+  geometry.vertices.reserve(srcRoom.rectangles.size() * 4 + srcRoom.triangles.size() * 3);
+  geometry.uvCoords.reserve(geometry.vertices.capacity());
+  geometry.indices.reserve(srcRoom.rectangles.size() * 6 + srcRoom.triangles.size() * 3);
 
   for(const loader::file::QuadFace& quad : srcRoom.rectangles)
   {
@@ -247,58 +198,50 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
       }
     }
 
-    const auto& tile = world.getAtlasTiles().at(quad.tileId.get());
+    const auto& tile = atlasTiles.at(quad.tileId.get());
+    const auto animatedSlot = textureAnimator.getSlot(quad.tileId);
 
-    bool useQuadHandling = isDistortedQuad(quad.vertices[0].from(srcRoom.vertices).position.toRenderSystem(),
-                                           quad.vertices[1].from(srcRoom.vertices).position.toRenderSystem(),
-                                           quad.vertices[2].from(srcRoom.vertices).position.toRenderSystem(),
-                                           quad.vertices[3].from(srcRoom.vertices).position.toRenderSystem());
+    std::array<glm::vec3, 4> positions{};
+    for(size_t i = 0; i < 4; ++i)
+      positions[i] = quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
 
-    const auto firstVertex = vbufData.size();
-    for(int i = 0; i < 4; ++i)
+    glm::uint32 quadIndex = 0;
+    if(isDistortedQuad(positions[0], positions[1], positions[2], positions[3]))
     {
-      RenderVertex iv;
-      iv.position = quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
-      iv.color = quad.vertices[i].from(srcRoom.vertices).color;
-
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
-      if(useQuadHandling)
-      {
-        iv.isQuad = 1;
-        iv.quadVert1 = quad.vertices[0].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert2 = quad.vertices[1].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert3 = quad.vertices[2].from(srcRoom.vertices).position.toRenderSystem();
-        iv.quadVert4 = quad.vertices[3].from(srcRoom.vertices).position.toRenderSystem();
-      }
+      for(const auto& pos : positions)
+        geometry.quadVertices.emplace_back(pos, 1.0f);
+      quadIndex = gsl::narrow<glm::uint32>(geometry.quadVertices.size() / 4);
+    }
 
-      if(i <= 2)
-      {
-        static const std::array<int, 3> indices{0, 1, 2};
-        iv.normal = generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
-      }
-      else
-      {
-        static const std::array<int, 3> indices{0, 2, 3};
-        iv.normal = generateNormal(quad.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                   quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
-      }
+    const std::array<glm::i8vec4, 2> normals{
+      toPackedNormal(generateNormal(quad.vertices[0].from(srcRoom.vertices).position,
+                                    quad.vertices[1].from(srcRoom.vertices).position,
+                                    quad.vertices[2].from(srcRoom.vertices).position)),
+      toPackedNormal(generateNormal(quad.vertices[0].from(srcRoom.vertices).position,
+                                    quad.vertices[2].from(srcRoom.vertices).position,
+                                    quad.vertices[3].from(srcRoom.vertices).position)),
+    };
 
-      vbufData.emplace_back(iv);
+    const auto firstVertex = geometry.vertices.size();
+    for(size_t i = 0; i < 4; ++i)
+    {
+      RoomRenderVertex iv;
+      iv.position = toPackedPosition(positions[i]);
+      iv.color = quad.vertices[i].from(srcRoom.vertices).color;
+      iv.normal = normals[i <= 2 ? 0 : 1];
+      iv.quadIndex = quadIndex;
+      geometry.vertices.emplace_back(iv);
+
+      geometry.uvCoords.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
+                                     tile.uvCoordinates[i],
+                                     glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
+                                     glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]},
+                                     toAnimatedTile(animatedSlot, i));
     }
 
     for(int i : {0, 1, 2, 0, 2, 3})
     {
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
-    }
-    for(int i : {0, 1, 2, 3})
-    {
-      textureAnimator->registerVertex(quad.tileId, i, firstVertex + i);
+      geometry.indices.emplace_back(gsl::narrow<RoomGeometry::IndexType>(firstVertex + i));
     }
   }
   for(const loader::file::Triangle& tri : srcRoom.triangles)
@@ -319,54 +262,110 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
       }
     }
 
-    const auto& tile = world.getAtlasTiles().at(tri.tileId.get());
+    const auto& tile = atlasTiles.at(tri.tileId.get());
+    const auto animatedSlot = textureAnimator.getSlot(tri.tileId);
+
+    const auto normal = toPackedNormal(generateNormal(tri.vertices[0].from(srcRoom.vertices).position,
+                                                      tri.vertices[1].from(srcRoom.vertices).position,
+                                                      tri.vertices[2].from(srcRoom.vertices).position));
 
-    const auto firstVertex = vbufData.size();
-    for(int i = 0; i < 3; ++i)
+    const auto firstVertex = geometry.vertices.size();
+    for(size_t i = 0; i < 3; ++i)
     {
-      RenderVertex iv;
-      iv.position = tri.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
+      RoomRenderVertex iv;
+      iv.position = toPackedPosition(tri.vertices[i].from(srcRoom.vertices).position.toRenderSystem());
       iv.color = tri.vertices[i].from(srcRoom.vertices).color;
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
-                                tile.uvCoordinates[i],
-                                glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
-                                glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]});
-
-      static const std::array<int, 3> indices{0, 1, 2};
-      iv.normal = generateNormal(tri.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
-                                 tri.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
-                                 tri.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
-
-      vbufData.push_back(iv);
+      iv.normal = normal;
+      geometry.vertices.emplace_back(iv);
+
+      geometry.uvCoords.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask,
+                                     tile.uvCoordinates[i],
+                                     glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]},
+                                     glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]},
+                                     toAnimatedTile(animatedSlot, i));
     }
 
     for(int i : {0, 1, 2})
     {
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
-    }
-    for(int i : {0, 1, 2})
-    {
-      textureAnimator->registerVertex(tri.tileId, i, firstVertex + i);
+      geometry.indices.emplace_back(gsl::narrow<RoomGeometry::IndexType>(firstVertex + i));
     }
   }
 
+  for(const auto& v : srcRoom.vertices)
+  {
+    const auto vv = v.position.toRenderSystem();
+    verticesBBoxMin = glm::min(verticesBBoxMin, vv);
+    verticesBBoxMax = glm::max(verticesBBoxMax, vv);
+  }
+
+  return geometry;
+}
+
+void Room::createSceneNode(const loader::file::Room& srcRoom,
+                           const size_t roomId,
+                           World& world,
+                           const RoomGeometry& geometry,
+                           render::material::MaterialManager& materialManager)
+{
+  RenderMesh renderMesh;
+  renderMesh.m_materialDepthOnly = materialManager.getDepthOnly(false,
+                                                                []()
+                                                                {
+                                                                  return false;
+                                                                });
+  renderMesh.m_materialCSMDepthOnly = nullptr;
+  renderMesh.m_materialFull = materialManager.getGeometry(
+    isWaterRoom,
+    false,
+    true,
+    []()
+    {
+      return false;
+    },
+    [&world]()
+    {
+      const auto& settings = world.getEngine().getEngineConfig()->renderSettings;
+      return !settings.lightingModeActive ? 0 : settings.lightingMode;
+    });
+
   const auto label = "Room:" + std::to_string(roomId);
-  auto vbuf = gsl::make_shared<gl::VertexBuffer<RenderVertex>>(
-    RenderVertex::getLayout(), label, gl::api::BufferUsage::StaticDraw, vbufData);
+  auto vbuf = gsl::make_shared<gl::VertexBuffer<RoomRenderVertex>>(
+    RoomRenderVertex::getLayout(), label, gl::api::BufferUsage::StaticDraw, geometry.vertices);
 
   static const gl::VertexLayout<render::AnimatedUV> uvAttribs{
     {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, gl::VertexAttribute{&render::AnimatedUV::uv}},
     {VERTEX_ATTRIBUTE_QUAD_UV12, &render::AnimatedUV::quadUv12},
     {VERTEX_ATTRIBUTE_QUAD_UV34, &render::AnimatedUV::quadUv34},
+    {VERTEX_ATTRIBUTE_ANIMATED_TILE, &render::AnimatedUV::animatedTile},
   };
-  uvCoordsBuffer = std::make_shared<gl::VertexBuffer<render::AnimatedUV>>(
-    uvAttribs, label + "-uv", gl::api::BufferUsage::DynamicDraw, uvCoordsData);
+  auto uvBuf = gsl::make_shared<gl::VertexBuffer<render::AnimatedUV>>(
+    uvAttribs, label + "-uv", gl::api::BufferUsage::StaticDraw, geometry.uvCoords);
 
-  auto resMesh = renderMesh.toMesh(vbuf, gsl::not_null{uvCoordsBuffer}, label);
+  auto resMesh = renderMesh.toMesh(geometry.indices, vbuf, uvBuf, label);
+  resMesh->bind("b_animatedTiles",
+                [animatedTiles = world.getTextureAnimator().getBuffer()](const render::scene::Node* /*node*/,
+                                                                         const render::scene::Mesh& /*mesh*/,
+                                                                         gl::ShaderStorageBlock& shaderStorageBlock)
+                {
+                  shaderStorageBlock.bind(*animatedTiles);
+                });
+  if(!geometry.quadVertices.empty())
+  {
+    resMesh->bind("b_quadVertices",
+                  [quadVertices = gsl::make_shared<gl::ShaderStorageBuffer<glm::vec4>>(
+                     label + "-quads", gl::api::BufferUsage::StaticDraw, geometry.quadVertices)](
+                    const render::scene::Node* /*node*/,
+                    const render::scene::Mesh& /*mesh*/,
+                    gl::ShaderStorageBlock& shaderStorageBlock)
+                  {
+                    shaderStorageBlock.bind(*quadVertices);
+                  });
+  }
   resMesh->getRenderState().setCullFace(true);
   resMesh->getRenderState().setCullFaceSide(gl::api::TriangleFace::Back);
 
-  node = std::make_shared<render::scene::Node>("Room:" + std::to_string(roomId));
+  node = world.getLevelArena().makeShared<render::scene::Node>(ArenaCategory::SceneNodes,
+                                                               "Room:" + std::to_string(roomId));
   node->setRenderable(resMesh);
   node->bind("u_lightAmbient",
              [](const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
@@ -404,11 +403,15 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
     if(sm.staticMesh->renderMesh == nullptr)
       continue;
 
-    auto subNode = std::make_shared<render::scene::Node>("staticMesh");
+    auto subNode = world.getLevelArena().makeShared<render::scene::Node>(ArenaCategory::SceneNodes, "staticMesh");
     subNode->setRenderable(sm.staticMesh->renderMesh);
     subNode->getRenderState().setScissorTest(false);
     subNode->setLocalMatrix(translate(glm::mat4{1.0f}, (sm.position - position).toRenderSystem())
                             * rotate(glm::mat4{1.0f}, toRad(sm.rotation), glm::vec3{0, -1, 0}));
+    const auto& box = sm.staticMesh->visibilityBox;
+    subNode->setBoundingSphere(
+      render::scene::BoundingSphere::fromCorners(core::TRVec{box.x.min, box.y.min, box.z.min}.toRenderSystem(),
+                                                 core::TRVec{box.x.max, box.y.max, box.z.max}.toRenderSystem()));
 
     subNode->bind("u_lightAmbient",
                   [brightness = toBrightness(ambientShade)](
@@ -450,7 +453,7 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
 
     const auto& sprite = world.getSprites().at(spriteInstance.id.get());
 
-    auto spriteNode = std::make_shared<render::scene::Node>("sprite");
+    auto spriteNode = world.getLevelArena().makeShared<render::scene::Node>(ArenaCategory::SceneNodes, "sprite");
     spriteNode->setRenderable(sprite.yBoundMesh);
     const auto& v = srcRoom.vertices.at(spriteInstance.vertex.get());
     spriteNode->setLocalMatrix(translate(glm::mat4{1.0f}, v.position.toRenderSystem()));
@@ -517,25 +520,15 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
 
   collectShaderLights(world.getEngine().getEngineConfig()->renderSettings.getLightCollectionDepth());
 
-  for(const auto& v : srcRoom.vertices)
-  {
-    const auto vv = v.position.toRenderSystem();
-    verticesBBoxMin = glm::min(verticesBBoxMin, vv);
-    verticesBBoxMax = glm::max(verticesBBoxMax, vv);
-  }
-
-  regenerateDust(nullptr,
-                 materialManager.getDustParticle(),
-                 world.getEngine().getEngineConfig()->renderSettings.dustActive,
-                 world.getEngine().getEngineConfig()->renderSettings.dustDensity);
-
   resetScenery();
 
   particles.setAmbient(*this);
 }
 
-void patchHeightsForBlock(const engine::objects::Object& object, const core::Length& height)
+void patchHeightsForBlock(engine::objects::Object& object, const core::Length& height)
 {
+  object.getWorld().notifySectorsChanged();
+
   auto tmp = object.m_state.location;
   // TODO Ugly const_cast
   const auto groundSector = gsl::not_null{const_cast<Sector*>(tmp.updateRoom().get())};
@@ -634,20 +627,21 @@ void Room::collectShaderLights(size_t depth)
     return;
   }
 
-  std::set<gsl::not_null<const Room*>> testRooms;
-  testRooms.emplace(this);
+  // breadth-first search over the portals, each iteration adds the rooms one portal hop farther away
+  std::vector<const Room*> testRooms{this};
+  size_t frontierBegin = 0;
   for(size_t i = 0; i < depth; ++i)
   {
-    std::set<gsl::not_null<const Room*>> newTestRooms;
-    for(const auto& room : testRooms)
+    const auto frontierEnd = testRooms.size();
+    for(size_t j = frontierBegin; j < frontierEnd; ++j)
     {
-      newTestRooms.emplace(room);
-      for(const auto& portal : room->portals)
+      for(const auto& portal : testRooms[j]->portals)
       {
-        newTestRooms.emplace(portal.adjoiningRoom);
+        if(std::find(testRooms.begin(), testRooms.end(), portal.adjoiningRoom.get()) == testRooms.end())
+          testRooms.emplace_back(portal.adjoiningRoom.get());
       }
     }
-    testRooms = std::move(newTestRooms);
+    frontierBegin = frontierEnd;
   }
 
   for(const auto& room : testRooms)
@@ -667,95 +661,12 @@ void Room::collectShaderLights(size_t depth)
     }
   }
 
+  // the room geometry only uses the most influential lights, objects select their own from all collected lights
+  const auto roomLights = selectLights(bufferLights,
+                                       position.toRenderSystem() + verticesBBoxMin,
+                                       position.toRenderSystem() + verticesBBoxMax,
+                                       MaxRoomLights);
   lightsBuffer = std::make_shared<gl::ShaderStorageBuffer<engine::ShaderLight>>(
-    "lights-buffer", gl::api::BufferUsage::StaticDraw, bufferLights);
-}
-
-void Room::regenerateDust(const std::shared_ptr<engine::Presenter>& presenter,
-                          const gslu::nn_shared<render::material::Material>& dustMaterial,
-                          bool isDustEnabled,
-                          uint8_t dustDensityDivisor)
-{
-  if(!isDustEnabled)
-  {
-    dust = nullptr;
-    return;
-  }
-
-  if(const auto it = dustCache.find(dustDensityDivisor); it != dustCache.end())
-  {
-    dust = it->second;
-    return;
-  }
-  if(presenter != nullptr)
-    presenter->drawLoadingScreen(_("Generating Dust Particles..."));
-  auto dustNode = createParticleMesh(node->getName() + "/dust", dustMaterial, dustDensityDivisor);
-  dustCache.emplace(dustDensityDivisor, dustNode);
-  dust = dustNode;
-}
-
-std::shared_ptr<render::scene::Node> Room::createParticleMesh(
-  const std::string& label, const gslu::nn_shared<render::material::Material>& dustMaterial, uint8_t dustDensityDivisor)
-{
-  static const constexpr auto BaseGridAxisSubdivision = 12;
-  const auto resolution = (cbrt(dustDensityDivisor) / BaseGridAxisSubdivision * 1_sectors).cast<float>().get();
-
-  // https://stackoverflow.com/a/3747462
-  static const auto fastrand = []()
-  {
-    static uint32_t seed = 12345;
-    seed = (214013 * seed + 2531011);
-    return static_cast<float>(seed >> 16u) / 0x8000 - 0.5f;
-  };
-
-  std::vector<glm::vec3> vertices;
-  vertices.reserve(std::lround(std::max(0.0f,
-                                        ((verticesBBoxMax.x - verticesBBoxMin.x) / resolution)
-                                          * ((verticesBBoxMax.y - verticesBBoxMin.y) / resolution)
-                                          * ((verticesBBoxMax.z - verticesBBoxMin.z) / resolution))));
-  std::vector<uint32_t> indices;
-  indices.reserve(vertices.capacity());
-  BOOST_LOG_TRIVIAL(debug) << "generating " << vertices.capacity() << " particles for " << label;
-
-  for(float x = verticesBBoxMin.x + resolution / 2; x <= verticesBBoxMax.x - resolution / 2; x += resolution)
-  {
-    for(float y = verticesBBoxMin.y + resolution / 2; y <= verticesBBoxMax.y - resolution / 2; y += resolution)
-    {
-      for(float z = verticesBBoxMin.z + resolution / 2; z <= verticesBBoxMax.z - resolution / 2; z += resolution)
-      {
-        glm::vec3 p0 = glm::vec3{x, y, z};
-        glm::vec3 offset{fastrand() * resolution, fastrand() * resolution, fastrand() * resolution};
-        indices.emplace_back(gsl::narrow_cast<uint32_t>(vertices.size()));
-        vertices.emplace_back(p0 + offset);
-      }
-    }
-  }
-
-  static const gl::VertexLayout<glm::vec3> layout{
-    {VERTEX_ATTRIBUTE_POSITION_NAME, gl::VertexAttribute<glm::vec3>::Single{}}};
-
-  auto vbuf = gsl::make_shared<gl::VertexBuffer<glm::vec3>>(
-    layout, label + "-particles", gl::api::BufferUsage::StaticDraw, vertices);
-  auto indexBuffer = gsl::make_shared<gl::ElementArrayBuffer<uint32_t>>(
-    label + "-particles", gl::api::BufferUsage::StaticDraw, indices);
-
-  auto vao = gsl::make_shared<gl::VertexArray<uint32_t, glm::vec3>>(
-    indexBuffer, vbuf, std::vector{&dustMaterial->getShaderProgram()->getHandle()}, label + "-particles");
-  auto mesh = std::make_shared<render::scene::MeshImpl<uint32_t, glm::vec3>>(vao, gl::api::PrimitiveType::Points);
-  mesh->getMaterialGroup().set(render::material::RenderMode::Full, dustMaterial);
-
-  mesh->bind("u_baseColor",
-             [color = isWaterRoom ? glm::vec3{0.146f, 0.485f, 0.216f} : glm::vec3{0.431f, 0.386f, 0.375f}](
-               const render::scene::Node* /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-             {
-               uniform.set(color);
-             });
-
-  auto dustNode = std::make_shared<render::scene::Node>(label + "-particles");
-  dustNode->setLocalMatrix(translate(glm::mat4{1.0f}, position.toRenderSystem()));
-  dustNode->setRenderable(mesh);
-  dustNode->setVisible(true);
-
-  return dustNode;
+    "lights-buffer", gl::api::BufferUsage::StaticDraw, roomLights);
 }
 } // namespace engine::world
@@ -16,7 +16,6 @@
 #include <glm/fwd.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
-#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -30,8 +29,7 @@ class World;
 namespace render
 {
 class TextureAnimator;
-struct AnimatedUV;
-} // namespace render
+}
 
 namespace render::material
 {
@@ -59,12 +57,13 @@ struct Room;
 namespace engine
 {
 struct Location;
-class Presenter;
 } // namespace engine
 
 namespace engine::world
 {
+struct AtlasTile;
 struct Room;
+struct RoomGeometry;
 struct StaticMesh;
 
 struct Portal
@@ -112,18 +111,20 @@ struct Room
   std::shared_ptr<render::scene::Node> node = nullptr;
   std::vector<gslu::nn_shared<render::scene::Node>> sceneryNodes{};
 
-  std::map<uint8_t, std::shared_ptr<render::scene::Node>> dustCache{};
   glm::vec3 verticesBBoxMin{std::numeric_limits<float>::max()};
   glm::vec3 verticesBBoxMax{std::numeric_limits<float>::lowest()};
-  std::shared_ptr<render::scene::Node> dust = nullptr;
   mutable engine::InstancedParticleCollection particles{};
-  std::unique_ptr<render::TextureAnimator> textureAnimator{};
-  std::shared_ptr<gl::VertexBuffer<render::AnimatedUV>> uvCoordsBuffer{};
+
+  //! Builds the room's render data without any GL calls, so it is safe to be called concurrently for different rooms
+  //! once all rooms' sectors are set up.
+  [[nodiscard]] RoomGeometry buildGeometry(const loader::file::Room& srcRoom,
+                                           const std::vector<AtlasTile>& atlasTiles,
+                                           const render::TextureAnimator& textureAnimator);
 
   void createSceneNode(const loader::file::Room& srcRoom,
                        size_t roomId,
                        World& world,
-                       const std::vector<uint16_t>& textureAnimData,
+                       const RoomGeometry& geometry,
                        render::material::MaterialManager& materialManager);
 
   [[nodiscard]] const Sector* getSectorByAbsolutePosition(const core::TRVec& worldPos) const
@@ -173,17 +174,9 @@ struct Room
   std::shared_ptr<gl::ShaderStorageBuffer<engine::ShaderLight>> lightsBuffer{};
 
   void collectShaderLights(size_t depth);
-  void regenerateDust(const std::shared_ptr<engine::Presenter>& presenter,
-                      const gslu::nn_shared<render::material::Material>& dustMaterial,
-                      bool isDustEnabled,
-                      uint8_t dustResolutionDivisor);
-
-private:
-  std::shared_ptr<render::scene::Node> createParticleMesh(
-    const std::string& label, const gslu::nn_shared<render::material::Material>& dustMaterial, uint8_t dustDensity);
 };
 
-extern void patchHeightsForBlock(const engine::objects::Object& object, const core::Length& height);
+extern void patchHeightsForBlock(engine::objects::Object& object, const core::Length& height);
 
 [[nodiscard]] extern std::optional<core::Length> getWaterSurfaceHeight(const Location& location);
 } // namespace engine::world
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "render/scene/names.h"
+#include "render/textureanimator.h"
+
+#include <cstdint>
+#include <gl/vertexbuffer.h>
+#include <glm/ext/scalar_uint_sized.hpp>
+#include <glm/ext/vector_int4_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace engine::world
+{
+#pragma pack(push, 1)
+
+//! A compact room vertex, the coordinates of distorted quads are stored separately in the quad vertices.
+struct RoomRenderVertex
+{
+  //! Relative to the room's origin.
+  glm::i16vec4 position{0};
+  glm::vec4 color{1.0f};
+  glm::i8vec4 normal{0};
+  //! 1-based index of the distorted quad in the quad vertices, or 0 if this isn't part of a distorted quad.
+  glm::uint32 quadIndex{0};
+  glm::u8vec4 reflective{0};
+
+  static const gl::VertexLayout<RoomRenderVertex>& getLayout()
+  {
+    static const gl::VertexLayout<RoomRenderVertex> layout{
+      {VERTEX_ATTRIBUTE_POSITION_NAME, &RoomRenderVertex::position},
+      {VERTEX_ATTRIBUTE_NORMAL_NAME, {&RoomRenderVertex::normal, true}},
+      {VERTEX_ATTRIBUTE_COLOR_NAME, &RoomRenderVertex::color},
+      {VERTEX_ATTRIBUTE_QUAD_INDEX, &RoomRenderVertex::quadIndex},
+      {VERTEX_ATTRIBUTE_REFLECTIVE_NAME, {&RoomRenderVertex::reflective, true}},
+    };
+
+    return layout;
+  }
+};
+
+#pragma pack(pop)
+
+//! The render data of a room, built without touching any GL state so that rooms can be built in parallel.
+struct RoomGeometry
+{
+  using IndexType = uint16_t;
+
+  std::vector<RoomRenderVertex> vertices;
+  std::vector<render::AnimatedUV> uvCoords;
+  std::vector<IndexType> indices;
+  //! The four corners of each distorted quad.
+  std::vector<glm::vec4> quadVertices;
+};
+} // namespace engine::world
@@ -12,6 +12,7 @@ namespace engine::world
 {
 struct StaticMesh
 {
+  const core::BoundingBox visibilityBox;
   const core::BoundingBox collisionBox;
   const bool doNotCollide;
 
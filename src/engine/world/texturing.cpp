@@ -9,14 +9,21 @@
 #include "loader/trx/trx.h"
 #include "render/textureatlas.h"
 #include "sprite.h"
+#include "util/bc7.h"
+#include "util/helpers.h"
+#include "util/md5.h"
+#include "util/parallelfor.h"
 
 #include <algorithm>
 #include <array>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <gl/api/gl.hpp>
 #include <gl/cimgwrapper.h>
 #include <gl/image.h>
 #include <gl/pixel.h>
@@ -27,6 +34,9 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -308,6 +318,186 @@ void remapTextures(const loader::file::level::Level& level,
   Ensures(doneTiles.size() == atlasTiles.size());
   Ensures(doneSprites.size() == sprites.size());
 }
+
+// bump whenever the encoder or the file layout changes
+constexpr uint32_t CompressedPageVersion = 1;
+constexpr std::array<char, 4> CompressedPageMagic{'C', 'B', 'C', '7'};
+
+float srgbToLinear(uint8_t value)
+{
+  static const auto table = []()
+  {
+    std::array<float, 256> result{};
+    for(size_t i = 0; i < result.size(); ++i)
+    {
+      const auto v = static_cast<float>(i) / 255.0f;
+      result[i] = v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+    }
+    return result;
+  }();
+  return table[value];
+}
+
+uint8_t linearToSrgb(float value)
+{
+  const auto v = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+  return gsl::narrow_cast<uint8_t>(std::clamp(std::lround(v * 255.0f), 0l, 255l));
+}
+
+//! Halves the size of a square page with a box filter, averaging the color channels in linear space.
+std::vector<gl::PremultipliedSRGBA8> downsample(const std::vector<gl::PremultipliedSRGBA8>& src, size_t srcSize)
+{
+  const auto dstSize = srcSize / 2;
+  std::vector<gl::PremultipliedSRGBA8> dst(dstSize * dstSize);
+  util::parallelFor(dstSize,
+                    [&src, &dst, srcSize, dstSize](size_t y)
+                    {
+                      for(size_t x = 0; x < dstSize; ++x)
+                      {
+                        const std::array<const gl::PremultipliedSRGBA8*, 4> texels{
+                          &src[2 * y * srcSize + 2 * x],
+                          &src[2 * y * srcSize + 2 * x + 1],
+                          &src[(2 * y + 1) * srcSize + 2 * x],
+                          &src[(2 * y + 1) * srcSize + 2 * x + 1],
+                        };
+
+                        auto& result = dst[y * dstSize + x];
+                        for(glm::length_t c = 0; c < 3; ++c)
+                        {
+                          float sum = 0;
+                          for(const auto* texel : texels)
+                            sum += srgbToLinear(texel->channels[c]);
+                          result.channels[c] = linearToSrgb(sum / 4);
+                        }
+
+                        uint32_t alpha = 0;
+                        for(const auto* texel : texels)
+                          alpha += texel->channels[3];
+                        result.channels[3] = gsl::narrow_cast<uint8_t>((alpha + 2) / 4);
+                      }
+                    });
+  return dst;
+}
+
+size_t getCompressedLevelSize(size_t pageSize, int level)
+{
+  const auto size = std::max(pageSize >> gsl::narrow<size_t>(level), util::bc7::BlockTexels);
+  return util::square(size / util::bc7::BlockTexels) * util::bc7::BlockSize;
+}
+
+std::optional<std::vector<std::vector<uint8_t>>>
+  loadCompressedPage(const std::filesystem::path& path, size_t pageSize, int levels)
+{
+  std::ifstream file{path, std::ios::in | std::ios::binary};
+  if(!file.is_open())
+    return std::nullopt;
+
+  std::array<char, 4> magic{};
+  uint32_t version = 0;
+  uint32_t storedSize = 0;
+  uint32_t storedLevels = 0;
+  file.read(magic.data(), magic.size());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(&version), sizeof(version));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(&storedSize), sizeof(storedSize));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(&storedLevels), sizeof(storedLevels));
+  if(!file || magic != CompressedPageMagic || version != CompressedPageVersion || storedSize != pageSize
+     || storedLevels != gsl::narrow<uint32_t>(levels))
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Ignoring outdated compressed texture cache file " << path;
+    return std::nullopt;
+  }
+
+  std::vector<std::vector<uint8_t>> result;
+  for(int level = 0; level < levels; ++level)
+  {
+    auto& data = result.emplace_back(getCompressedLevelSize(pageSize, level));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.read(reinterpret_cast<char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+  }
+
+  if(!file)
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Compressed texture cache file " << path << " is truncated";
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+void storeCompressedPage(const std::filesystem::path& path,
+                         size_t pageSize,
+                         const std::vector<std::vector<uint8_t>>& levels)
+{
+  // write to a temporary file first, so that an interrupted write doesn't leave a corrupt cache entry
+  auto tmpPath = path;
+  tmpPath += ".tmp";
+  {
+    std::ofstream file{tmpPath, std::ios::out | std::ios::binary | std::ios::trunc};
+    if(!file.is_open())
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to create compressed texture cache file " << tmpPath;
+      return;
+    }
+
+    const auto storedSize = gsl::narrow<uint32_t>(pageSize);
+    const auto storedLevels = gsl::narrow<uint32_t>(levels.size());
+    file.write(CompressedPageMagic.data(), CompressedPageMagic.size());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(&CompressedPageVersion), sizeof(CompressedPageVersion));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(&storedSize), sizeof(storedSize));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.write(reinterpret_cast<const char*>(&storedLevels), sizeof(storedLevels));
+    for(const auto& data : levels)
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      file.write(reinterpret_cast<const char*>(data.data()), gsl::narrow<std::streamsize>(data.size()));
+
+    if(!file)
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to write compressed texture cache file " << tmpPath;
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if(ec)
+    BOOST_LOG_TRIVIAL(warning) << "Failed to store compressed texture cache file " << path << ": " << ec.message();
+}
+
+/**
+ * Returns the BC7 mip chain of an atlas page, either from the cache or by compressing it. Cache entries are keyed by
+ * the page's contents, so they are shared between levels and become unused when a texture pack changes.
+ */
+std::vector<std::vector<uint8_t>> getCompressedPage(std::vector<gl::PremultipliedSRGBA8> pixels,
+                                                    size_t pageSize,
+                                                    int levels,
+                                                    const std::filesystem::path& cachePath)
+{
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto key = util::md5(reinterpret_cast<const uint8_t*>(pixels.data()), pixels.size() * sizeof(pixels[0]));
+  const auto path = cachePath / (key + ".bc7");
+  if(auto cached = loadCompressedPage(path, pageSize, levels))
+    return std::move(*cached);
+
+  BOOST_LOG_TRIVIAL(info) << "Compressing texture atlas page " << key;
+  std::vector<std::vector<uint8_t>> result;
+  for(int level = 0; level < levels; ++level)
+  {
+    const auto size = pageSize >> gsl::narrow<size_t>(level);
+    gsl_Assert(size % util::bc7::BlockTexels == 0);
+    if(level > 0)
+      pixels = downsample(pixels, size * 2);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    result.emplace_back(util::bc7::encodeImage(reinterpret_cast<const uint8_t*>(pixels.data()), size, size));
+  }
+
+  storeCompressedPage(path, pageSize, result);
+  return result;
+}
 } // namespace
 
 std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
@@ -316,6 +506,7 @@ std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
                 render::MultiTextureAtlas& atlases,
                 std::vector<AtlasTile>& atlasTiles,
                 std::vector<Sprite>& sprites,
+                const std::filesystem::path& cachePath,
                 const std::function<void(const std::string&)>& drawLoadingScreen)
 {
   drawLoadingScreen(_("Building textures"));
@@ -341,11 +532,19 @@ std::unique_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>>
   auto images = atlases.takeImages();
 
   auto allTextures = std::make_unique<gl::Texture2DArray<gl::PremultipliedSRGBA8>>(
-    glm::ivec3{atlases.getSize(), atlases.getSize(), gsl::narrow<int>(images.size())}, "all-textures", textureLevels);
+    glm::ivec3{atlases.getSize(), atlases.getSize(), gsl::narrow<int>(images.size())},
+    gl::api::SizedInternalFormat::CompressedSrgbAlphaBptcUnorm,
+    "all-textures",
+    textureLevels);
 
   for(size_t i = 0; i < images.size(); ++i)
-    allTextures->assign(images[i]->premultipliedPixels(), gsl::narrow_cast<int>(i));
-  allTextures->generateMipmaps();
+  {
+    const auto levels = getCompressedPage(
+      images[i]->premultipliedPixels(), gsl::narrow<size_t>(atlases.getSize()), textureLevels, cachePath);
+    images[i].reset();
+    for(size_t level = 0; level < levels.size(); ++level)
+      allTextures->assignCompressed(levels[level], gsl::narrow_cast<int>(i), gsl::narrow_cast<int>(level));
+  }
 
   return allTextures;
 }
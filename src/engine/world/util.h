@@ -2,6 +2,14 @@
 
 #include "core/vec.h"
 
+#include <cstdint>
+#include <glm/common.hpp>
+#include <glm/ext/vector_int2_sized.hpp>
+#include <glm/ext/vector_int4_sized.hpp>
+#include <glm/ext/vector_uint2_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
+#include <limits>
+
 namespace engine::world
 {
 inline glm::vec3 generateNormal(const glm::vec3& o, const glm::vec3& a, const glm::vec3& b)
@@ -24,4 +32,28 @@ inline bool isDistortedQuad(const glm::vec2& v1, const glm::vec2& v2, const glm:
   return glm::abs(glm::dot(e1, e2)) > Eps || glm::abs(glm::dot(e2, e3)) > Eps || glm::abs(glm::dot(e3, e4)) > Eps
          || glm::abs(glm::dot(e4, e1)) > Eps;
 }
+//! Rounds a position to 16 bit integers, the fourth component is unused.
+inline glm::i16vec4 toPackedPosition(const glm::vec3& position)
+{
+  static const glm::vec3 min{std::numeric_limits<int16_t>::min()};
+  static const glm::vec3 max{std::numeric_limits<int16_t>::max()};
+  return glm::i16vec4{glm::clamp(glm::round(position), min, max), 0};
+}
+
+//! Packs a unit vector into normalized signed bytes, the fourth component is unused.
+inline glm::i8vec4 toPackedNormal(const glm::vec3& normal)
+{
+  return glm::i8vec4{glm::round(glm::clamp(normal, -1.0f, 1.0f) * 127.0f), 0};
+}
+
+//! Packs texture coordinates into normalized unsigned shorts.
+inline glm::u16vec2 toPackedUv(const glm::vec2& uv)
+{
+  return glm::u16vec2{glm::round(glm::clamp(uv, 0.0f, 1.0f) * 65535.0f)};
+}
+
+inline glm::u16vec4 toPackedUv(const glm::vec2& uv0, const glm::vec2& uv1)
+{
+  return glm::u16vec4{toPackedUv(uv0), toPackedUv(uv1)};
+}
 } // namespace engine::world
@@ -33,6 +33,7 @@
 #include "engine/particle.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
+#include "engine/script/reflection.h"
 #include "engine/script/scriptengine.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
@@ -62,6 +63,7 @@
 #include "render/textureatlas.h"
 #include "rendermeshdata.h"
 #include "room.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/array.h"
 #include "serialization/bitset.h"
@@ -82,6 +84,7 @@
 #include "ui/ui.h"
 #include "util/fsutil.h"
 #include "util/helpers.h"
+#include "util/parallelfor.h"
 
 #include <algorithm>
 #include <boost/assert.hpp>
@@ -242,14 +245,16 @@ void emitGroundBubbles(const gsl::not_null<Room*>& room, World& world)
 
       for(size_t i = 0; i < MaxParticlesPerSector; ++i)
       {
-        if(util::rand15(1.0f) > EmissionProbability)
+        if(world.getRandomStreams().particles.rand15(1.0f) > EmissionProbability)
           continue;
 
-        const auto px = room->position.X + x * core::SectorSize + util::rand15(core::SectorSize);
-        const auto pz = room->position.Z + z * core::SectorSize + util::rand15(core::SectorSize);
+        auto& random = world.getRandomStreams().particles;
+        const auto px = room->position.X + x * core::SectorSize + random.rand15(core::SectorSize);
+        const auto pz = room->position.Z + z * core::SectorSize + random.rand15(core::SectorSize);
         const auto py = s->floorHeight;
 
-        auto particle = gsl::make_shared<BubbleParticle>(Location{room, core::TRVec{px, py, pz}}, world, true, true);
+        auto particle = world.getLevelArena().makeShared<BubbleParticle>(
+          ArenaCategory::Particles, Location{room, core::TRVec{px, py, pz}}, world, true, true);
         particle->scale = 0.5f;
         particle->circleRadius = 1_len;
         room->particles.registerParticle(std::move(particle));
@@ -307,6 +312,13 @@ const std::vector<Room>& World::getRooms() const
   return m_rooms;
 }
 
+const Room* World::findRoomByPhysicalId(size_t physicalId) const
+{
+  if(physicalId >= m_roomsByPhysicalId.size())
+    return nullptr;
+  return m_roomsByPhysicalId[physicalId];
+}
+
 std::vector<Room>& World::getRooms()
 {
   return m_rooms;
@@ -362,7 +374,7 @@ void World::laraBubblesEffect(objects::Object& object)
   if(modelNode == nullptr)
     return;
 
-  auto bubbleCount = util::rand15(12);
+  auto bubbleCount = m_randomStreams.particles.rand15(12);
   if(bubbleCount == 0)
     return;
 
@@ -374,7 +386,8 @@ void World::laraBubblesEffect(objects::Object& object)
 
   while(bubbleCount-- > 0)
   {
-    auto particle = gsl::make_shared<BubbleParticle>(Location{object.m_state.location.room, position}, *this);
+    auto particle = m_levelArena->makeShared<BubbleParticle>(
+      ArenaCategory::Particles, Location{object.m_state.location.room, position}, *this);
     setParent(particle, object.m_state.location.room->node);
     m_objectManager.registerParticle(particle);
   }
@@ -666,6 +679,7 @@ const std::vector<int16_t>& World::getAnimCommands() const
 
 void World::update(const bool godMode)
 {
+  m_raycastQueries.beginFrame(*this);
   m_objectManager.update(*this, godMode);
   if(const auto lara = m_objectManager.getLaraPtr();
      getEngine().getEngineConfig()->lowHealthMonochrome && lara != nullptr)
@@ -688,10 +702,7 @@ void World::update(const bool godMode)
   m_uvAnimTime += 1_frame;
   if(m_uvAnimTime >= UVAnimTime)
   {
-    for(const auto& room : m_rooms)
-    {
-      room.textureAnimator->updateCoordinates(*room.uvCoordsBuffer, m_atlasTiles);
-    }
+    m_textureAnimator->advance(m_atlasTiles);
     m_uvAnimTime -= UVAnimTime;
   }
 
@@ -1028,7 +1039,9 @@ void World::serialize(const serialization::Serializer<World>& ser)
       S_NV("rooms", serialization::FrozenVector{m_rooms}),
       S_NV("boxes", serialization::FrozenVector{m_boxes}),
       S_NV("audioEngine", *m_audioEngine),
-      S_NVO("ghostFrame", m_ghostFrame));
+      S_NVO("ghostFrame", m_ghostFrame),
+      S_NVO("randomStreams", m_randomStreams),
+      S_NVO("ghostRandomStreams", m_ghostRandomStreams));
 
   if(ser.loading)
   {
@@ -1041,7 +1054,7 @@ void World::gameLoop(bool godMode, float blackAlpha, ui::Ui& ui)
   update(godMode);
   m_player->laraHealth = m_objectManager.getLara().m_state.health;
 
-  const auto waterEntryPortals = m_cameraController->update();
+  m_waterEntryPortals = m_cameraController->update();
 
   for(const auto& room : m_rooms)
   {
@@ -1062,19 +1075,11 @@ void World::gameLoop(bool godMode, float blackAlpha, ui::Ui& ui)
   getPresenter().drawBars(ui, m_palette, getObjectManager(), getEngine().getEngineConfig()->pulseLowHealthHealthBar);
 
   drawPickupWidgets(ui);
-  if(const auto lara = getObjectManager().getLaraPtr())
-    lara->m_state.location.room->node->setVisible(true);
-  getPresenter().renderWorld(getRooms(), getCameraController(), waterEntryPortals, *this);
-  getPresenter().renderScreenOverlay();
   if(blackAlpha > 0)
   {
     ui.drawBox({0, 0}, ui.getSize(), gl::SRGBA8{0, 0, 0, gsl::narrow_cast<uint8_t>(255 * blackAlpha)});
   }
 
-  getPresenter().renderUi(ui, 1);
-  getPresenter().updateSoundEngine();
-  getPresenter().swapBuffers();
-
   if(m_engine.getEngineConfig()->waterBedBubbles)
   {
     for(auto& room : m_rooms)
@@ -1084,6 +1089,17 @@ void World::gameLoop(bool godMode, float blackAlpha, ui::Ui& ui)
   }
 }
 
+void World::renderFrame(ui::Ui& ui)
+{
+  if(const auto lara = getObjectManager().getLaraPtr())
+    lara->m_state.location.room->node->setVisible(true);
+  getPresenter().renderWorld(getRooms(), getCameraController(), m_waterEntryPortals, *this);
+  getPresenter().renderScreenOverlay();
+  getPresenter().renderUi(ui, 1);
+  getPresenter().updateSoundEngine();
+  getPresenter().swapBuffers();
+}
+
 bool World::cinematicLoop()
 {
   m_cameraController->m_cinematicFrame += 1_frame;
@@ -1097,7 +1113,7 @@ bool World::cinematicLoop()
     = m_cameraController->updateCinematic(m_cinematicFrames.at(m_cameraController->m_cinematicFrame.get()), false);
   doGlobalEffect();
 
-  ui::Ui ui{getPresenter().getMaterialManager()->getUi(), getPalette(), getPresenter().getUiViewport()};
+  ui::Ui ui{getPresenter().getUiRenderer(), getPalette(), getPresenter().getUiViewport()};
   getPresenter().renderWorld(getRooms(), getCameraController(), waterEntryPortals, *this);
   getPresenter().renderScreenOverlay();
   getPresenter().renderUi(ui, 1);
@@ -1215,6 +1231,7 @@ World::World(Engine& engine,
         *this, engine.getAssetDataPath(), engine.getPresenter().getSoundEngine())}
     , m_title{std::move(title)}
     , m_itemTitles{std::move(itemTitles)}
+    , m_objectInfos{engine.getScriptEngine().getGameflow().getObjectInfos()}
     , m_player{std::move(player)}
     , m_levelStartPlayer{std::move(levelStartPlayer)}
     , m_samplesData{std::move(level->m_samplesData)}
@@ -1239,6 +1256,7 @@ World::World(Engine& engine,
                                 atlases,
                                 m_atlasTiles,
                                 m_sprites,
+                                m_engine.getTextureCachePath(),
                                 [this](const std::string& s)
                                 {
                                   getPresenter().drawLoadingScreen(s);
@@ -1327,6 +1345,9 @@ World::World(Engine& engine,
     m_audioEngine->playStopCdTrack(m_engine.getScriptEngine().getGameflow(), *ambient, false);
   }
   getPresenter().disableScreenOverlay();
+  // building the level may already draw from the streams
+  m_ghostRandomStreams = m_randomStreams;
+  m_levelArena->logCounters();
 }
 
 World::~World()
@@ -1572,9 +1593,21 @@ void World::initRooms(const loader::file::level::Level& level)
       }
     }
     m_rooms[i].alternateRoom = srcRoom.alternateRoom.get() >= 0 ? &m_rooms.at(srcRoom.alternateRoom.get()) : nullptr;
+  }
 
-    m_rooms[i].createSceneNode(
-      level.m_rooms.at(i), i, *this, level.m_animatedTextures, *getPresenter().getMaterialManager());
+  m_textureAnimator = std::make_unique<render::TextureAnimator>(level.m_animatedTextures, m_atlasTiles);
+
+  // the geometry only depends on the sectors of the room and its neighbours, so all rooms must be set up first
+  std::vector<RoomGeometry> geometries(m_rooms.size());
+  util::parallelFor(m_rooms.size(),
+                    [this, &level, &geometries](size_t i)
+                    {
+                      geometries[i] = m_rooms[i].buildGeometry(level.m_rooms.at(i), m_atlasTiles, *m_textureAnimator);
+                    });
+
+  for(size_t i = 0; i < m_rooms.size(); ++i)
+  {
+    m_rooms[i].createSceneNode(level.m_rooms.at(i), i, *this, geometries[i], *getPresenter().getMaterialManager());
     setParent(gsl::not_null{m_rooms[i].node}, getPresenter().getRenderer().getRootNode());
   }
 }
@@ -1603,7 +1636,9 @@ void World::initStaticMeshes(const loader::file::level::Level& level,
       "static-mesh");
     mesh->getRenderState().setScissorTest(false);
     const bool distinct
-      = m_staticMeshes.emplace(staticMesh.id, StaticMesh{staticMesh.collision_box, staticMesh.doNotCollide(), mesh})
+      = m_staticMeshes
+          .emplace(staticMesh.id,
+                   StaticMesh{staticMesh.visibility_box, staticMesh.collision_box, staticMesh.doNotCollide(), mesh})
           .second;
 
     gsl_Assert(distinct);
@@ -1720,15 +1755,19 @@ std::vector<gsl::not_null<const Mesh*>> World::initAnimatedModels(const loader::
 
 void World::initMeshes(const loader::file::level::Level& level)
 {
-  std::transform(level.m_meshes.begin(),
-                 level.m_meshes.end(),
-                 std::back_inserter(m_meshes),
-                 [this](const loader::file::Mesh& mesh)
-                 {
-                   return Mesh{mesh.collision_center,
-                               mesh.collision_radius,
-                               gsl::make_shared<RenderMeshData>(mesh, m_atlasTiles, m_palette)};
-                 });
+  std::vector<std::shared_ptr<RenderMeshData>> meshData(level.m_meshes.size());
+  util::parallelFor(level.m_meshes.size(),
+                    [this, &level, &meshData](size_t i)
+                    {
+                      meshData[i] = std::make_shared<RenderMeshData>(level.m_meshes[i], m_atlasTiles, m_palette);
+                    });
+
+  m_meshes.reserve(level.m_meshes.size());
+  for(size_t i = 0; i < level.m_meshes.size(); ++i)
+  {
+    const auto& mesh = level.m_meshes[i];
+    m_meshes.emplace_back(Mesh{mesh.collision_center, mesh.collision_radius, gsl::not_null{std::move(meshData[i])}});
+  }
 }
 
 void World::initAnimationData(const loader::file::level::Level& level)
@@ -1810,6 +1849,14 @@ void World::initAnimationData(const loader::file::level::Level& level)
 
 void World::connectSectors()
 {
+  notifySectorsChanged();
+  m_roomsByPhysicalId.resize(m_rooms.size(), nullptr);
+  for(const auto& room : m_rooms)
+  {
+    gsl_Assert(room.physicalId < m_roomsByPhysicalId.size());
+    m_roomsByPhysicalId[room.physicalId] = &room;
+  }
+
   for(auto& room : m_rooms)
   {
     room.collectShaderLights(m_engine.getEngineConfig()->renderSettings.getLightCollectionDepth());
@@ -12,10 +12,14 @@
 #include "engine/controllerbuttons.h"
 #include "engine/floordata/types.h"
 #include "engine/items_tr1.h"
+#include "engine/levelarena.h"
 #include "engine/objectmanager.h"
 #include "engine/objects/object.h"
+#include "engine/randomstreams.h"
+#include "engine/raycast.h"
 #include "loader/file/item.h"
 #include "mesh.h"
+#include "objectinfotable.h"
 #include "room.h"
 #include "serialization/serialization_fwd.h"
 #include "sprite.h"
@@ -39,6 +43,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -172,12 +177,13 @@ public:
     item.shade = core::Shade{core::Shade::type{0}};
     item.activationState = activationState;
 
-    auto object
-      = gsl::make_shared<T>(objects::makeObjectName(type.get_as<TR1ItemId>(), m_objectManager.getDynamicObjectCount()),
-                            gsl::not_null{this},
-                            room,
-                            item,
-                            gsl::not_null{model.get()});
+    auto object = m_levelArena->makeShared<T>(
+      ArenaCategory::Objects,
+      objects::makeObjectName(type.get_as<TR1ItemId>(), m_objectManager.getDynamicObjectCount()),
+      gsl::not_null{this},
+      room,
+      item,
+      gsl::not_null{model.get()});
 
     m_objectManager.registerDynamicObject(object);
     addChild(gsl::not_null{room->node}, gsl::not_null{object->getNode()});
@@ -188,7 +194,7 @@ public:
   template<typename T>
   std::shared_ptr<T> createDynamicObject(const Location& location)
   {
-    auto object = std::make_shared<T>(this, location);
+    auto object = m_levelArena->makeShared<T>(ArenaCategory::Objects, this, location);
 
     m_objectManager.registerDynamicObject(object);
 
@@ -201,6 +207,7 @@ public:
   [[nodiscard]] const std::vector<Box>& getBoxes() const;
   [[nodiscard]] const std::vector<Room>& getRooms() const;
   std::vector<Room>& getRooms();
+  [[nodiscard]] const Room* findRoomByPhysicalId(size_t physicalId) const;
   [[nodiscard]] const StaticMesh* findStaticMeshById(const core::StaticMeshId& meshId) const;
   [[nodiscard]] const std::unique_ptr<SpriteSequence>& findSpriteSequenceForType(const core::TypeId& type) const;
   [[nodiscard]] const Animation& getAnimation(loader::file::AnimationId id) const;
@@ -239,7 +246,10 @@ public:
   core::TypeId find(const SkeletalModelType* model) const;
   core::TypeId find(const Sprite* sprite) const;
   void serialize(const serialization::Serializer<World>& ser);
+  //! Advances the simulation by a single tick, and draws the tick's UI into @p ui.
   void gameLoop(bool godMode, float blackAlpha, ui::Ui& ui);
+  //! Presents the current state of the world, which may be rendered multiple times per tick.
+  void renderFrame(ui::Ui& ui);
   bool cinematicLoop();
   void load(const std::optional<size_t>& slot);
   void save(const std::optional<size_t>& slot);
@@ -330,6 +340,47 @@ public:
     return m_atlasTiles;
   }
 
+  [[nodiscard]] const render::TextureAnimator& getTextureAnimator() const
+  {
+    return *m_textureAnimator;
+  }
+
+  [[nodiscard]] const script::ObjectInfo& getObjectInfo(const core::TypeId& type) const
+  {
+    return m_objectInfos.at(type);
+  }
+
+  //! Must be called whenever sectors are modified, so that cached collision queries are invalidated.
+  void notifySectorsChanged()
+  {
+    ++m_sectorsRevision;
+  }
+
+  [[nodiscard]] auto getSectorsRevision() const
+  {
+    return m_sectorsRevision;
+  }
+
+  [[nodiscard]] RaycastQueries& getRaycastQueries()
+  {
+    return m_raycastQueries;
+  }
+
+  [[nodiscard]] RandomStreams& getRandomStreams()
+  {
+    return m_randomStreams;
+  }
+
+  [[nodiscard]] const RandomStreams& getRandomStreams() const
+  {
+    return m_randomStreams;
+  }
+
+  [[nodiscard]] LevelArena& getLevelArena()
+  {
+    return *m_levelArena;
+  }
+
   [[nodiscard]] const auto& getSprites() const
   {
     return m_sprites;
@@ -370,21 +421,32 @@ public:
     m_ghostFrame += 1_frame;
   }
 
+  //! The random streams when the ghost recording started, i.e. at ghost frame 0, even if the game was loaded later.
+  [[nodiscard]] const auto& getGhostRandomStreams() const
+  {
+    return m_ghostRandomStreams;
+  }
+
 private:
   void drawPickupWidgets(ui::Ui& ui);
 
   Engine& m_engine;
   const std::filesystem::path m_levelFilename;
+  const gslu::nn_shared<LevelArena> m_levelArena{gsl::make_shared<LevelArena>()};
 
   std::unique_ptr<AudioEngine> m_audioEngine;
 
   std::unique_ptr<CameraController> m_cameraController;
+  std::unordered_set<const Portal*> m_waterEntryPortals;
 
   core::Frame m_effectTimer = 0_frame;
   std::optional<size_t> m_activeEffect{};
   std::shared_ptr<audio::Voice> m_globalSoundEffect{};
 
   bool m_roomsAreSwapped = false;
+  size_t m_sectorsRevision = 0;
+  RaycastQueries m_raycastQueries{};
+  RandomStreams m_randomStreams{};
 
   ObjectManager m_objectManager;
 
@@ -415,6 +477,7 @@ private:
   std::string m_title{};
   size_t m_totalSecrets = 0;
   std::unordered_map<std::string, std::unordered_map<TR1ItemId, std::string>> m_itemTitles{};
+  const ObjectInfoTable m_objectInfos;
   std::shared_ptr<gl::Texture2DArray<gl::PremultipliedSRGBA8>> m_allTextures;
   core::Frame m_uvAnimTime = 0_frame;
 
@@ -439,7 +502,9 @@ private:
   std::vector<Sprite> m_sprites;
   std::map<core::TypeId, std::unique_ptr<SpriteSequence>> m_spriteSequences;
   std::vector<AtlasTile> m_atlasTiles;
+  std::unique_ptr<render::TextureAnimator> m_textureAnimator;
   std::vector<Room> m_rooms;
+  std::vector<const Room*> m_roomsByPhysicalId;
   std::vector<CinematicFrame> m_cinematicFrames;
   std::vector<CameraSink> m_cameraSinks;
   std::vector<StaticSoundEffect> m_staticSoundEffects;
@@ -447,6 +512,7 @@ private:
   ControllerLayouts m_controllerLayouts;
 
   core::Frame m_ghostFrame = 0_frame;
+  RandomStreams m_ghostRandomStreams{};
 
   static constexpr auto DeathStrengthFadeDuration = 1_sec * core::FrameRate;
   static constexpr auto DeathStrengthFadeDeltaPerFrame = 1_frame / DeathStrengthFadeDuration.cast<float>();
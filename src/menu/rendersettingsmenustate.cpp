@@ -500,6 +500,32 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
     tmp->selectValue(engine.getEngineConfig()->renderSettings.renderResolutionDivisor);
   }
 
+  {
+    auto tmp = std::make_shared<ui::widgets::ValueSelector<uint8_t>>(
+      [](uint8_t value)
+      {
+        return /* translators: TR charmap encoding */ _("\x1f\x6c %1% \x1f\x6d Percent Min. Adaptive Resolution",
+                                                        static_cast<uint32_t>(value));
+      },
+      [&engine](uint8_t value)
+      {
+        engine.getEngineConfig()->renderSettings.adaptiveResolutionMinPercent = value;
+        engine.applySettings();
+      },
+      std::vector<uint8_t>{25, 50, 75});
+    listBox->addSetting(
+      gslu::nn_shared<ui::widgets::Widget>{tmp},
+      [&engine]()
+      {
+        return engine.getEngineConfig()->renderSettings.adaptiveResolutionActive;
+      },
+      [&engine]()
+      {
+        toggle(engine, engine.getEngineConfig()->renderSettings.adaptiveResolutionActive);
+      });
+    tmp->selectValue(engine.getEngineConfig()->renderSettings.adaptiveResolutionMinPercent);
+  }
+
   {
     auto tmp = std::make_shared<ui::widgets::ValueSelector<uint8_t>>(
       [](uint8_t value)
@@ -40,6 +40,15 @@ bool BufferParameter::bind(const scene::Node* node, const scene::Mesh& mesh, Sha
   return true;
 }
 
+void BufferParameter::bindTransformBuffer()
+{
+  m_bufferBinder = [](const scene::Node* node, const scene::Mesh& /*mesh*/, gl::ShaderStorageBlock& ssb)
+  {
+    Expects(node != nullptr);
+    ssb.bind(node->getTransformBuffer());
+  };
+}
+
 void BufferParameter::bindBoneTransformBuffer(std::function<bool()> smooth)
 {
   m_bufferBinder = [smooth](const scene::Node* node, const scene::Mesh& /*mesh*/, gl::ShaderStorageBlock& ssb)
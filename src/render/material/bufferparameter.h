@@ -63,6 +63,7 @@ public:
   }
 
   bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
+  void bindTransformBuffer();
   void bindBoneTransformBuffer(std::function<bool()> smooth);
 
 private:
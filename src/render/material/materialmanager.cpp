@@ -14,6 +14,7 @@
 #include <chrono>
 #include <cstdint>
 #include <gl/glad_init.h>
+#include <gl/glyphatlas.h>
 #include <gl/pixel.h>
 #include <gl/program.h>
 #include <gl/renderstate.h>
@@ -55,7 +56,10 @@ gslu::nn_shared<Material> MaterialManager::getSprite(SpriteMaterialMode mode, st
   m->getRenderState().setCullFace(false);
 
   if(mode != SpriteMaterialMode::InstancedBillboard)
-    m->getUniformBlock("Transform")->bindTransformBuffer();
+  {
+    m->getBuffer("Transform")->bindTransformBuffer();
+    m->getUniform("u_transformIndex")->bindTransformIndex();
+  }
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   m->getUniform("u_diffuseTextures")
     ->bind(
@@ -99,7 +103,8 @@ gslu::nn_shared<Material> MaterialManager::getDepthOnly(bool skeletal, std::func
   auto m = gsl::make_shared<Material>(m_shaderCache->getDepthOnly(skeletal));
   m->getRenderState().setDepthTest(true);
   m->getRenderState().setDepthWrite(true);
-  m->getUniformBlock("Transform")->bindTransformBuffer();
+  m->getBuffer("Transform")->bindTransformBuffer();
+  m->getUniform("u_transformIndex")->bindTransformIndex();
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   if(auto buffer = m->tryGetBuffer("BoneTransform"))
     buffer->bindBoneTransformBuffer(smooth);
@@ -126,7 +131,8 @@ gslu::nn_shared<Material> MaterialManager::getGeometry(
         uniform.set(gsl::not_null{m_geometryTexturesHandle});
       });
 
-  m->getUniformBlock("Transform")->bindTransformBuffer();
+  m->getBuffer("Transform")->bindTransformBuffer();
+  m->getUniform("u_transformIndex")->bindTransformIndex();
   if(auto buffer = m->tryGetBuffer("BoneTransform"))
     buffer->bindBoneTransformBuffer(smooth);
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
@@ -175,7 +181,8 @@ gslu::nn_shared<Material> MaterialManager::getGhost(std::function<bool()> smooth
     return gsl::not_null{m_ghost};
 
   auto m = gsl::make_shared<Material>(m_shaderCache->getGhost());
-  m->getUniformBlock("Transform")->bindTransformBuffer();
+  m->getBuffer("Transform")->bindTransformBuffer();
+  m->getUniform("u_transformIndex")->bindTransformIndex();
   m->getBuffer("BoneTransform")->bindBoneTransformBuffer(smooth);
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   m_ghost = m;
@@ -211,7 +218,8 @@ gslu::nn_shared<Material> MaterialManager::getLightning()
     return gsl::not_null{m_lightning};
 
   m_lightning = std::make_shared<Material>(m_shaderCache->getLightning());
-  m_lightning->getUniformBlock("Transform")->bindTransformBuffer();
+  m_lightning->getBuffer("Transform")->bindTransformBuffer();
+  m_lightning->getUniform("u_transformIndex")->bindTransformIndex();
   m_lightning->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
 
   return gsl::not_null{m_lightning};
@@ -277,7 +285,15 @@ gslu::nn_shared<Material> MaterialManager::getUi()
   m->getUniform("u_input")->bind(
     [this](const scene::Node* /*node*/, const scene::Mesh& /*mesh*/, gl::Uniform& uniform)
     {
-      uniform.set(gsl::not_null{m_geometryTexturesHandle});
+      // the loading screen is drawn before any level textures exist
+      if(m_geometryTexturesHandle != nullptr)
+        uniform.set(gsl::not_null{m_geometryTexturesHandle});
+    });
+  m->getUniform("u_glyphs")->bind(
+    [this](const scene::Node* /*node*/, const scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+    {
+      if(m_glyphAtlas != nullptr)
+        uniform.set(m_glyphAtlas->getTexture());
     });
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   configureForScreenSpaceEffect(*m, true);
@@ -567,7 +583,8 @@ gslu::nn_shared<Material> MaterialManager::getDustParticle()
   m->getRenderState().setDepthTest(true);
   m->getRenderState().setDepthWrite(false);
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
-  m->getUniformBlock("Transform")->bindTransformBuffer();
+  m->getBuffer("Transform")->bindTransformBuffer();
+  m->getUniform("u_transformIndex")->bindTransformIndex();
   m->getUniform("u_noise")->set(gsl::not_null{m_noiseTexture});
   m->getUniform("u_time")->bind(
     [renderer = m_renderer](const scene::Node*, const scene::Mesh& /*mesh*/, gl::Uniform& uniform)
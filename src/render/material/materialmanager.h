@@ -82,6 +82,11 @@ public:
     m_csm = csm;
   }
 
+  void setGlyphAtlas(const gslu::nn_shared<gl::GlyphAtlas>& glyphAtlas)
+  {
+    m_glyphAtlas = glyphAtlas;
+  }
+
   void setDeathStrength(float strength);
 
 private:
@@ -123,6 +128,7 @@ private:
   std::shared_ptr<scene::CSM> m_csm;
   const gslu::nn_shared<scene::Renderer> m_renderer;
   std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::PremultipliedSRGBA8>>> m_geometryTexturesHandle;
+  std::shared_ptr<gl::GlyphAtlas> m_glyphAtlas;
 
   void createSampler(const gslu::nn_shared<gl::Texture2DArray<gl::PremultipliedSRGBA8>>& geometryTextures,
                      bool bilinear,
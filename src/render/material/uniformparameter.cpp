@@ -38,6 +38,15 @@ bool UniformParameter::bind(const scene::Node* node, const scene::Mesh& mesh, Sh
   return true;
 }
 
+void UniformParameter::bindTransformIndex()
+{
+  m_valueSetter = [](const scene::Node* node, const scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+  {
+    Expects(node != nullptr);
+    uniform.set(node->getTransformIndex());
+  };
+}
+
 gl::Uniform* UniformParameter::findUniform(ShaderProgram& shaderProgram) const
 {
   if(const auto uniform = shaderProgram.findUniform(getName()))
@@ -76,15 +85,6 @@ bool UniformBlockParameter::bind(const scene::Node* node, const scene::Mesh& mes
   return true;
 }
 
-void UniformBlockParameter::bindTransformBuffer()
-{
-  m_bufferBinder = [](const scene::Node* node, const scene::Mesh& /*mesh*/, gl::UniformBlock& ub)
-  {
-    Expects(node != nullptr);
-    ub.bind(node->getTransformBuffer());
-  };
-}
-
 void UniformBlockParameter::bindCameraBuffer(const gslu::nn_shared<scene::Camera>& camera)
 {
   m_bufferBinder = [camera](const scene::Node* /*node*/, const scene::Mesh& /*mesh*/, gl::UniformBlock& ub)
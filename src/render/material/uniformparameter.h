@@ -74,6 +74,8 @@ public:
 
   bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
 
+  void bindTransformIndex();
+
 private:
   [[nodiscard]] gl::Uniform* findUniform(ShaderProgram& shaderProgram) const;
 
@@ -120,7 +122,6 @@ public:
 
   bool bind(const scene::Node* node, const scene::Mesh& mesh, ShaderProgram& shaderProgram) override;
 
-  void bindTransformBuffer();
   void bindCameraBuffer(const gslu::nn_shared<scene::Camera>& camera);
 
 private:
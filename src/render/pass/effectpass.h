@@ -36,6 +36,8 @@ public:
                       const gslu::nn_shared<material::Material>& material,
                       const gslu::nn_shared<gl::TextureHandle<gl::Texture2D<TPixel>>>& input)
       : m_name{std::move(name)}
+      , m_material{material}
+      , m_input{input}
       , m_mesh{scene::createScreenQuad(material, m_name)}
       , m_output{std::make_shared<gl::Texture2D<TPixel>>(input->getTexture()->size(), m_name + "-color")}
       , m_outputHandle{std::make_shared<gl::TextureHandle<gl::Texture2D<TPixel>>>(
@@ -92,6 +94,14 @@ public:
     return m_fb;
   }
 
+  //! Whether this pass renders the same effect from the same input, so it can be kept when the pipeline changes.
+  [[nodiscard]] bool isSameAs(const std::string& name,
+                              const gslu::nn_shared<material::Material>& material,
+                              const gslu::nn_shared<gl::TextureHandle<gl::Texture2D<TPixel>>>& input) const
+  {
+    return m_name == name && m_material == material && m_input == input;
+  }
+
   template<typename... Args>
   void bind(Args&&... args)
   {
@@ -100,6 +110,8 @@ public:
 
 private:
   const std::string m_name;
+  const gslu::nn_shared<material::Material> m_material;
+  const gslu::nn_shared<gl::TextureHandle<gl::Texture2D<TPixel>>> m_input;
   gslu::nn_shared<scene::Mesh> m_mesh;
   gslu::nn_shared<gl::Texture2D<TPixel>> m_output;
   gslu::nn_shared<gl::TextureHandle<gl::Texture2D<TPixel>>> m_outputHandle;
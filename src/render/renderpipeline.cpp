@@ -1,5 +1,6 @@
 #include "renderpipeline.h"
 
+#include "core/magic.h"
 #include "engine/world/room.h"
 #include "pass/edgedetectionpass.h"
 #include "pass/effectpass.h"
@@ -8,38 +9,59 @@
 #include "pass/portalpass.h"
 #include "pass/uipass.h"
 #include "pass/worldcompositionpass.h"
+#include "render/material/material.h"
 #include "render/material/materialmanager.h"
-#include "render/scene/visitor.h"
+#include "render/material/rendermode.h"
+#include "render/material/uniformparameter.h"
+#include "render/scene/mesh.h"
+#include "render/scene/node.h"
+#include "render/scene/rendercontext.h"
 #include "rendersettings.h"
 
 #include <boost/assert.hpp>
+#include <cmath>
 #include <gl/framebuffer.h>
 #include <gl/program.h>
 #include <gl/texture2d.h>
 #include <gl/texturedepth.h>
 #include <gl/texturehandle.h>
+#include <gl/vertexarray.h>
+#include <glm/common.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <string>
+#include <utility>
 
-namespace render::material
+namespace render
+{
+namespace
 {
-class Material;
+[[nodiscard]] bool compositionSettingsDiffer(const RenderSettings& a, const RenderSettings& b)
+{
+  return a.dof != b.dof || a.bloom != b.bloom || a.waterDenoise != b.waterDenoise;
 }
 
-namespace render::scene
+[[nodiscard]] bool worldEffectSettingsDiffer(const RenderSettings& a, const RenderSettings& b)
 {
-class Mesh;
-class Node;
-} // namespace render::scene
+  return a.hbao != b.hbao || a.edges != b.edges || a.fxaaActive != b.fxaaActive || a.fxaaPreset != b.fxaaPreset
+         || a.lensDistortion != b.lensDistortion || a.velvia != b.velvia || a.filmGrain != b.filmGrain;
+}
 
-namespace render
+[[nodiscard]] bool backbufferEffectSettingsDiffer(const RenderSettings& a, const RenderSettings& b)
 {
+  return a.crtActive != b.crtActive || a.crtVersion != b.crtVersion || a.brightnessEnabled != b.brightnessEnabled
+         || a.brightness != b.brightness || a.contrastEnabled != b.contrastEnabled || a.contrast != b.contrast;
+}
+} // namespace
+
 RenderPipeline::RenderPipeline(material::MaterialManager& materialManager,
                                const glm::ivec2& renderViewport,
                                const glm::ivec2& uiViewport,
                                const glm::ivec2& displayViewport)
+    : m_dustMesh{gsl::make_shared<scene::ProceduralMesh>(gsl::make_shared<gl::AttributelessVertexArray>("dust-vao"))}
 {
+  m_dustMesh->getMaterialGroup().set(material::RenderMode::Full, materialManager.getDustParticle());
   resize(materialManager, renderViewport, uiViewport, displayViewport, true);
 }
 
@@ -67,11 +89,25 @@ void RenderPipeline::worldCompositionPass(const std::vector<engine::world::Room>
   BOOST_ASSERT(m_worldCompositionPass != nullptr);
   m_worldCompositionPass->render(inWater);
 
+  if(m_renderSettings.dustActive)
   {
-    render::scene::RenderContext context{render::material::RenderMode::Full, std::nullopt};
+    static constexpr auto BaseGridAxisSubdivision = 12;
+    const auto spacing
+      = (std::cbrt(m_renderSettings.dustDensity) / BaseGridAxisSubdivision * 1_sectors).cast<float>().get();
+    const auto& material = m_dustMesh->getMaterialGroup().get(material::RenderMode::Full);
+    gsl_Assert(material != nullptr);
+    material->getUniform("u_spacing")->set(spacing);
+
+    scene::RenderContext context{material::RenderMode::Full, std::nullopt};
     for(const auto& room : rooms)
     {
-      if(!room.node->isVisible() || room.dust == nullptr)
+      if(!room.node->isVisible())
+        continue;
+
+      const glm::ivec3 cells{
+        glm::max(glm::floor((room.verticesBBoxMax - room.verticesBBoxMin) / spacing), glm::vec3{0.0f})};
+      const auto count = cells.x * cells.y * cells.z;
+      if(count == 0)
         continue;
 
       SOGLB_DEBUGGROUP(room.node->getName() + ":dust");
@@ -81,9 +117,12 @@ void RenderPipeline::worldCompositionPass(const std::vector<engine::world::Room>
       state.setScissorRegion(xy, size);
       context.pushState(state);
 
-      render::scene::Visitor visitor{context};
-      room.dust->accept(visitor);
-      visitor.render(std::nullopt);
+      material->getUniform("u_bboxMin")->set(room.verticesBBoxMin);
+      material->getUniform("u_cells")->set(glm::vec3{cells});
+      material->getUniform("u_baseColor")
+        ->set(room.isWaterRoom ? glm::vec3{0.146f, 0.485f, 0.216f} : glm::vec3{0.431f, 0.386f, 0.375f});
+      m_dustMesh->setVertexCount(count);
+      m_dustMesh->render(room.node.get(), context);
 
       context.popState();
     }
@@ -112,8 +151,7 @@ void RenderPipeline::updateCamera(const gslu::nn_shared<scene::Camera>& camera)
 
 void RenderPipeline::apply(const RenderSettings& renderSettings, material::MaterialManager& materialManager)
 {
-  m_renderSettings = renderSettings;
-  resize(materialManager, m_renderSize, m_uiSize, m_displaySize, true);
+  reconfigure(materialManager, renderSettings, m_renderSize, m_uiSize, m_displaySize, false);
 }
 
 void RenderPipeline::resize(material::MaterialManager& materialManager,
@@ -122,42 +160,79 @@ void RenderPipeline::resize(material::MaterialManager& materialManager,
                             const glm::ivec2& displayViewport,
                             bool force)
 {
-  if(!force && m_renderSize == renderViewport && m_uiSize == uiViewport && m_displaySize == displayViewport)
-  {
-    return;
-  }
+  reconfigure(materialManager, m_renderSettings, renderViewport, uiViewport, displayViewport, force);
+}
+
+void RenderPipeline::reconfigure(material::MaterialManager& materialManager,
+                                 const RenderSettings& renderSettings,
+                                 const glm::ivec2& renderViewport,
+                                 const glm::ivec2& uiViewport,
+                                 const glm::ivec2& displayViewport,
+                                 bool force)
+{
+  // a stage is rebuilt if its own inputs changed, or if a stage it reads from is rebuilt
+  const bool rebuildGeometry = force || m_geometryPass == nullptr || m_renderSize != renderViewport;
+  const bool rebuildComposition = rebuildGeometry || compositionSettingsDiffer(m_renderSettings, renderSettings);
+  const bool rebuildWorldEffects = rebuildComposition || worldEffectSettingsDiffer(m_renderSettings, renderSettings);
+  const bool rebuildUi = force || m_uiPass == nullptr || m_uiSize != uiViewport || m_displaySize != displayViewport;
+  const bool rebuildBackbuffer = force || m_backbuffer == nullptr || m_displaySize != displayViewport;
+  const bool rebuildBackbufferEffects
+    = rebuildBackbuffer || backbufferEffectSettingsDiffer(m_renderSettings, renderSettings);
 
+  m_renderSettings = renderSettings;
   m_renderSize = renderViewport;
   m_uiSize = uiViewport;
   m_displaySize = displayViewport;
 
-  m_geometryPass = std::make_shared<pass::GeometryPass>(m_renderSize);
-  m_portalPass = std::make_shared<pass::PortalPass>(materialManager, m_geometryPass->getDepthBuffer(), m_renderSize);
-  m_hbaoPass = std::make_shared<pass::HBAOPass>(materialManager, m_renderSize / 4, *m_geometryPass);
-  m_edgePass = std::make_shared<pass::EdgeDetectionPass>(materialManager, m_renderSize, *m_geometryPass);
-  m_worldCompositionPass = std::make_shared<pass::WorldCompositionPass>(
-    materialManager, m_renderSettings, m_renderSize, *m_geometryPass, *m_portalPass);
-  m_uiPass = std::make_shared<pass::UIPass>(materialManager, m_uiSize, m_displaySize);
-
-  m_backbufferTextureHandle = std::make_shared<gl::TextureHandle<gl::Texture2D<gl::SRGB8>>>(
-    gsl::make_shared<gl::Texture2D<gl::SRGB8>>(m_displaySize, "backbuffer-texture"),
-    gsl::make_unique<gl::Sampler>("backbuffer-sampler"));
-  m_backbuffer = gl::FrameBufferBuilder{}
-                   .texture(gl::api::FramebufferAttachment::ColorAttachment0, m_backbufferTextureHandle->getTexture())
-                   .build("backbuffer");
-
-  initWorldEffects(materialManager);
-  initBackbufferEffects(materialManager);
+  if(rebuildGeometry)
+  {
+    m_geometryPass = std::make_shared<pass::GeometryPass>(m_renderSize);
+    m_portalPass = std::make_shared<pass::PortalPass>(materialManager, m_geometryPass->getDepthBuffer(), m_renderSize);
+    m_hbaoPass = std::make_shared<pass::HBAOPass>(materialManager, m_renderSize / 4, *m_geometryPass);
+    m_edgePass = std::make_shared<pass::EdgeDetectionPass>(materialManager, m_renderSize, *m_geometryPass);
+  }
+
+  if(rebuildComposition)
+  {
+    m_worldCompositionPass = std::make_shared<pass::WorldCompositionPass>(
+      materialManager, m_renderSettings, m_renderSize, *m_geometryPass, *m_portalPass);
+  }
+
+  if(rebuildUi)
+  {
+    m_uiPass = std::make_shared<pass::UIPass>(materialManager, m_uiSize, m_displaySize);
+  }
+
+  if(rebuildBackbuffer)
+  {
+    m_backbufferTextureHandle = std::make_shared<gl::TextureHandle<gl::Texture2D<gl::SRGB8>>>(
+      gsl::make_shared<gl::Texture2D<gl::SRGB8>>(m_displaySize, "backbuffer-texture"),
+      gsl::make_unique<gl::Sampler>("backbuffer-sampler"));
+    m_backbuffer = gl::FrameBufferBuilder{}
+                     .texture(gl::api::FramebufferAttachment::ColorAttachment0, m_backbufferTextureHandle->getTexture())
+                     .build("backbuffer");
+  }
+
+  if(rebuildWorldEffects)
+    initWorldEffects(materialManager);
+  if(rebuildBackbufferEffects)
+    initBackbufferEffects(materialManager);
 }
 
 void RenderPipeline::initWorldEffects(material::MaterialManager& materialManager)
 {
-  m_effects.clear();
+  const auto previous = std::exchange(m_effects, {});
 
   auto fxSource = m_worldCompositionPass->getColorBuffer();
-  auto addEffect = [this, &fxSource](const std::string& name, const gslu::nn_shared<material::Material>& material)
+  auto addEffect
+    = [this, &previous, &fxSource](const std::string& name, const gslu::nn_shared<material::Material>& material)
   {
-    auto fx = std::make_shared<pass::EffectPass<gl::SRGB8>>(gsl::not_null{this}, "fx:" + name, material, fxSource);
+    // an effect reads the output of its predecessor, so it is only kept if all effects before it were kept, too
+    const auto fullName = "fx:" + name;
+    const auto idx = m_effects.size();
+    auto fx = idx < previous.size() && previous[idx]->isSameAs(fullName, material, fxSource)
+                ? previous[idx].get()
+                : std::make_shared<pass::EffectPass<gl::SRGB8>>(gsl::not_null{this}, fullName, material, fxSource);
     m_effects.emplace_back(fx);
     fxSource = fx->getOutput();
     return fx;
@@ -231,12 +306,17 @@ void RenderPipeline::initWorldEffects(material::MaterialManager& materialManager
 }
 void RenderPipeline::initBackbufferEffects(material::MaterialManager& materialManager)
 {
-  m_backbufferEffects.clear();
+  const auto previous = std::exchange(m_backbufferEffects, {});
 
   auto fxSource = gsl::not_null{m_backbufferTextureHandle};
-  auto addEffect = [this, &fxSource](const std::string& name, const gslu::nn_shared<material::Material>& material)
+  auto addEffect
+    = [this, &previous, &fxSource](const std::string& name, const gslu::nn_shared<material::Material>& material)
   {
-    auto fx = std::make_shared<pass::EffectPass<gl::SRGB8>>(gsl::not_null{this}, "postfx:" + name, material, fxSource);
+    const auto fullName = "postfx:" + name;
+    const auto idx = m_backbufferEffects.size();
+    auto fx = idx < previous.size() && previous[idx]->isSameAs(fullName, material, fxSource)
+                ? previous[idx].get()
+                : std::make_shared<pass::EffectPass<gl::SRGB8>>(gsl::not_null{this}, fullName, material, fxSource);
     m_backbufferEffects.emplace_back(fx);
     fxSource = fx->getOutput();
     return fx;
@@ -19,7 +19,8 @@ class MaterialManager;
 namespace render::scene
 {
 class Camera;
-}
+class ProceduralMesh;
+} // namespace render::scene
 
 namespace engine::world
 {
@@ -57,12 +58,21 @@ private:
   std::shared_ptr<pass::UIPass> m_uiPass;
   std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::SRGB8>>> m_backbufferTextureHandle;
   std::shared_ptr<gl::Framebuffer> m_backbuffer;
+  //! Shared by all rooms, the particles are generated from the room bounds.
+  gslu::nn_shared<scene::ProceduralMesh> m_dustMesh;
 
   std::vector<gslu::nn_shared<pass::EffectPass<gl::SRGB8>>> m_effects{};
   std::vector<gslu::nn_shared<pass::EffectPass<gl::SRGB8>>> m_backbufferEffects{};
 
   void initBackbufferEffects(material::MaterialManager& materialManager);
   void initWorldEffects(material::MaterialManager& materialManager);
+  //! Rebuilds only the passes, framebuffers and effects depending on a changed size or setting.
+  void reconfigure(material::MaterialManager& materialManager,
+                   const RenderSettings& renderSettings,
+                   const glm::ivec2& renderViewport,
+                   const glm::ivec2& uiViewport,
+                   const glm::ivec2& displayViewport,
+                   bool force);
 
 public:
   explicit RenderPipeline(material::MaterialManager& materialManager,
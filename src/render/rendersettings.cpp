@@ -36,6 +36,8 @@ void RenderSettings::serialize(const serialization::Serializer<engine::EngineCon
       S_NVO("anisotropyActive", anisotropyActive),
       S_NVO("renderResolutionDivisor", renderResolutionDivisor),
       S_NVO("renderResolutionDivisorActive", renderResolutionDivisorActive),
+      S_NVO("adaptiveResolutionMinPercent", adaptiveResolutionMinPercent),
+      S_NVO("adaptiveResolutionActive", adaptiveResolutionActive),
       S_NVO("uiScaleMultiplier", uiScaleMultiplier),
       S_NVO("uiScaleActive", uiScaleActive),
       S_NVO("muzzleFlashLight", muzzleFlashLight),
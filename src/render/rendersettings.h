@@ -43,6 +43,9 @@ struct RenderSettings
   bool highQualityShadows = true;
   uint8_t renderResolutionDivisor = 2;
   bool renderResolutionDivisorActive = false;
+  //! Lower bound of the world render resolution when it adapts to the frame time, in percent.
+  uint8_t adaptiveResolutionMinPercent = 50;
+  bool adaptiveResolutionActive = false;
   uint8_t uiScaleMultiplier = 2;
   bool uiScaleActive = false;
   bool lightingModeActive = true;
@@ -56,6 +56,13 @@ void CSM::Split::init(int32_t resolution, size_t idx, material::MaterialManager&
         .textureNoBlend(gl::api::FramebufferAttachment::DepthAttachment, depthTextureHandle->getTexture())
         .build("csm-split-fb/" + std::to_string(idx));
 
+  staticDepthTexture = std::make_shared<gl::TextureDepth<float>>(glm::ivec2{resolution, resolution},
+                                                                 "csm-texture/" + std::to_string(idx) + "/static");
+  staticDepthFramebuffer
+    = gl::FrameBufferBuilder()
+        .textureNoBlend(gl::api::FramebufferAttachment::DepthAttachment, gsl::not_null{staticDepthTexture})
+        .build("csm-split-fb/" + std::to_string(idx) + "/static");
+
   squaredTextureHandle = std::make_shared<gl::TextureHandle<gl::Texture2D<gl::RG16F>>>(
     gsl::make_shared<gl::Texture2D<gl::RG16F>>(glm::ivec2{resolution, resolution},
                                                "csm-texture/" + std::to_string(idx) + "/squared"),
@@ -245,6 +252,53 @@ void CSM::updateCamera(const Camera& camera)
   }
 }
 
+bool CSM::intersectsActiveSplit(const glm::mat4& modelMatrix, const glm::vec3& bboxMin, const glm::vec3& bboxMax) const
+{
+  const auto mvp = getActiveMatrix(modelMatrix);
+  glm::vec2 clipMin{std::numeric_limits<float>::max()};
+  glm::vec2 clipMax{std::numeric_limits<float>::lowest()};
+  for(int i = 0; i < 8; ++i)
+  {
+    const glm::vec3 corner{(i & 1) != 0 ? bboxMax.x : bboxMin.x,
+                           (i & 2) != 0 ? bboxMax.y : bboxMin.y,
+                           (i & 4) != 0 ? bboxMax.z : bboxMin.z};
+    // the projection is orthographic, so there's no need to divide by w
+    const auto clip = glm::vec2{mvp * glm::vec4{corner, 1.0f}};
+    clipMin = glm::min(clipMin, clip);
+    clipMax = glm::max(clipMax, clip);
+  }
+
+  // depth is clamped, so casters in front of or behind the split still need to be rendered
+  return clipMin.x <= 1.0f && clipMax.x >= -1.0f && clipMin.y <= 1.0f && clipMax.y >= -1.0f;
+}
+
+bool CSM::updateActiveStaticCasters(const std::vector<const Node*>& casters)
+{
+  auto& split = m_splits.at(m_activeSplit);
+  if(split.staticVpMatrix == split.vpMatrix && split.staticCasters == casters)
+    return false;
+
+  split.staticVpMatrix = split.vpMatrix;
+  split.staticCasters = casters;
+  split.staticDepthTexture->clear(gl::ScalarDepth{1.0f});
+  return true;
+}
+
+void CSM::restoreActiveStaticDepth()
+{
+  const auto& split = m_splits.at(m_activeSplit);
+  split.depthTextureHandle->getTexture()->copyFrom(*split.staticDepthTexture);
+}
+
+void CSM::invalidateStaticDepth()
+{
+  for(auto& split : m_splits)
+  {
+    split.staticVpMatrix.reset();
+    split.staticCasters.clear();
+  }
+}
+
 void CSM::renderSquare()
 {
   GL_ASSERT(gl::api::memoryBarrier(gl::api::MemoryBarrierMask::AllBarrierBits));
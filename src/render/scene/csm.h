@@ -16,6 +16,8 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace render::material
 {
@@ -27,6 +29,7 @@ namespace render::scene
 {
 class Camera;
 class Mesh;
+class Node;
 
 template<typename PixelT>
 class SeparableBlur;
@@ -57,6 +60,12 @@ public:
     mutable std::unique_ptr<gl::FenceSync> squareSync;
     mutable std::unique_ptr<gl::FenceSync> blurSync;
 
+    //! Depth of all static casters, only re-rendered if the casters or the split's bounds change.
+    std::shared_ptr<gl::TextureDepth<float>> staticDepthTexture;
+    std::shared_ptr<gl::Framebuffer> staticDepthFramebuffer{};
+    std::optional<glm::mat4> staticVpMatrix{};
+    std::vector<const Node*> staticCasters{};
+
     void init(int32_t resolution, size_t idx, material::MaterialManager& materialManager);
     void renderSquare();
     void renderBlur();
@@ -127,6 +136,28 @@ public:
     m_activeSplit = idx;
   }
 
+  //! Checks whether a box in model space may cast shadows into the active split.
+  [[nodiscard]] bool intersectsActiveSplit(const glm::mat4& modelMatrix,
+                                           const glm::vec3& bboxMin,
+                                           const glm::vec3& bboxMax) const;
+
+  /**
+   * Updates the static casters of the active split, and returns true if its static depth layer needs to be
+   * re-rendered into the framebuffer returned by getActiveStaticFramebuffer().
+   */
+  [[nodiscard]] bool updateActiveStaticCasters(const std::vector<const Node*>& casters);
+
+  [[nodiscard]] const auto& getActiveStaticFramebuffer() const
+  {
+    return m_splits.at(m_activeSplit).staticDepthFramebuffer;
+  }
+
+  //! Initializes the depth of the active split with its static depth layer.
+  void restoreActiveStaticDepth();
+
+  //! Forces all static depth layers to be re-rendered, e.g. because the scene was replaced.
+  void invalidateStaticDepth();
+
   void updateCamera(const Camera& camera);
 
   gl::UniformBuffer<CSMBuffer>& getBuffer(const glm::mat4& modelMatrix);
@@ -0,0 +1,77 @@
+#include "frustumculler.h"
+
+#include "node.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <initializer_list>
+
+namespace render::scene
+{
+FrustumCuller::FrustumCuller(const glm::mat4& viewProjection)
+{
+  // extract the clip planes from the rows of the matrix, see Gribb/Hartmann, "Fast Extraction of Viewing Frustum
+  // Planes from the World-View-Projection Matrix"
+  const auto row = [&viewProjection](glm::length_t i)
+  {
+    return glm::vec4{viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]};
+  };
+
+  m_planes = {row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1)};
+  for(auto& plane : m_planes)
+    plane /= glm::length(glm::vec3{plane});
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void FrustumCuller::gather(const Node& node)
+{
+  if(!node.isVisible())
+    return;
+
+  if(const auto sphere = node.getBoundingSphere(); sphere.has_value())
+  {
+    const auto& m = node.getModelMatrix();
+    const auto center = glm::vec3{m * glm::vec4{sphere->center, 1.0f}};
+    const auto scale
+      = std::max({glm::length(glm::vec3{m[0]}), glm::length(glm::vec3{m[1]}), glm::length(glm::vec3{m[2]})});
+
+    m_nodes.emplace_back(&node);
+    m_centerX.emplace_back(center.x);
+    m_centerY.emplace_back(center.y);
+    m_centerZ.emplace_back(center.z);
+    m_radius.emplace_back(sphere->radius * scale);
+  }
+
+  for(const auto& child : node.getChildren())
+    gather(*child);
+}
+
+void FrustumCuller::cull()
+{
+  const auto n = m_nodes.size();
+  m_visible.assign(n, 1);
+  for(const auto& plane : m_planes)
+  {
+    for(size_t i = 0; i < n; ++i)
+    {
+      const auto distance = plane.x * m_centerX[i] + plane.y * m_centerY[i] + plane.z * m_centerZ[i] + plane.w;
+      m_visible[i] &= static_cast<uint8_t>(distance >= -m_radius[i]);
+    }
+  }
+
+  m_culled.clear();
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(m_visible[i] == 0)
+      m_culled.emplace_back(m_nodes[i]);
+  }
+  std::sort(m_culled.begin(), m_culled.end());
+}
+
+bool FrustumCuller::isCulled(const Node& node) const
+{
+  return std::binary_search(m_culled.begin(), m_culled.end(), &node);
+}
+} // namespace render::scene
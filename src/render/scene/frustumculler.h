@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace render::scene
+{
+class Node;
+
+/**
+ * Culls the bounding spheres of a whole scene graph against a view frustum at once.
+ *
+ * The spheres are gathered into contiguous arrays first, so that each frustum plane is tested against all of them in
+ * a single tight loop instead of testing node by node while traversing the graph. Only the side planes are tested,
+ * as the depth range may be clamped.
+ */
+class FrustumCuller final
+{
+public:
+  explicit FrustumCuller(const glm::mat4& viewProjection);
+
+  //! Collects the bounding spheres of a node and its visible descendants in world space.
+  void gather(const Node& node);
+
+  //! Tests all gathered spheres against the frustum; must be called after gathering and before querying.
+  void cull();
+
+  [[nodiscard]] bool isCulled(const Node& node) const;
+
+private:
+  std::array<glm::vec4, 4> m_planes{};
+
+  std::vector<const Node*> m_nodes;
+  std::vector<float> m_centerX;
+  std::vector<float> m_centerY;
+  std::vector<float> m_centerZ;
+  std::vector<float> m_radius;
+  std::vector<uint8_t> m_visible;
+
+  //! Sorted for lookup while visiting.
+  std::vector<const Node*> m_culled;
+};
+} // namespace render::scene
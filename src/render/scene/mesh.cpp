@@ -95,4 +95,16 @@ void Mesh::render(const Node* node, RenderContext& context, gl::api::core::SizeT
   context.popState();
   context.popState();
 }
+
+ProceduralMesh::~ProceduralMesh() = default;
+
+void ProceduralMesh::drawIndexBuffer()
+{
+  m_vao->drawArrays(getPrimitiveType(), m_vertexCount);
+}
+
+void ProceduralMesh::drawIndexBuffer(gl::api::core::SizeType instanceCount)
+{
+  m_vao->drawArrays(getPrimitiveType(), m_vertexCount, instanceCount);
+}
 } // namespace render::scene
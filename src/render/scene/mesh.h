@@ -10,6 +10,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -84,20 +85,64 @@ public:
   MeshImpl& operator=(MeshImpl&&) = delete;
   MeshImpl& operator=(const MeshImpl&) = delete;
 
+  //! Limits drawing to the first indices of the index buffer, e.g. if the buffer has spare capacity.
+  void setIndexCount(const std::optional<gl::api::core::SizeType>& indexCount) noexcept
+  {
+    m_indexCount = indexCount;
+  }
+
 private:
   gslu::nn_shared<gl::VertexArray<IndexT, VertexTs...>> m_vao;
+  std::optional<gl::api::core::SizeType> m_indexCount;
 
   void drawIndexBuffer() override
   {
-    m_vao->drawIndexBuffer(getPrimitiveType());
+    if(m_indexCount.has_value())
+      m_vao->drawIndexBufferBaseVertex(getPrimitiveType(), *m_indexCount, 0);
+    else
+      m_vao->drawIndexBuffer(getPrimitiveType());
   }
 
   void drawIndexBuffer(gl::api::core::SizeType instanceCount) override
   {
-    m_vao->drawIndexBuffer(getPrimitiveType(), instanceCount);
+    if(m_indexCount.has_value())
+      m_vao->drawIndexBufferBaseVertex(getPrimitiveType(), *m_indexCount, 0, instanceCount);
+    else
+      m_vao->drawIndexBuffer(getPrimitiveType(), instanceCount);
   }
 };
 
+//! A mesh without vertex data, its vertices are generated in the shaders from gl_VertexID.
+class ProceduralMesh final : public Mesh
+{
+public:
+  explicit ProceduralMesh(gslu::nn_shared<gl::AttributelessVertexArray> vao,
+                          gl::api::PrimitiveType primitiveType = gl::api::PrimitiveType::Points)
+      : Mesh{primitiveType}
+      , m_vao{std::move(vao)}
+  {
+  }
+
+  ~ProceduralMesh() override;
+
+  ProceduralMesh(const ProceduralMesh&) = delete;
+  ProceduralMesh(ProceduralMesh&&) = delete;
+  ProceduralMesh& operator=(ProceduralMesh&&) = delete;
+  ProceduralMesh& operator=(const ProceduralMesh&) = delete;
+
+  void setVertexCount(gl::api::core::SizeType vertexCount) noexcept
+  {
+    m_vertexCount = vertexCount;
+  }
+
+private:
+  gslu::nn_shared<gl::AttributelessVertexArray> m_vao;
+  gl::api::core::SizeType m_vertexCount = 0;
+
+  void drawIndexBuffer() override;
+  void drawIndexBuffer(gl::api::core::SizeType instanceCount) override;
+};
+
 extern gslu::nn_shared<Mesh> createScreenQuad(const glm::vec2& xy,
                                               const glm::vec2& size,
                                               const std::shared_ptr<material::Material>& material,
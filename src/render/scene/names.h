@@ -8,15 +8,13 @@
 #define VERTEX_ATTRIBUTE_COLOR_BOTTOM_LEFT_NAME "a_colorBottomLeft"
 #define VERTEX_ATTRIBUTE_COLOR_BOTTOM_RIGHT_NAME "a_colorBottomRight"
 #define VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME "a_texCoord"
+#define VERTEX_ATTRIBUTE_TEXTURE_INDEX_NAME "a_textureIndex"
 #define VERTEX_ATTRIBUTE_BONE_INDEX_NAME "a_boneIndex"
 
-#define VERTEX_ATTRIBUTE_IS_QUAD "a_isQuad"
-#define VERTEX_ATTRIBUTE_QUAD_VERT1 "a_quadVert1"
-#define VERTEX_ATTRIBUTE_QUAD_VERT2 "a_quadVert2"
-#define VERTEX_ATTRIBUTE_QUAD_VERT3 "a_quadVert3"
-#define VERTEX_ATTRIBUTE_QUAD_VERT4 "a_quadVert4"
+#define VERTEX_ATTRIBUTE_QUAD_INDEX "a_quadIndex"
 #define VERTEX_ATTRIBUTE_QUAD_UV12 "a_quadUv12"
 #define VERTEX_ATTRIBUTE_QUAD_UV34 "a_quadUv34"
+#define VERTEX_ATTRIBUTE_ANIMATED_TILE "a_animatedTile"
 
 #define VERTEX_ATTRIBUTE_REFLECTIVE_NAME "a_reflective"
 #define VERTEX_ATTRIBUTE_MODEL_MATRIX_NAME "a_modelMatrix"
@@ -25,12 +25,14 @@ Node::~Node()
   m_parent.reset();
 
   transformChanged();
+  m_transformBuffer->release(m_transformSlot);
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
 void Node::transformChanged()
 {
   m_dirty = true;
+  m_transformBuffer->invalidate(m_transformSlot);
 
   for(const auto& child : m_children)
   {
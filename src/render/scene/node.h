@@ -1,19 +1,22 @@
 #pragma once
 
 #include "render/material/materialparameteroverrider.h"
+#include "transformbuffer.h"
 
 #include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/throw_exception.hpp>
-#include <gl/buffer.h>
+#include <cstdint>
 #include <gl/renderstate.h>
 #include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -30,6 +33,19 @@ struct Transform
   glm::mat4 modelMatrix{1.0f};
 };
 
+//! A sphere enclosing the geometry of a node, relative to the node's model matrix.
+struct BoundingSphere
+{
+  glm::vec3 center{0.0f};
+  float radius = 0;
+
+  //! Creates the sphere enclosing the box spanned by two opposite corners.
+  [[nodiscard]] static BoundingSphere fromCorners(const glm::vec3& a, const glm::vec3& b)
+  {
+    return BoundingSphere{(a + b) / 2.0f, glm::distance(a, b) / 2.0f};
+  }
+};
+
 class Node : public material::MaterialParameterOverrider
 {
 public:
@@ -42,7 +58,8 @@ public:
 
   explicit Node(std::string name)
       : m_name{std::move(name)}
-      , m_transformBuffer{m_name + "-transform-ubo", gl::api::BufferUsage::StreamDraw, m_transform}
+      , m_transformBuffer{TransformBuffer::getInstance()}
+      , m_transformSlot{m_transformBuffer->allocate(*this)}
   {
   }
 
@@ -76,7 +93,6 @@ public:
 
     m_dirty = false;
 
-    const auto old = m_transform.modelMatrix;
     if(const auto p = getParent().lock())
     {
       m_transform.modelMatrix = p->getModelMatrix() * m_localMatrix;
@@ -85,7 +101,6 @@ public:
     {
       m_transform.modelMatrix = m_localMatrix;
     }
-    m_bufferDirty |= m_transform.modelMatrix != old;
     return m_transform.modelMatrix;
   }
 
@@ -149,20 +164,27 @@ public:
     return *it;
   }
 
+  //! Returns the buffer containing the model matrices of all nodes, with all pending changes uploaded.
   [[nodiscard]] const auto& getTransformBuffer() const
   {
-    (void)getModelMatrix(); // update data if dirty
-    if(!m_bufferDirty)
-      return m_transformBuffer;
+    return m_transformBuffer->getBuffer();
+  }
+
+  //! The index of this node's model matrix within the transform buffer.
+  [[nodiscard]] auto getTransformIndex() const
+  {
+    return m_transformSlot;
+  }
 
-    m_bufferDirty = false;
-    m_transformBuffer.setSubData(m_transform, 0);
-    return m_transformBuffer;
+  //! Returns the bounds used for frustum culling; nodes without bounds are never culled.
+  [[nodiscard]] virtual std::optional<BoundingSphere> getBoundingSphere() const
+  {
+    return m_boundingSphere;
   }
 
-  [[nodiscard]] virtual bool canBeCulled(const glm::mat4& /*viewProjection*/) const
+  void setBoundingSphere(const std::optional<BoundingSphere>& boundingSphere)
   {
-    return false;
+    m_boundingSphere = boundingSphere;
   }
 
   void clear()
@@ -243,11 +265,12 @@ private:
   std::shared_ptr<Renderable> m_renderable = nullptr;
   glm::mat4 m_localMatrix{1.0f};
   gl::RenderState m_renderState;
+  std::optional<BoundingSphere> m_boundingSphere;
 
   mutable bool m_dirty = false;
-  mutable bool m_bufferDirty = true;
   mutable Transform m_transform{};
-  mutable gl::UniformBuffer<Transform> m_transformBuffer;
+  const gslu::nn_shared<TransformBuffer> m_transformBuffer;
+  const uint32_t m_transformSlot;
 
   std::vector<std::tuple<glm::vec2, glm::vec2>> m_scissors;
 
@@ -1,6 +1,7 @@
 #include "renderer.h"
 
 #include "camera.h"
+#include "frustumculler.h"
 #include "node.h"
 #include "render/material/rendermode.h"
 #include "rendercontext.h"
@@ -29,8 +30,12 @@ Renderer::~Renderer() = default;
 
 void Renderer::render()
 {
+  FrustumCuller culler{m_camera->getViewProjectionMatrix()};
+  culler.gather(*m_rootNode);
+  culler.cull();
+
   RenderContext context{material::RenderMode::Full, std::nullopt};
-  Visitor visitor{context};
+  Visitor visitor{context, true, &culler};
   m_rootNode->accept(visitor);
   visitor.render(m_camera->getPosition());
 }
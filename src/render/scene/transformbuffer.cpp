@@ -0,0 +1,96 @@
+#include "transformbuffer.h"
+
+#include "node.h"
+
+#include <algorithm>
+#include <gl/api/gl.hpp>
+#include <gsl/gsl-lite.hpp>
+
+namespace render::scene
+{
+TransformBuffer::~TransformBuffer() = default;
+
+gslu::nn_shared<TransformBuffer> TransformBuffer::getInstance()
+{
+  static std::weak_ptr<TransformBuffer> instance;
+  if(auto tmp = instance.lock())
+    return gsl::not_null{tmp};
+
+  auto tmp = gsl::make_shared<TransformBuffer>();
+  instance = tmp.get();
+  return tmp;
+}
+
+uint32_t TransformBuffer::allocate(const Node& node)
+{
+  uint32_t slot;
+  if(!m_freeSlots.empty())
+  {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    m_nodes[slot] = &node;
+  }
+  else
+  {
+    slot = gsl::narrow<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back(&node);
+    m_matrices.emplace_back(1.0f);
+    m_pending.emplace_back(false);
+  }
+
+  invalidate(slot);
+  return slot;
+}
+
+void TransformBuffer::release(const uint32_t slot)
+{
+  gsl_Expects(slot < m_nodes.size() && m_nodes[slot] != nullptr);
+  // a pending entry of this slot is skipped while flushing, or taken over by the next node allocating the slot
+  m_nodes[slot] = nullptr;
+  m_freeSlots.emplace_back(slot);
+}
+
+void TransformBuffer::invalidate(const uint32_t slot)
+{
+  gsl_Expects(slot < m_pending.size());
+  if(m_pending[slot])
+    return;
+
+  m_pending[slot] = true;
+  m_pendingSlots.emplace_back(slot);
+}
+
+const gl::ShaderStorageBuffer<glm::mat4>& TransformBuffer::getBuffer()
+{
+  flush();
+  return *m_buffer;
+}
+
+void TransformBuffer::flush()
+{
+  // resolve in slot order, so that the matrices are written front to back
+  std::sort(m_pendingSlots.begin(), m_pendingSlots.end());
+  for(const auto slot : m_pendingSlots)
+  {
+    m_pending[slot] = false;
+    if(const auto* node = m_nodes[slot])
+      m_matrices[slot] = node->getModelMatrix();
+  }
+
+  if(m_buffer == nullptr || m_buffer->size() < m_matrices.size())
+  {
+    m_buffer = std::make_unique<gl::ShaderStorageBuffer<glm::mat4>>(
+      "node-transforms-ssb", gl::api::BufferUsage::DynamicDraw, std::max(MinCapacity, 2 * m_matrices.size()));
+    m_buffer->setSubData(m_matrices, 0);
+  }
+  else if(!m_pendingSlots.empty())
+  {
+    const auto first = m_pendingSlots.front();
+    const auto count = m_pendingSlots.back() + 1 - first;
+    m_buffer->setSubData(gsl::span<const glm::mat4>{m_matrices}.subspan(first, count),
+                         gsl::narrow<gl::api::core::SizeType>(first));
+  }
+
+  m_pendingSlots.clear();
+}
+} // namespace render::scene
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <gl/buffer.h>
+#include <glm/mat4x4.hpp>
+#include <gslu.h>
+#include <memory>
+#include <vector>
+
+namespace render::scene
+{
+class Node;
+
+/**
+ * Holds the model matrices of all nodes in a single shader storage buffer.
+ *
+ * Every node owns a slot in the buffer for its whole lifetime, and shaders fetch its matrix by that slot. Nodes only
+ * mark their slot as pending when their transform changes; the first time the buffer is bound, all pending matrices
+ * are resolved in one pass and uploaded with a single call. Unless a node changes while the frame is being drawn, the
+ * buffer is thus uploaded at most once per frame, instead of once per node.
+ */
+class TransformBuffer final
+{
+public:
+  TransformBuffer(const TransformBuffer&) = delete;
+  TransformBuffer(TransformBuffer&&) = delete;
+  TransformBuffer& operator=(const TransformBuffer&) = delete;
+  TransformBuffer& operator=(TransformBuffer&&) = delete;
+
+  TransformBuffer() = default;
+  ~TransformBuffer();
+
+  //! Returns the buffer shared by all nodes, which lives as long as any node references it.
+  [[nodiscard]] static gslu::nn_shared<TransformBuffer> getInstance();
+
+  [[nodiscard]] uint32_t allocate(const Node& node);
+  void release(uint32_t slot);
+  void invalidate(uint32_t slot);
+
+  //! Uploads all pending matrices, and returns the buffer.
+  [[nodiscard]] const gl::ShaderStorageBuffer<glm::mat4>& getBuffer();
+
+private:
+  static constexpr size_t MinCapacity = 1024;
+
+  void flush();
+
+  std::vector<const Node*> m_nodes;
+  std::vector<glm::mat4> m_matrices;
+  std::vector<uint32_t> m_freeSlots;
+  std::vector<uint32_t> m_pendingSlots;
+  std::vector<bool> m_pending;
+  std::unique_ptr<gl::ShaderStorageBuffer<glm::mat4>> m_buffer;
+};
+} // namespace render::scene
@@ -1,5 +1,6 @@
 #include "visitor.h"
 
+#include "frustumculler.h"
 #include "node.h"
 #include "renderable.h"
 #include "rendercontext.h"
@@ -19,8 +20,6 @@ void Visitor::visit(const Node& node)
 {
   if(!node.isVisible())
     return;
-  if(const auto& vp = m_context.getViewProjection(); vp.has_value() && node.canBeCulled(vp.value()))
-    return;
 
   m_context.pushState(node.getRenderState());
   node.accept(*this);
@@ -29,7 +28,8 @@ void Visitor::visit(const Node& node)
 
 void Visitor::add(const gsl::not_null<const Node*>& node)
 {
-  if(node->getRenderable() != nullptr)
+  // culling only applies to the node's own geometry, as children may extend beyond its bounds
+  if(node->getRenderable() != nullptr && (m_culler == nullptr || !m_culler->isCulled(*node)))
     m_nodes.emplace_back(node, m_context.getCurrentState());
 }
 
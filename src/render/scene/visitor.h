@@ -11,13 +11,15 @@ namespace render::scene
 {
 class RenderContext;
 class Node;
+class FrustumCuller;
 
 class Visitor
 {
 public:
-  explicit Visitor(RenderContext& context, bool withScissors = true)
+  explicit Visitor(RenderContext& context, bool withScissors = true, const FrustumCuller* culler = nullptr)
       : m_context{context}
       , m_withScissors{withScissors}
+      , m_culler{culler}
   {
   }
 
@@ -47,6 +49,7 @@ public:
 private:
   RenderContext& m_context;
   const bool m_withScissors;
+  const FrustumCuller* const m_culler;
   using RenderableInfo = std::tuple<gsl::not_null<const Node*>, gl::RenderState>;
   mutable std::vector<RenderableInfo> m_nodes;
 };
@@ -4,23 +4,25 @@
 #include "loader/file/datatypes.h"
 #include "loader/file/texture.h"
 
-#include <array>
+#include <boost/assert.hpp>
 #include <gl/api/gl.hpp>
-#include <gl/vertexbuffer.h>
+#include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <utility>
 
 namespace render
 {
-TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
+TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data, const std::vector<engine::world::AtlasTile>& tiles)
 {
   Expects(!data.empty());
 
   const uint16_t* ptr = data.data();
   const auto sequenceCount = *ptr++;
+  size_t slotCount = 0;
   for(size_t i = 0; i < sequenceCount; ++i)
   {
     Sequence sequence;
+    sequence.firstSlot = slotCount;
     const auto n = *ptr++;
     sequence.tileIds.reserve(n + 1);
     for(size_t j = 0; j <= n; ++j)
@@ -28,34 +30,48 @@ TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
       gsl_Assert(ptr <= &data.back());
       const auto tileId = *ptr++;
       sequence.tileIds.emplace_back(tileId);
-      m_sequenceByTileId.emplace(tileId, m_sequences.size());
+      m_slotByTileId.emplace(tileId, gsl::narrow<glm::uint32>(slotCount + j));
     }
+    slotCount += sequence.tileIds.size();
     m_sequences.emplace_back(std::move(sequence));
   }
 
   BOOST_ASSERT(ptr == &data.back() + 1);
+
+  m_animatedTiles.resize(slotCount);
+  updateAnimatedTiles(tiles);
+  m_buffer = std::make_shared<gl::ShaderStorageBuffer<AnimatedTile>>(
+    "animated-tiles", gl::api::BufferUsage::DynamicDraw, m_animatedTiles);
 }
 
-void TextureAnimator::Sequence::updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer,
-                                                  const std::vector<engine::world::AtlasTile>& tiles)
+void TextureAnimator::advance(const std::vector<engine::world::AtlasTile>& tiles)
 {
-  BOOST_ASSERT(!tileIds.empty());
-
-  auto uvArray
-    = buffer.map(gl::api::MapBufferAccessMask::MapWriteBit | gl::api::MapBufferAccessMask::MapFlushExplicitBit);
+  if(m_animatedTiles.empty())
+    return;
 
-  for(const VertexReference& vref : affectedVertices)
+  for(auto& sequence : m_sequences)
   {
-    BOOST_ASSERT(buffer.size() > 0 && vref.bufferIndex < static_cast<size_t>(buffer.size()));
-    BOOST_ASSERT(vref.queueOffset < tileIds.size());
-    const engine::world::AtlasTile& tile = tiles[tileIds[vref.queueOffset].get()];
-
-    uvArray[vref.bufferIndex].uv
-      = glm::vec3{tile.uvCoordinates[vref.sourceIndex], tile.textureKey.tileAndFlag & loader::file::TextureIndexMask};
-    uvArray[vref.bufferIndex].quadUv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
-    uvArray[vref.bufferIndex].quadUv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+    BOOST_ASSERT(!sequence.tileIds.empty());
+    sequence.offset = (sequence.offset + 1) % sequence.tileIds.size();
   }
 
-  uvArray.flush();
+  updateAnimatedTiles(tiles);
+  m_buffer->setSubData(m_animatedTiles, 0);
+}
+
+void TextureAnimator::updateAnimatedTiles(const std::vector<engine::world::AtlasTile>& tiles)
+{
+  for(const auto& sequence : m_sequences)
+  {
+    for(size_t i = 0; i < sequence.tileIds.size(); ++i)
+    {
+      const auto& tile = tiles.at(sequence.tileIds[(i + sequence.offset) % sequence.tileIds.size()].get());
+      auto& animatedTile = m_animatedTiles[sequence.firstSlot + i];
+      animatedTile.uv12 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
+      animatedTile.uv34 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+      animatedTile.textureIndex
+        = static_cast<glm::float32>(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask);
+    }
+  }
 }
 } // namespace render
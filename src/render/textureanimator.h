@@ -2,20 +2,19 @@
 
 #include "core/id.h"
 
-#include <algorithm>
-#include <boost/assert.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <gl/soglb_fwd.h>
+#include <gl/buffer.h>
 #include <glm/ext/scalar_int_sized.hpp>
+#include <glm/ext/scalar_uint_sized.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
-#include <iterator>
+#include <gslu.h>
 #include <map>
 #include <memory>
-#include <set>
+#include <optional>
 #include <vector>
 
 namespace engine::world
@@ -30,88 +29,74 @@ struct AnimatedUV
   glm::vec3 uv{0, 0, -1};
   glm::vec4 quadUv12{};
   glm::vec4 quadUv34{};
+  //! 1 + 4 * slot + corner of the animated tile in TextureAnimator's buffer, or 0 if the tile is not animated.
+  glm::uint32 animatedTile{0};
 
   explicit AnimatedUV() = default;
-  explicit AnimatedUV(glm::int32 index, const glm::vec2& uv, const glm::vec4& quadUv12, const glm::vec4& quadUv34)
+  explicit AnimatedUV(glm::int32 index,
+                      const glm::vec2& uv,
+                      const glm::vec4& quadUv12,
+                      const glm::vec4& quadUv34,
+                      glm::uint32 animatedTile = 0)
       : uv{uv, index}
       , quadUv12{quadUv12}
       , quadUv34{quadUv34}
+      , animatedTile{animatedTile}
   {
   }
 };
 
+//! The current texture coordinates of an animated tile, see animated_tiles.glsl.
+struct AnimatedTile
+{
+  glm::vec4 uv12{0.0f};
+  glm::vec4 uv34{0.0f};
+  glm::float32 textureIndex = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+  glm::float32 _pad[3]{0.0f, 0.0f, 0.0f};
+};
+static_assert(sizeof(AnimatedTile) == 48, "Invalid AnimatedTile struct size");
+
+/**
+ * Animates the tiles of all rooms of a level.
+ *
+ * Each tile taking part in an animation has a slot in a table of animated tiles. Vertices reference their tile's slot
+ * instead of storing its texture coordinates, so that advancing the animations only needs to upload the table.
+ */
 class TextureAnimator
 {
 public:
-  explicit TextureAnimator(const std::vector<uint16_t>& data);
+  explicit TextureAnimator(const std::vector<uint16_t>& data, const std::vector<engine::world::AtlasTile>& tiles);
 
-  void registerVertex(const core::TextureTileId& tileId, const int sourceIndex, const size_t bufferIndex)
+  //! The slot of @p tileId in the animated tiles, if it takes part in an animation.
+  [[nodiscard]] std::optional<glm::uint32> getSlot(const core::TextureTileId& tileId) const
   {
-    auto it = m_sequenceByTileId.find(tileId);
-    if(it == m_sequenceByTileId.end())
-      return;
-
-    m_sequences.at(it->second).registerVertex(Sequence::VertexReference(bufferIndex, sourceIndex), tileId);
+    if(const auto it = m_slotByTileId.find(tileId); it != m_slotByTileId.end())
+      return it->second;
+    return std::nullopt;
   }
 
-  void updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer, const std::vector<engine::world::AtlasTile>& tiles)
+  //! Advances all animations by one step.
+  void advance(const std::vector<engine::world::AtlasTile>& tiles);
+
+  [[nodiscard]] gslu::nn_shared<gl::ShaderStorageBuffer<AnimatedTile>> getBuffer() const
   {
-    for(Sequence& sequence : m_sequences)
-    {
-      sequence.rotate();
-      sequence.updateCoordinates(buffer, tiles);
-    }
+    return gsl::not_null{m_buffer};
   }
 
 private:
   struct Sequence
   {
-    struct VertexReference
-    {
-      //! Vertex buffer index
-      const size_t bufferIndex;
-      const int sourceIndex;
-      size_t queueOffset = 0;
-
-      VertexReference(const size_t bufferIdx, const int sourceIdx)
-          : bufferIndex(bufferIdx)
-          , sourceIndex(sourceIdx)
-      {
-        Expects(sourceIdx >= 0 && sourceIdx < 4);
-      }
-
-      bool operator<(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex < rhs.bufferIndex;
-      }
-
-      bool operator==(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex == rhs.bufferIndex;
-      }
-    };
-
     std::vector<core::TextureTileId> tileIds;
-    std::set<VertexReference> affectedVertices;
-
-    void rotate()
-    {
-      BOOST_ASSERT(!tileIds.empty());
-      std::rotate(tileIds.begin(), std::next(tileIds.begin()), tileIds.end());
-    }
-
-    void registerVertex(VertexReference vertex, const core::TextureTileId& tileId)
-    {
-      const auto it = std::find(tileIds.begin(), tileIds.end(), tileId);
-      gsl_Assert(it != tileIds.end());
-      vertex.queueOffset = std::distance(tileIds.begin(), it);
-      affectedVertices.insert(vertex);
-    }
-
-    void updateCoordinates(gl::VertexBuffer<AnimatedUV>& buffer, const std::vector<engine::world::AtlasTile>& tiles);
+    size_t firstSlot = 0;
+    size_t offset = 0;
   };
 
   std::vector<Sequence> m_sequences;
-  std::map<core::TextureTileId, size_t> m_sequenceByTileId;
+  std::map<core::TextureTileId, glm::uint32> m_slotByTileId;
+  std::vector<AnimatedTile> m_animatedTiles;
+  std::shared_ptr<gl::ShaderStorageBuffer<AnimatedTile>> m_buffer;
+
+  void updateAnimatedTiles(const std::vector<engine::world::AtlasTile>& tiles);
 };
 } // namespace render
@@ -111,6 +111,22 @@ public:
   {
   }
 
+  //! Creates immutable storage, e.g. for persistently mapped buffers.
+  explicit Buffer(const std::string_view& label,
+                  const api::core::Bitfield<api::BufferStorageMask>& storageFlags,
+                  size_t size)
+      : BindableResource{api::createBuffers,
+                         [](const uint32_t handle)
+                         {
+                           bindBuffer(Target, handle);
+                         },
+                         api::deleteBuffers,
+                         label}
+      , m_size{size}
+  {
+    GL_ASSERT(api::namedBufferStorage(getHandle(), sizeof(T) * size, nullptr, storageFlags));
+  }
+
   [[nodiscard]] MappedBuffer<T, _Target> map(const api::core::Bitfield<api::MapBufferAccessMask>& access
                                              = api::MapBufferAccessMask::MapReadBit)
   {
@@ -151,6 +167,9 @@ using UniformBuffer = Buffer<T, api::BufferTarget::UniformBuffer>;
 template<typename T>
 using ArrayBuffer = Buffer<T, api::BufferTarget::ArrayBuffer>;
 
+template<typename T>
+using PixelPackBuffer = Buffer<T, api::BufferTarget::PixelPackBuffer>;
+
 template<typename T>
 class ElementArrayBuffer final : public Buffer<T, api::BufferTarget::ElementArrayBuffer>
 {
@@ -177,5 +196,21 @@ public:
     GL_ASSERT(api::drawElementsInstanced(
       primitiveType, gsl::narrow<api::core::SizeType>(size()), DrawElementsType<T>, nullptr, instanceCount));
   }
+
+  void drawElementsBaseVertex(api::PrimitiveType primitiveType, api::core::SizeType count, int32_t baseVertex) const
+  {
+    gsl_Expects(count >= 0 && gsl::narrow_cast<size_t>(count) <= size());
+    GL_ASSERT(api::drawElementsBaseVertex(primitiveType, count, DrawElementsType<T>, nullptr, baseVertex));
+  }
+
+  void drawElementsBaseVertex(api::PrimitiveType primitiveType,
+                              api::core::SizeType count,
+                              int32_t baseVertex,
+                              api::core::SizeType instanceCount) const
+  {
+    gsl_Expects(count >= 0 && gsl::narrow_cast<size_t>(count) <= size());
+    GL_ASSERT(api::drawElementsInstancedBaseVertex(
+      primitiveType, count, DrawElementsType<T>, nullptr, instanceCount, baseVertex));
+  }
 };
 } // namespace gl
@@ -1,13 +1,11 @@
 #include "font.h"
 
-#include "image.h"
+#include "glyphatlas.h"
 
 #include <algorithm>
 #include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstdlib>
-#include <cstring>
-#include <gl/pixel.h>
 #include <gsl/gsl-lite.hpp>
 #include <iterator>
 #include <optional>
@@ -23,6 +21,8 @@ namespace
 {
 FT_Library freeTypeLib = nullptr;
 
+constexpr size_t MaxShapedTexts = 256;
+
 gsl::czstring getFreeTypeErrorMessage(const FT_Error err)
 {
 #undef __FTERRORS_H__
@@ -79,8 +79,9 @@ FT_Error ftcFaceRequester(const FTC_FaceID /*face_id*/,
   return FT_Err_Ok;
 }
 
-Font::Font(std::filesystem::path ttf)
+Font::Font(std::filesystem::path ttf, gslu::nn_shared<GlyphAtlas> atlas)
     : m_filename{std::move(ttf)}
+    , m_atlas{std::move(atlas)}
 {
   BOOST_LOG_TRIVIAL(debug) << "Loading font " << m_filename;
   auto error
@@ -126,26 +127,59 @@ Font::~Font()
   m_cache = nullptr;
 }
 
-void Font::drawText(
-  Image<PremultipliedSRGBA8>& img, const gsl::czstring text, glm::ivec2 xy, const PremultipliedSRGBA8& color, int size)
+const std::vector<Font::ShapedGlyph>& Font::shape(const std::string& text, const int size)
 {
-  Expects(text);
   Expects(size > 0);
 
-  size = gsl::narrow_cast<int>(gsl::narrow_cast<float>(size) * m_lineHeight);
+  auto key = std::tuple{text, size};
+  if(const auto it = m_shapedTexts.find(key);
+     it != m_shapedTexts.end() && it->second.atlasGeneration == m_atlas->getGeneration())
+  {
+    return it->second.glyphs;
+  }
+
+  if(m_shapedTexts.size() >= MaxShapedTexts)
+    m_shapedTexts.clear();
+
+  auto glyphs = tryShape(text, size);
+  if(!glyphs.has_value())
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Glyph atlas is full, clearing it";
+    m_atlas->clear();
+    glyphs = tryShape(text, size);
+    if(!glyphs.has_value())
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Text does not fit into the glyph atlas: " << text;
+      glyphs.emplace();
+    }
+  }
+
+  return m_shapedTexts.insert_or_assign(std::move(key), ShapedText{std::move(*glyphs), m_atlas->getGeneration()})
+    .first->second.glyphs;
+}
+
+std::optional<std::vector<Font::ShapedGlyph>> Font::tryShape(const std::string& text, const int size)
+{
+  if(m_glyphsGeneration != m_atlas->getGeneration())
+  {
+    m_glyphs.clear();
+    m_glyphsGeneration = m_atlas->getGeneration();
+  }
 
-  const int baseAlpha = color.channels[3];
-  auto currentColor = color;
+  const auto pixelSize = gsl::narrow_cast<int>(gsl::narrow_cast<float>(size) * m_lineHeight);
 
   FTC_ImageTypeRec imgType;
   imgType.face_id = this;
-  imgType.width = size;
-  imgType.height = size;
+  imgType.width = pixelSize;
+  imgType.height = pixelSize;
   imgType.flags = FT_LOAD_DEFAULT | FT_LOAD_RENDER; // NOLINT(hicpp-signed-bitwise)
 
-  std::optional<char32_t> prevChar = std::nullopt;
+  std::vector<ShapedGlyph> result;
+  glm::ivec2 xy{0, 0};
+  std::optional<FT_UInt> prevGlyphIndex = std::nullopt;
   std::vector<char32_t> utf32;
-  utf8::utf8to32(text, text + std::strlen(text), std::back_inserter(utf32));
+  utf8::utf8to32(text.begin(), text.end(), std::back_inserter(utf32));
+  result.reserve(utf32.size());
   for(const char32_t chr : utf32)
   {
     const auto glyphIndex = getGlyphIndex(chr);
@@ -165,39 +199,37 @@ void Font::drawText(
       continue;
     }
 
-    if(sbit->buffer != nullptr)
+    if(prevGlyphIndex.has_value())
+      xy.x += getGlyphKernAdvance(prevGlyphIndex.value(), glyphIndex);
+
+    if(sbit->buffer != nullptr && sbit->width > 0 && sbit->height > 0)
     {
-      for(int dy = 0, i = 0; dy < sbit->height; dy++)
+      const glm::ivec2 glyphSize{sbit->width, sbit->height};
+      const auto glyphKey = std::tuple{pixelSize, glyphIndex};
+      auto it = m_glyphs.find(glyphKey);
+      if(it == m_glyphs.end())
       {
-        for(int dx = 0; dx < sbit->width; dx++, i++)
+        const auto location = m_atlas->insert(glyphSize, sbit->pitch, sbit->buffer);
+        if(!location.has_value())
         {
-          currentColor.channels[3] = gsl::narrow_cast<uint8_t>(sbit->buffer[i] * baseAlpha / 255);
-          img.set(xy + glm::ivec2{dx + sbit->left, dy - sbit->top}, currentColor, true);
+          FTC_Node_Unref(node, m_cache);
+          return std::nullopt;
         }
+        it = m_glyphs.emplace(glyphKey, *location).first;
       }
-    }
 
-    if(prevChar.has_value())
-      xy.x += getGlyphKernAdvance(prevChar.value(), chr);
+      result.emplace_back(
+        ShapedGlyph{xy + glm::ivec2{sbit->left, -sbit->top}, glyphSize, it->second.uv0, it->second.uv1});
+    }
 
     xy.x += sbit->xadvance;
     xy.y += sbit->yadvance;
 
     FTC_Node_Unref(node, m_cache);
-    prevChar = chr;
+    prevGlyphIndex = glyphIndex;
   }
-}
 
-void Font::drawText(Image<PremultipliedSRGBA8>& img,
-                    const std::string& text,
-                    const glm::ivec2& xy,
-                    const uint8_t red,
-                    const uint8_t green,
-                    const uint8_t blue,
-                    const uint8_t alpha,
-                    const int size)
-{
-  drawText(img, text.c_str(), xy, premultiply(SRGBA8{red, green, blue, alpha}), size);
+  return result;
 }
 
 FT_Face Font::getFace() const
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "pixel.h"
+#include "glyphatlas.h"
 #include "soglb_fwd.h"
 
 #include <cstdint>
@@ -8,14 +8,28 @@
 #include <freetype/ftcache.h>
 #include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <map>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace gl
 {
 class Font
 {
 public:
-  explicit Font(std::filesystem::path ttf);
+  struct ShapedGlyph
+  {
+    //! Top left corner relative to the pen position on the baseline.
+    glm::ivec2 offset;
+    glm::ivec2 size;
+    glm::vec2 uv0;
+    glm::vec2 uv1;
+  };
+
+  explicit Font(std::filesystem::path ttf, gslu::nn_shared<GlyphAtlas> atlas);
   ~Font();
 
   Font(const Font&) = delete;
@@ -23,28 +37,42 @@ public:
   Font& operator=(const Font&) = delete;
   Font& operator=(Font&&) = delete;
 
-  void drawText(
-    Image<PremultipliedSRGBA8>& img, gsl::czstring text, glm::ivec2 xy, const PremultipliedSRGBA8& color, int size);
-  void drawText(Image<PremultipliedSRGBA8>& img,
-                const std::string& text,
-                const glm::ivec2& xy,
-                uint8_t red,
-                uint8_t green,
-                uint8_t blue,
-                uint8_t alpha,
-                int size);
+  /**
+   * Returns the glyphs of a text, with kerning applied and all glyphs placed in the atlas.
+   *
+   * The result is cached, and stays valid until the next call.
+   */
+  [[nodiscard]] const std::vector<ShapedGlyph>& shape(const std::string& text, int size);
 
   int getGlyphKernAdvance(FT_UInt left, FT_UInt right) const;
 
   FT_UInt getGlyphIndex(char32_t chr) const;
 
+  [[nodiscard]] const auto& getAtlas() const
+  {
+    return m_atlas;
+  }
+
 private:
+  struct ShapedText
+  {
+    std::vector<ShapedGlyph> glyphs;
+    uint64_t atlasGeneration;
+  };
+
   FTC_Manager m_cache = nullptr;
   mutable FTC_CMapCache m_cmapCache = nullptr;
   mutable FTC_SBitCache m_sbitCache = nullptr;
   float m_lineHeight{0};
 
   const std::filesystem::path m_filename;
+  const gslu::nn_shared<GlyphAtlas> m_atlas;
+  // keyed by pixel size and glyph index, valid for m_glyphsGeneration
+  std::map<std::tuple<int, FT_UInt>, GlyphAtlas::Location> m_glyphs;
+  uint64_t m_glyphsGeneration = 0;
+  std::map<std::tuple<std::string, int>, ShapedText> m_shapedTexts;
+
   FT_Face getFace() const;
+  [[nodiscard]] std::optional<std::vector<ShapedGlyph>> tryShape(const std::string& text, int size);
 };
 } // namespace gl
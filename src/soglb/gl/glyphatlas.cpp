@@ -0,0 +1,92 @@
+#include "glyphatlas.h"
+
+#include "sampler.h"
+#include "texture2d.h"
+#include "texturehandle.h"
+
+#include <algorithm>
+#include <gsl/gsl-lite.hpp>
+
+namespace gl
+{
+GlyphAtlas::GlyphAtlas(const glm::ivec2& size)
+    : m_size{size}
+    , m_data(gsl::narrow<size_t>(size.x * size.y), ScalarByte{0})
+    , m_texture{std::make_shared<TextureHandle<Texture2D<ScalarByte>>>(
+        gsl::make_shared<Texture2D<ScalarByte>>(size, "glyph-atlas"),
+        gsl::make_unique<Sampler>("glyph-atlas-sampler"))}
+    , m_dirtyEnd{size.y}
+{
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+std::optional<GlyphAtlas::Location> GlyphAtlas::insert(const glm::ivec2& size, const int pitch, const uint8_t* data)
+{
+  Expects(size.x >= 0 && size.y >= 0);
+  Expects(pitch >= size.x);
+  Expects(data != nullptr || size.x == 0 || size.y == 0);
+
+  // keep a gap of one pixel between glyphs
+  const auto paddedSize = size + glm::ivec2{1, 1};
+  if(m_cursor.x + paddedSize.x > m_size.x)
+  {
+    m_cursor = {0, m_cursor.y + m_shelfHeight};
+    m_shelfHeight = 0;
+  }
+  if(paddedSize.x > m_size.x || m_cursor.y + paddedSize.y > m_size.y)
+    return std::nullopt;
+
+  const auto xy = m_cursor;
+  for(int y = 0; y < size.y; ++y)
+  {
+    for(int x = 0; x < size.x; ++x)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      m_data[(xy.y + y) * m_size.x + xy.x + x] = ScalarByte{data[y * pitch + x]};
+    }
+  }
+
+  m_cursor.x += paddedSize.x;
+  m_shelfHeight = std::max(m_shelfHeight, paddedSize.y);
+
+  if(m_dirtyBegin == m_dirtyEnd)
+  {
+    m_dirtyBegin = xy.y;
+    m_dirtyEnd = xy.y + size.y;
+  }
+  else
+  {
+    m_dirtyBegin = std::min(m_dirtyBegin, xy.y);
+    m_dirtyEnd = std::max(m_dirtyEnd, xy.y + size.y);
+  }
+
+  const auto atlasSize = glm::vec2{m_size};
+  return Location{glm::vec2{xy} / atlasSize, glm::vec2{xy + size} / atlasSize};
+}
+
+void GlyphAtlas::clear()
+{
+  std::fill(m_data.begin(), m_data.end(), ScalarByte{0});
+  m_cursor = {0, 0};
+  m_shelfHeight = 0;
+  m_dirtyBegin = 0;
+  m_dirtyEnd = m_size.y;
+  ++m_generation;
+}
+
+const gslu::nn_shared<TextureHandle<Texture2D<ScalarByte>>>& GlyphAtlas::getTexture()
+{
+  if(m_dirtyBegin < m_dirtyEnd)
+  {
+    // upload whole rows only, so that the unpack alignment doesn't matter
+    const auto begin = gsl::narrow<size_t>(m_dirtyBegin * m_size.x);
+    const auto end = gsl::narrow<size_t>(m_dirtyEnd * m_size.x);
+    m_texture->getTexture()->assign(gsl::span{m_data}.subspan(begin, end - begin),
+                                    {0, m_dirtyBegin},
+                                    {m_size.x, m_dirtyEnd - m_dirtyBegin});
+  }
+  m_dirtyBegin = m_dirtyEnd = 0;
+  return m_texture;
+}
+} // namespace gl
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "pixel.h"
+#include "soglb_fwd.h"
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include <gslu.h>
+#include <optional>
+#include <vector>
+
+namespace gl
+{
+/**
+ * A single-channel texture holding rasterized glyphs of any number of fonts and sizes.
+ *
+ * Glyphs are packed into shelves. When the atlas is full, it needs to be cleared, which increases its generation so
+ * that users can detect that previously returned locations are no longer valid.
+ */
+class GlyphAtlas final
+{
+public:
+  struct Location
+  {
+    glm::vec2 uv0;
+    glm::vec2 uv1;
+  };
+
+  explicit GlyphAtlas(const glm::ivec2& size);
+  ~GlyphAtlas();
+
+  GlyphAtlas(const GlyphAtlas&) = delete;
+  GlyphAtlas(GlyphAtlas&&) noexcept = delete;
+  GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+  GlyphAtlas& operator=(GlyphAtlas&&) = delete;
+
+  //! Copies a coverage bitmap into the atlas, returns std::nullopt if there's not enough space left.
+  [[nodiscard]] std::optional<Location> insert(const glm::ivec2& size, int pitch, const uint8_t* data);
+
+  void clear();
+
+  [[nodiscard]] auto getGeneration() const noexcept
+  {
+    return m_generation;
+  }
+
+  //! Uploads all glyphs inserted since the last call and returns the texture.
+  [[nodiscard]] const gslu::nn_shared<TextureHandle<Texture2D<ScalarByte>>>& getTexture();
+
+private:
+  const glm::ivec2 m_size;
+  std::vector<ScalarByte> m_data;
+  const gslu::nn_shared<TextureHandle<Texture2D<ScalarByte>>> m_texture;
+  glm::ivec2 m_cursor{0, 0};
+  int m_shelfHeight = 0;
+  int m_dirtyBegin = 0;
+  int m_dirtyEnd = 0;
+  uint64_t m_generation = 0;
+};
+} // namespace gl
@@ -25,6 +25,7 @@ template<typename T, api::BufferTarget _Target>
 class Buffer;
 class CImgWrapper;
 class Font;
+class GlyphAtlas;
 class TextureAttachment;
 class Framebuffer;
 class FrameBufferBuilder;
@@ -79,6 +80,7 @@ class VertexAttribute;
 template<typename T>
 class VertexBuffer;
 class Window;
+class AttributelessVertexArray;
 template<typename T>
 class ElementArrayBuffer;
 class Font;
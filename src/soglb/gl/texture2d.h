@@ -42,6 +42,17 @@ public:
     return *this;
   }
 
+  Texture2D<_PixelT>& assign(const gsl::span<const _PixelT>& data, const glm::ivec2& offset, const glm::ivec2& size)
+  {
+    gsl_Assert(gsl::narrow<size_t>(size.x * size.y) == data.size());
+    gsl_Assert(offset.x >= 0 && offset.y >= 0);
+    gsl_Assert(offset.x + size.x <= m_size.x && offset.y + size.y <= m_size.y);
+
+    GL_ASSERT(api::textureSubImage2D(
+      getHandle(), 0, offset.x, offset.y, size.x, size.y, Pixel::PixelFormat, Pixel::PixelType, data.data()));
+    return *this;
+  }
+
   [[nodiscard]] const glm::ivec2& size() const noexcept
   {
     return m_size;
@@ -2,6 +2,7 @@
 
 #include "texture.h"
 
+#include <cstdint>
 #include <string_view>
 
 namespace gl
@@ -15,15 +16,28 @@ public:
   using TextureImpl<api::TextureTarget::Texture2dArray, _PixelT>::getHandle;
 
   explicit Texture2DArray(const glm::ivec3& size, const std::string_view& label, int levels = 1)
+      : Texture2DArray{size, Pixel::SizedInternalFormat, label, levels}
+  {
+  }
+
+  /**
+   * Allocates the storage in a different internal format, e.g. a block-compressed one. The pixel type then only
+   * describes the texels as seen by the shaders, and data must be uploaded with assignCompressed.
+   */
+  explicit Texture2DArray(const glm::ivec3& size,
+                          api::SizedInternalFormat internalFormat,
+                          const std::string_view& label,
+                          int levels = 1)
       : TextureImpl<api::TextureTarget::Texture2dArray, _PixelT>{label}
       , m_size{size}
+      , m_internalFormat{internalFormat}
   {
     BOOST_ASSERT(levels > 0);
     BOOST_ASSERT(size.x > 0);
     BOOST_ASSERT(size.y > 0);
     BOOST_ASSERT(size.z > 0);
 
-    GL_ASSERT(api::textureStorage3D(getHandle(), levels, Pixel::SizedInternalFormat, size.x, size.y, size.z));
+    GL_ASSERT(api::textureStorage3D(getHandle(), levels, internalFormat, size.x, size.y, size.z));
   }
 
   Texture2DArray<_PixelT>& assign(const gsl::span<const _PixelT>& data, int z, int level = 0)
@@ -39,7 +53,29 @@ public:
     return *this;
   }
 
+  Texture2DArray<_PixelT>& assignCompressed(const gsl::span<const uint8_t>& data, int z, int level = 0)
+  {
+    BOOST_ASSERT(z >= 0 && z < m_size.z);
+    BOOST_ASSERT(m_internalFormat != Pixel::SizedInternalFormat);
+
+    const int levelDiv = 1 << level;
+    const auto size = glm::max(glm::ivec3{1, 1, 1}, m_size / levelDiv);
+    GL_ASSERT(api::compressedTextureSubImage3D(getHandle(),
+                                               level,
+                                               0,
+                                               0,
+                                               z,
+                                               size.x,
+                                               size.y,
+                                               1,
+                                               static_cast<api::InternalFormat>(m_internalFormat),
+                                               gsl::narrow<api::core::SizeType>(data.size()),
+                                               data.data()));
+    return *this;
+  }
+
 private:
   glm::ivec3 m_size{-1};
+  api::SizedInternalFormat m_internalFormat;
 };
 } // namespace gl
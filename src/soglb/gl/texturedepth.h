@@ -13,6 +13,7 @@ class TextureDepth final : public TextureImpl<api::TextureTarget::Texture2d, Sca
 public:
   using typename TextureImpl<api::TextureTarget::Texture2d, ScalarDepth<_T>>::Pixel;
   using TextureImpl<api::TextureTarget::Texture2d, ScalarDepth<_T>>::getHandle;
+  using TextureImpl<api::TextureTarget::Texture2d, ScalarDepth<_T>>::getSubDataTarget;
 
   explicit TextureDepth(const glm::ivec2& size, const std::string_view& label)
       : TextureImpl<api::TextureTarget::Texture2d, ScalarDepth<_T>>{label}
@@ -29,6 +30,25 @@ public:
     return m_size;
   }
 
+  void copyFrom(const TextureDepth<_T>& src)
+  {
+    GL_ASSERT(api::copyImageSubData(src.getHandle(),
+                                    src.getSubDataTarget(),
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    getHandle(),
+                                    getSubDataTarget(),
+                                    0,
+                                    0,
+                                    0,
+                                    0,
+                                    src.m_size.x,
+                                    src.m_size.y,
+                                    1));
+  }
+
 private:
   const glm::ivec2 m_size;
 };
@@ -45,9 +45,8 @@ template<>
 inline constexpr api::VertexAttribType VertexAttribType<float> = api::VertexAttribType::Float;
 template<>
 inline constexpr api::VertexAttribType VertexAttribType<api::core::Half> = api::VertexAttribType::HalfFloat;
-template<int N>
-inline constexpr api::VertexAttribType VertexAttribType<glm::vec<N, float, glm::defaultp>>
-  = api::VertexAttribType::Float;
+template<int N, typename T>
+inline constexpr api::VertexAttribType VertexAttribType<glm::vec<N, T, glm::defaultp>> = VertexAttribType<T>;
 template<int C, int R>
 inline constexpr api::VertexAttribType VertexAttribType<glm::mat<C, R, float, glm::defaultp>>
   = api::VertexAttribType::Float;
@@ -91,8 +90,8 @@ template<>
 inline constexpr api::core::SizeType ElementCount<float> = 1;
 template<>
 inline constexpr api::core::SizeType ElementCount<api::core::Half> = 1;
-template<int N>
-inline constexpr api::core::SizeType ElementCount<glm::vec<N, float, glm::defaultp>> = N;
+template<int N, typename T>
+inline constexpr api::core::SizeType ElementCount<glm::vec<N, T, glm::defaultp>> = N;
 template<int C, int R>
 inline constexpr api::core::SizeType ElementCount<glm::mat<C, R, float, glm::defaultp>> = C * R;
 
@@ -101,8 +101,56 @@ public:
     unbind();
   }
 
+  void drawIndexBufferBaseVertex(api::PrimitiveType primitiveType, api::core::SizeType count, int32_t baseVertex)
+  {
+    RenderState::applyWantedState();
+    bind();
+    m_indexBuffer->drawElementsBaseVertex(primitiveType, count, baseVertex);
+    unbind();
+  }
+
+  void drawIndexBufferBaseVertex(api::PrimitiveType primitiveType,
+                                 api::core::SizeType count,
+                                 int32_t baseVertex,
+                                 api::core::SizeType instanceCount)
+  {
+    RenderState::applyWantedState();
+    bind();
+    m_indexBuffer->drawElementsBaseVertex(primitiveType, count, baseVertex, instanceCount);
+    unbind();
+  }
+
 private:
   IndexBufferPtr m_indexBuffer;
   VertexBuffers m_vertexBuffers;
 };
+
+/**
+ * A vertex array without any attached buffers, for geometry that is generated in shaders from gl_VertexID and
+ * gl_InstanceID.
+ */
+class AttributelessVertexArray final : public BindableResource<api::ObjectIdentifier::VertexArray>
+{
+public:
+  explicit AttributelessVertexArray(const std::string_view& label)
+      : BindableResource{api::createVertexArrays, api::bindVertexArray, api::deleteVertexArrays, label}
+  {
+  }
+
+  void drawArrays(api::PrimitiveType primitiveType, api::core::SizeType count)
+  {
+    RenderState::applyWantedState();
+    bind();
+    GL_ASSERT(api::drawArrays(primitiveType, 0, count));
+    unbind();
+  }
+
+  void drawArrays(api::PrimitiveType primitiveType, api::core::SizeType count, api::core::SizeType instanceCount)
+  {
+    RenderState::applyWantedState();
+    bind();
+    GL_ASSERT(api::drawArraysInstanced(primitiveType, 0, count, instanceCount));
+    unbind();
+  }
+};
 } // namespace gl
@@ -81,6 +81,18 @@ public:
     BOOST_ASSERT(!m_layout.empty());
   }
 
+  explicit VertexBuffer(VertexLayout<T> layout,
+                        const std::string_view& label,
+                        const api::core::Bitfield<api::BufferStorageMask>& storageFlags,
+                        size_t size,
+                        uint32_t divisor = 0)
+      : ArrayBuffer<T>{label, storageFlags, size}
+      , m_layout{std::move(layout)}
+      , m_divisor{divisor}
+  {
+    BOOST_ASSERT(!m_layout.empty());
+  }
+
   void
     bindVertexAttributes(const api::core::Handle vertexArray, const Program& program, const uint32_t bindingIndex) const
   {
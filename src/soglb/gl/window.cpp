@@ -192,6 +192,19 @@ void Window::setWindowed()
   m_isFullscreen = false;
 }
 
+int Window::getRefreshRate() const
+{
+  // windowed mode is not tracked per monitor, and windows are made fullscreen on the primary monitor
+  auto monitor = glfwGetWindowMonitor(m_window);
+  if(monitor == nullptr)
+    monitor = glfwGetPrimaryMonitor();
+  if(monitor == nullptr)
+    return 0;
+
+  const auto mode = glfwGetVideoMode(monitor);
+  return mode == nullptr ? 0 : mode->refreshRate;
+}
+
 Window::~Window()
 {
   glfwDestroyWindow(m_window);
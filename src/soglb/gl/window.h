@@ -54,6 +54,9 @@ public:
 
   [[nodiscard]] bool hasFocus() const;
 
+  //! The refresh rate of the monitor the window is presented on in Hz, or 0 if it is unknown.
+  [[nodiscard]] int getRefreshRate() const;
+
 private:
   GLFWwindow* m_window = nullptr;
   glm::ivec2 m_windowPos{0};
@@ -3,34 +3,24 @@
 #include "boxgouraud.h"
 #include "core/id.h"
 #include "engine/world/sprite.h"
-#include "render/material/material.h"
-#include "render/material/materialgroup.h"
-#include "render/material/rendermode.h"
-#include "render/material/shaderprogram.h"
-#include "render/scene/mesh.h"
-#include "render/scene/names.h"
-#include "render/scene/rendercontext.h"
-
-#include <algorithm>
+#include "uirenderer.h"
+
 #include <cstdint>
-#include <gl/buffer.h>
 #include <gl/debuggroup.h>
+#include <gl/font.h>
 #include <gl/pixel.h>
-#include <gl/renderstate.h>
-#include <gl/vertexarray.h>
-#include <gl/vertexbuffer.h>
 #include <glm/common.hpp>
-#include <glm/mat4x4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
-#include <optional>
-#include <string>
 #include <utility>
 
 namespace ui
 {
 namespace
 {
+// texture layer marking quads sampling the glyph atlas instead of the geometry textures
+constexpr float GlyphAtlasLayer = -2;
+
 void createQuad(std::vector<Ui::UiVertex>& vertices,
                 const glm::vec2& topLeft,
                 const glm::vec2& bottomRight,
@@ -76,66 +66,56 @@ void createQuad(std::vector<Ui::UiVertex>& vertices,
   });
 }
 
-void createQuad(std::vector<Ui::UiVertex>& vertices, const glm::vec2& a, const glm::vec2& dxy, const gl::SRGBA8& color)
+void createQuad(std::vector<Ui::UiQuadVertex>& vertices,
+                const glm::vec2& a,
+                const glm::vec2& dxy,
+                const gl::SRGBA8& color)
 {
   const auto glColor = gl::premultiply(glm::vec4{color.channels} / 255.0f);
   const auto b = a + dxy;
 
-  vertices.emplace_back(Ui::UiVertex{{a.x, a.y}, {0, 0, -1}, glColor, glColor, glColor, glColor});
-  vertices.emplace_back(Ui::UiVertex{{a.x, b.y}, {0, 1, -1}, glColor, glColor, glColor, glColor});
-  vertices.emplace_back(Ui::UiVertex{{b.x, b.y}, {1, 1, -1}, glColor, glColor, glColor, glColor});
-  vertices.emplace_back(Ui::UiVertex{{b.x, a.y}, {1, 0, -1}, glColor, glColor, glColor, glColor});
+  vertices.emplace_back(Ui::UiQuadVertex{{a.x, a.y}, {0, 0, -1}, glColor});
+  vertices.emplace_back(Ui::UiQuadVertex{{a.x, b.y}, {0, 1, -1}, glColor});
+  vertices.emplace_back(Ui::UiQuadVertex{{b.x, b.y}, {1, 1, -1}, glColor});
+  vertices.emplace_back(Ui::UiQuadVertex{{b.x, a.y}, {1, 0, -1}, glColor});
 }
 
-void createHLine(std::vector<Ui::UiVertex>& vertices, const glm::vec2& a, int length, const gl::SRGBA8& color)
+void createHLine(std::vector<Ui::UiQuadVertex>& vertices, const glm::vec2& a, int length, const gl::SRGBA8& color)
 {
   return createQuad(vertices, a, glm::vec2{length, 1}, color);
 }
 
-void createVLine(std::vector<Ui::UiVertex>& vertices, const glm::vec2& a, int length, const gl::SRGBA8& color)
+void createVLine(std::vector<Ui::UiQuadVertex>& vertices, const glm::vec2& a, int length, const gl::SRGBA8& color)
 {
   return createQuad(vertices, a, glm::vec2{1, length}, color);
 }
 } // namespace
 
-gslu::nn_shared<gl::VertexBuffer<Ui::UiVertex>> Ui::UiVertex::createVertexBuffer(gl::api::BufferUsage usage,
-                                                                                 const gsl::span<Ui::UiVertex>& data)
-{
-  static const gl::VertexLayout<UiVertex> layout{
-    {VERTEX_ATTRIBUTE_POSITION_NAME, &UiVertex::pos},
-    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, &UiVertex::uv},
-    {VERTEX_ATTRIBUTE_COLOR_TOP_LEFT_NAME, &UiVertex::topLeft},
-    {VERTEX_ATTRIBUTE_COLOR_TOP_RIGHT_NAME, &UiVertex::topRight},
-    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_LEFT_NAME, &UiVertex::bottomLeft},
-    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_RIGHT_NAME, &UiVertex::bottomRight},
-    {VERTEX_ATTRIBUTE_COLOR_NAME, &UiVertex::color},
-  };
-  return gsl::make_shared<gl::VertexBuffer<UiVertex>>(layout, "ui-vbo", usage, data);
-}
-
-gslu::nn_shared<gl::ElementArrayBuffer<uint16_t>> Ui::UiVertex::createIndexBuffer(gl::api::BufferUsage usage,
-                                                                                  const gsl::span<uint16_t>& data)
+Ui::Ui(gslu::nn_shared<UiRenderer> renderer, const std::array<gl::SRGBA8, 256>& palette, const glm::ivec2& size)
+    : m_renderer{std::move(renderer)}
+    , m_palette{palette}
+    , m_size{size}
 {
-  return gsl::make_shared<gl::ElementArrayBuffer<uint16_t>>("ui-indices", usage, data);
 }
 
-Ui::Ui(std::shared_ptr<render::material::Material> material,
-       const std::array<gl::SRGBA8, 256>& palette,
-       const glm::ivec2& size)
-    : m_material{std::move(material)}
-    , m_palette{palette}
-    , m_size{size}
+void Ui::addQuad(bool gouraud)
 {
+  if(!m_batches.empty() && m_batches.back().gouraud == gouraud)
+    m_batches.back().vertexCount += 4;
+  else
+    m_batches.emplace_back(Batch{gouraud, 4});
 }
 
 void Ui::drawHLine(const glm::ivec2& xy, int length, const gl::SRGBA8& color)
 {
-  createHLine(m_vertices, xy, length + glm::sign(length), color);
+  createHLine(m_quadVertices, xy, length + glm::sign(length), color);
+  addQuad(false);
 }
 
 void Ui::drawVLine(const glm::ivec2& xy, int length, const gl::SRGBA8& color)
 {
-  createVLine(m_vertices, xy, length + glm::sign(length), color);
+  createVLine(m_quadVertices, xy, length + glm::sign(length), color);
+  addQuad(false);
 }
 
 void Ui::drawOutlineBox(const glm::ivec2& xy, const glm::ivec2& size, uint8_t alpha)
@@ -161,51 +141,25 @@ void Ui::drawOutlineBox(const glm::ivec2& xy, const glm::ivec2& size, uint8_t al
 
 void Ui::drawBox(const glm::ivec2& xy, const glm::ivec2& size, const BoxGouraud& gouraud)
 {
-  createQuad(m_vertices, xy, xy + size, gouraud);
+  createQuad(m_gouraudVertices, xy, xy + size, gouraud);
+  addQuad(true);
 }
 
 void Ui::drawBox(const glm::ivec2& xy, const glm::ivec2& size, const gl::SRGBA8& color)
 {
-  createQuad(m_vertices, xy, size, color);
+  createQuad(m_quadVertices, xy, size, color);
+  addQuad(false);
 }
 
 void Ui::render()
 {
   SOGLB_DEBUGGROUP("ui");
 
-  // rebuild vao and vbo
-  Expects(m_vertices.size() % 4 == 0);
+  m_renderer->render(m_size, m_gouraudVertices, m_quadVertices, m_batches);
 
-  std::vector<uint16_t> indices;
-  static const std::array<uint16_t, 6> localIndices{0, 1, 2, 0, 2, 3};
-  indices.reserve(m_vertices.size() / 4 * localIndices.size());
-  for(size_t i = 0; i < m_vertices.size(); i += 4)
-  {
-    for(auto localIndex : localIndices)
-      indices.emplace_back(gsl::narrow_cast<uint16_t>(i + localIndex));
-  }
-
-  const auto indexBuffer = UiVertex::createIndexBuffer(gl::api::BufferUsage::StaticDraw, indices);
-  const auto vbo = UiVertex::createVertexBuffer(gl::api::BufferUsage::StaticDraw, m_vertices);
-
-  const auto vao = gsl::make_shared<gl::VertexArray<uint16_t, UiVertex>>(
-    indexBuffer, std::tuple{vbo}, std::vector{&m_material->getShaderProgram()->getHandle()}, "ui-vao");
-  auto mesh = std::make_shared<render::scene::MeshImpl<uint16_t, UiVertex>>(vao);
-  mesh->getMaterialGroup().set(render::material::RenderMode::Full, m_material);
-  mesh->getRenderState().setViewport(m_size);
-  mesh->getRenderState().setBlend(0, true);
-  mesh->getRenderState().setBlendFactors(0,
-                                         gl::api::BlendingFactor::One,
-                                         gl::api::BlendingFactor::One,
-                                         gl::api::BlendingFactor::OneMinusSrcAlpha,
-                                         gl::api::BlendingFactor::One);
-  mesh->getRenderState().setDepthTest(false);
-  mesh->getRenderState().setDepthWrite(false);
-
-  render::scene::RenderContext ctx{render::material::RenderMode::Full, std::nullopt};
-  mesh->render(nullptr, ctx);
-
-  m_vertices.clear();
+  m_gouraudVertices.clear();
+  m_quadVertices.clear();
+  m_batches.clear();
 }
 
 void Ui::draw(const engine::world::Sprite& sprite, const glm::ivec2& xy, float scale, float alpha)
@@ -214,33 +168,26 @@ void Ui::draw(const engine::world::Sprite& sprite, const glm::ivec2& xy, float s
   const auto b = glm::ivec2{glm::vec2{sprite.render1} * scale} + xy;
   const auto ta = sprite.uv0;
   const auto tb = sprite.uv1;
-  m_vertices.emplace_back(UiVertex{{a.x, a.y},
-                                   {ta.x, ta.y, sprite.textureId.get()},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   gl::premultiply(glm::vec4{1, 1, 1, alpha})});
-  m_vertices.emplace_back(UiVertex{{a.x, b.y},
-                                   {ta.x, tb.y, sprite.textureId.get()},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   gl::premultiply(glm::vec4{1, 1, 1, alpha})});
-  m_vertices.emplace_back(UiVertex{{b.x, b.y},
-                                   {tb.x, tb.y, sprite.textureId.get()},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   gl::premultiply(glm::vec4{1, 1, 1, alpha})});
-  m_vertices.emplace_back(UiVertex{{b.x, a.y},
-                                   {tb.x, ta.y, sprite.textureId.get()},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   glm::vec4{0},
-                                   gl::premultiply(glm::vec4{1, 1, 1, alpha})});
+  const auto color = gl::premultiply(glm::vec4{1, 1, 1, alpha});
+  m_quadVertices.emplace_back(UiQuadVertex{{a.x, a.y}, {ta.x, ta.y, sprite.textureId.get()}, color});
+  m_quadVertices.emplace_back(UiQuadVertex{{a.x, b.y}, {ta.x, tb.y, sprite.textureId.get()}, color});
+  m_quadVertices.emplace_back(UiQuadVertex{{b.x, b.y}, {tb.x, tb.y, sprite.textureId.get()}, color});
+  m_quadVertices.emplace_back(UiQuadVertex{{b.x, a.y}, {tb.x, ta.y, sprite.textureId.get()}, color});
+  addQuad(false);
+}
+
+void Ui::drawText(gl::Font& font, const std::string& text, const glm::ivec2& xy, const int size, const gl::SRGBA8& color)
+{
+  const auto glColor = gl::premultiply(glm::vec4{color.channels} / 255.0f);
+  for(const auto& glyph : font.shape(text, size))
+  {
+    const auto a = glm::vec2{xy + glyph.offset};
+    const auto b = a + glm::vec2{glyph.size};
+    m_quadVertices.emplace_back(UiQuadVertex{{a.x, a.y}, {glyph.uv0.x, glyph.uv0.y, GlyphAtlasLayer}, glColor});
+    m_quadVertices.emplace_back(UiQuadVertex{{a.x, b.y}, {glyph.uv0.x, glyph.uv1.y, GlyphAtlasLayer}, glColor});
+    m_quadVertices.emplace_back(UiQuadVertex{{b.x, b.y}, {glyph.uv1.x, glyph.uv1.y, GlyphAtlasLayer}, glColor});
+    m_quadVertices.emplace_back(UiQuadVertex{{b.x, a.y}, {glyph.uv1.x, glyph.uv0.y, GlyphAtlasLayer}, glColor});
+    addQuad(false);
+  }
 }
 } // namespace ui
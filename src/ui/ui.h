@@ -11,13 +11,9 @@
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <memory>
+#include <string>
 #include <vector>
 
-namespace render::material
-{
-class Material;
-}
-
 namespace engine::world
 {
 struct Sprite;
@@ -26,10 +22,12 @@ struct Sprite;
 namespace ui
 {
 struct BoxGouraud;
+class UiRenderer;
 
 class Ui final
 {
 public:
+  //! Vertex of a gouraud shaded quad, the fragment shader interpolates bilinearly between the corner colors.
   struct UiVertex
   {
     glm::vec2 pos;
@@ -39,16 +37,24 @@ public:
     glm::vec4 bottomLeft{0};
     glm::vec4 bottomRight{0};
     glm::vec4 color{1, 1, 1, 1};
+  };
+
+  //! Vertex of a single-colored or textured quad.
+  struct UiQuadVertex
+  {
+    glm::vec2 pos;
+    glm::vec3 uv;
+    glm::vec4 color{1, 1, 1, 1};
+  };
 
-    static gslu::nn_shared<gl::VertexBuffer<Ui::UiVertex>> createVertexBuffer(gl::api::BufferUsage usage,
-                                                                              const gsl::span<Ui::UiVertex>& data);
-    static gslu::nn_shared<gl::ElementArrayBuffer<uint16_t>> createIndexBuffer(gl::api::BufferUsage usage,
-                                                                               const gsl::span<uint16_t>& data);
+  //! A run of consecutive quads using the same vertex layout.
+  struct Batch
+  {
+    bool gouraud;
+    size_t vertexCount;
   };
 
-  explicit Ui(std::shared_ptr<render::material::Material> material,
-              const std::array<gl::SRGBA8, 256>& palette,
-              const glm::ivec2& size);
+  explicit Ui(gslu::nn_shared<UiRenderer> renderer, const std::array<gl::SRGBA8, 256>& palette, const glm::ivec2& size);
 
   void drawOutlineBox(const glm::ivec2& xy, const glm::ivec2& size, uint8_t alpha = 255);
   void drawBox(const glm::ivec2& xy, const glm::ivec2& size, const BoxGouraud& gouraud);
@@ -61,6 +67,8 @@ public:
   void drawHLine(const glm::ivec2& xy, int length, const gl::SRGBA8& color);
   void drawVLine(const glm::ivec2& xy, int length, const gl::SRGBA8& color);
   void draw(const engine::world::Sprite& sprite, const glm::ivec2& xy, float scale = 1, float alpha = 1);
+  //! Draws text rendered by a TrueType font, @a xy is the start of the baseline.
+  void drawText(gl::Font& font, const std::string& text, const glm::ivec2& xy, int size, const gl::SRGBA8& color);
 
   void render();
 
@@ -70,9 +78,13 @@ public:
   }
 
 private:
-  const std::shared_ptr<render::material::Material> m_material;
+  const gslu::nn_shared<UiRenderer> m_renderer;
   const std::array<gl::SRGBA8, 256> m_palette;
   const glm::ivec2 m_size;
-  std::vector<UiVertex> m_vertices{};
+  std::vector<UiVertex> m_gouraudVertices{};
+  std::vector<UiQuadVertex> m_quadVertices{};
+  std::vector<Batch> m_batches{};
+
+  void addQuad(bool gouraud);
 };
 } // namespace ui
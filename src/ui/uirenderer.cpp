@@ -0,0 +1,223 @@
+#include "uirenderer.h"
+
+#include "render/material/material.h"
+#include "render/material/materialgroup.h"
+#include "render/material/rendermode.h"
+#include "render/material/shaderprogram.h"
+#include "render/scene/mesh.h"
+#include "render/scene/names.h"
+#include "render/scene/rendercontext.h"
+
+#include <algorithm>
+#include <array>
+#include <boost/throw_exception.hpp>
+#include <cstdint>
+#include <gl/buffer.h>
+#include <gl/fencesync.h>
+#include <gl/renderstate.h>
+#include <gl/vertexarray.h>
+#include <gl/vertexbuffer.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ui
+{
+namespace
+{
+constexpr size_t SegmentCount = 3;
+constexpr size_t MaxQuadsPerDraw = 4096;
+constexpr size_t GouraudQuadsPerSegment = 256;
+constexpr size_t QuadsPerSegment = MaxQuadsPerDraw;
+static_assert(MaxQuadsPerDraw * 4 <= 65536, "Quad indices must fit into uint16_t");
+
+gslu::nn_shared<gl::ElementArrayBuffer<uint16_t>> createQuadIndexBuffer()
+{
+  static const std::array<uint16_t, 6> localIndices{0, 1, 2, 0, 2, 3};
+
+  std::vector<uint16_t> indices;
+  indices.reserve(MaxQuadsPerDraw * localIndices.size());
+  for(size_t i = 0; i < MaxQuadsPerDraw * 4; i += 4)
+  {
+    for(auto localIndex : localIndices)
+      indices.emplace_back(gsl::narrow_cast<uint16_t>(i + localIndex));
+  }
+
+  return gsl::make_shared<gl::ElementArrayBuffer<uint16_t>>("ui-indices", gl::api::BufferUsage::StaticDraw, indices);
+}
+} // namespace
+
+template<typename VertexT>
+class UiVertexRing final
+{
+public:
+  explicit UiVertexRing(const gl::VertexLayout<VertexT>& layout,
+                        size_t segmentQuads,
+                        const gslu::nn_shared<gl::ElementArrayBuffer<uint16_t>>& indexBuffer,
+                        const gslu::nn_shared<render::material::Material>& material,
+                        const std::string& label)
+      : m_segmentSize{segmentQuads * 4}
+      , m_vbo{gsl::make_shared<gl::VertexBuffer<VertexT>>(
+          layout,
+          label + "-vbo",
+          gl::api::BufferStorageMask::MapWriteBit | gl::api::BufferStorageMask::MapPersistentBit
+            | gl::api::BufferStorageMask::MapCoherentBit,
+          m_segmentSize * SegmentCount)}
+      , m_mapped{m_vbo->map(gl::api::MapBufferAccessMask::MapWriteBit | gl::api::MapBufferAccessMask::MapPersistentBit
+                            | gl::api::MapBufferAccessMask::MapCoherentBit)}
+      , m_mesh{gsl::make_shared<RingMesh>(gsl::make_shared<gl::VertexArray<uint16_t, VertexT>>(
+          indexBuffer, std::tuple{m_vbo}, std::vector{&material->getShaderProgram()->getHandle()}, label + "-vao"))}
+  {
+    gsl_Expects(segmentQuads <= MaxQuadsPerDraw);
+
+    m_mesh->getMaterialGroup().set(render::material::RenderMode::Full, material);
+    m_mesh->getRenderState().setBlend(0, true);
+    m_mesh->getRenderState().setBlendFactors(0,
+                                             gl::api::BlendingFactor::One,
+                                             gl::api::BlendingFactor::One,
+                                             gl::api::BlendingFactor::OneMinusSrcAlpha,
+                                             gl::api::BlendingFactor::One);
+    m_mesh->getRenderState().setDepthTest(false);
+    m_mesh->getRenderState().setDepthWrite(false);
+  }
+
+  void draw(const gsl::span<const VertexT>& vertices, const glm::ivec2& viewport, render::scene::RenderContext& context)
+  {
+    gsl_Expects(vertices.size() % 4 == 0);
+
+    m_mesh->getRenderState().setViewport(viewport);
+    for(size_t offset = 0; offset < vertices.size(); offset += m_segmentSize)
+    {
+      const auto chunk = vertices.subspan(offset, std::min(m_segmentSize, vertices.size() - offset));
+      m_mesh->setRange(push(chunk), chunk.size());
+      m_mesh->render(nullptr, context);
+    }
+  }
+
+private:
+  class RingMesh final : public render::scene::Mesh
+  {
+  public:
+    explicit RingMesh(gslu::nn_shared<gl::VertexArray<uint16_t, VertexT>> vao)
+        : m_vao{std::move(vao)}
+    {
+    }
+
+    void setRange(size_t firstVertex, size_t vertexCount)
+    {
+      m_baseVertex = gsl::narrow<int32_t>(firstVertex);
+      m_indexCount = gsl::narrow<gl::api::core::SizeType>(vertexCount / 4 * 6);
+    }
+
+  private:
+    gslu::nn_shared<gl::VertexArray<uint16_t, VertexT>> m_vao;
+    int32_t m_baseVertex = 0;
+    gl::api::core::SizeType m_indexCount = 0;
+
+    void drawIndexBuffer() override
+    {
+      m_vao->drawIndexBufferBaseVertex(getPrimitiveType(), m_indexCount, m_baseVertex);
+    }
+
+    void drawIndexBuffer(gl::api::core::SizeType /*instanceCount*/) override
+    {
+      BOOST_THROW_EXCEPTION(std::logic_error("Instanced ui rendering is not supported"));
+    }
+  };
+
+  const size_t m_segmentSize;
+  const gslu::nn_shared<gl::VertexBuffer<VertexT>> m_vbo;
+  gl::MappedBuffer<VertexT, gl::api::BufferTarget::ArrayBuffer> m_mapped;
+  const gslu::nn_shared<RingMesh> m_mesh;
+  std::array<std::unique_ptr<gl::FenceSync>, SegmentCount> m_fences{};
+  size_t m_segment = 0;
+  size_t m_cursor = 0;
+
+  //! Copies the vertices into the ring and returns the index of the first vertex.
+  [[nodiscard]] size_t push(const gsl::span<const VertexT>& vertices)
+  {
+    gsl_Expects(vertices.size() <= m_segmentSize);
+
+    if(m_cursor + vertices.size() > (m_segment + 1) * m_segmentSize)
+    {
+      // all draw calls reading from the current segment have been issued, and the next segment must not be
+      // overwritten before the GPU is done with it
+      m_fences.at(m_segment) = std::make_unique<gl::FenceSync>();
+      m_segment = (m_segment + 1) % SegmentCount;
+      m_cursor = m_segment * m_segmentSize;
+      if(auto& fence = m_fences.at(m_segment); fence != nullptr)
+      {
+        fence->clientWait();
+        fence.reset();
+      }
+    }
+
+    std::copy(vertices.begin(), vertices.end(), &m_mapped[m_cursor]);
+    const auto first = m_cursor;
+    m_cursor += vertices.size();
+    return first;
+  }
+};
+
+UiRenderer::UiRenderer(const gslu::nn_shared<render::material::Material>& material)
+{
+  static const gl::VertexLayout<Ui::UiVertex> gouraudLayout{
+    {VERTEX_ATTRIBUTE_POSITION_NAME, &Ui::UiVertex::pos},
+    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, &Ui::UiVertex::uv},
+    {VERTEX_ATTRIBUTE_COLOR_TOP_LEFT_NAME, &Ui::UiVertex::topLeft},
+    {VERTEX_ATTRIBUTE_COLOR_TOP_RIGHT_NAME, &Ui::UiVertex::topRight},
+    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_LEFT_NAME, &Ui::UiVertex::bottomLeft},
+    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_RIGHT_NAME, &Ui::UiVertex::bottomRight},
+    {VERTEX_ATTRIBUTE_COLOR_NAME, &Ui::UiVertex::color},
+  };
+
+  // a single-colored quad is a gradient with identical corner colors
+  static const gl::VertexLayout<Ui::UiQuadVertex> quadLayout{
+    {VERTEX_ATTRIBUTE_POSITION_NAME, &Ui::UiQuadVertex::pos},
+    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, &Ui::UiQuadVertex::uv},
+    {VERTEX_ATTRIBUTE_COLOR_TOP_LEFT_NAME, &Ui::UiQuadVertex::color},
+    {VERTEX_ATTRIBUTE_COLOR_TOP_RIGHT_NAME, &Ui::UiQuadVertex::color},
+    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_LEFT_NAME, &Ui::UiQuadVertex::color},
+    {VERTEX_ATTRIBUTE_COLOR_BOTTOM_RIGHT_NAME, &Ui::UiQuadVertex::color},
+    {VERTEX_ATTRIBUTE_COLOR_NAME, &Ui::UiQuadVertex::color},
+  };
+
+  const auto indexBuffer = createQuadIndexBuffer();
+  m_gouraudRing = std::make_unique<UiVertexRing<Ui::UiVertex>>(
+    gouraudLayout, GouraudQuadsPerSegment, indexBuffer, material, "ui-gouraud");
+  m_quadRing
+    = std::make_unique<UiVertexRing<Ui::UiQuadVertex>>(quadLayout, QuadsPerSegment, indexBuffer, material, "ui-quad");
+}
+
+UiRenderer::~UiRenderer() = default;
+
+void UiRenderer::render(const glm::ivec2& viewport,
+                        const gsl::span<const Ui::UiVertex>& gouraudVertices,
+                        const gsl::span<const Ui::UiQuadVertex>& quadVertices,
+                        const gsl::span<const Ui::Batch>& batches)
+{
+  render::scene::RenderContext context{render::material::RenderMode::Full, std::nullopt};
+
+  size_t gouraudOffset = 0;
+  size_t quadOffset = 0;
+  for(const auto& batch : batches)
+  {
+    if(batch.gouraud)
+    {
+      m_gouraudRing->draw(gouraudVertices.subspan(gouraudOffset, batch.vertexCount), viewport, context);
+      gouraudOffset += batch.vertexCount;
+    }
+    else
+    {
+      m_quadRing->draw(quadVertices.subspan(quadOffset, batch.vertexCount), viewport, context);
+      quadOffset += batch.vertexCount;
+    }
+  }
+
+  gsl_Ensures(gouraudOffset == gouraudVertices.size());
+  gsl_Ensures(quadOffset == quadVertices.size());
+}
+} // namespace ui
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ui.h"
+
+#include <glm/vec2.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <memory>
+
+namespace render::material
+{
+class Material;
+}
+
+namespace ui
+{
+template<typename VertexT>
+class UiVertexRing;
+
+/**
+ * Streams the quads of all ui::Ui instances through persistently mapped vertex buffers.
+ *
+ * Each vertex layout has its own ring buffer split into three segments, so the CPU never writes to a segment the GPU
+ * may still read from. All quads share a single static index buffer, consecutive quads of the same layout are drawn
+ * with a single draw call.
+ */
+class UiRenderer final
+{
+public:
+  explicit UiRenderer(const gslu::nn_shared<render::material::Material>& material);
+  ~UiRenderer();
+
+  void render(const glm::ivec2& viewport,
+              const gsl::span<const Ui::UiVertex>& gouraudVertices,
+              const gsl::span<const Ui::UiQuadVertex>& quadVertices,
+              const gsl::span<const Ui::Batch>& batches);
+
+private:
+  std::unique_ptr<UiVertexRing<Ui::UiVertex>> m_gouraudRing;
+  std::unique_ptr<UiVertexRing<Ui::UiQuadVertex>> m_quadRing;
+};
+} // namespace ui
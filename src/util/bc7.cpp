@@ -0,0 +1,341 @@
+#include "bc7.h"
+
+#include "parallelfor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gsl/gsl-lite.hpp>
+#include <limits>
+
+namespace util::bc7
+{
+namespace
+{
+constexpr size_t Channels = 4;
+constexpr size_t TexelCount = BlockTexels * BlockTexels;
+constexpr uint8_t Mode6 = 1u << 6u;
+
+// interpolation weights for 4-bit indices, in 1/64ths
+constexpr std::array<uint32_t, 16> Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+using Color = std::array<float, Channels>;
+using Indices = std::array<uint8_t, TexelCount>;
+
+struct Endpoint
+{
+  //! 7-bit channel values.
+  std::array<uint8_t, Channels> quantized{};
+  uint8_t parity = 0;
+
+  [[nodiscard]] uint32_t expand(size_t channel) const
+  {
+    return (static_cast<uint32_t>(quantized[channel]) << 1u) | parity;
+  }
+};
+
+class BitWriter final
+{
+public:
+  explicit BitWriter(Block& block)
+      : m_block{block}
+  {
+    m_block.fill(0);
+  }
+
+  void write(uint32_t value, size_t bits)
+  {
+    for(size_t i = 0; i < bits; ++i, ++m_position)
+    {
+      if(((value >> i) & 1u) != 0)
+        m_block[m_position / 8] |= static_cast<uint8_t>(1u << (m_position % 8));
+    }
+  }
+
+private:
+  Block& m_block;
+  size_t m_position = 0;
+};
+
+class BitReader final
+{
+public:
+  explicit BitReader(const Block& block)
+      : m_block{block}
+  {
+  }
+
+  [[nodiscard]] uint32_t read(size_t bits)
+  {
+    uint32_t value = 0;
+    for(size_t i = 0; i < bits; ++i, ++m_position)
+    {
+      if(((m_block[m_position / 8] >> (m_position % 8)) & 1u) != 0)
+        value |= 1u << i;
+    }
+    return value;
+  }
+
+private:
+  const Block& m_block;
+  size_t m_position = 0;
+};
+
+uint8_t interpolate(uint32_t e0, uint32_t e1, uint8_t index)
+{
+  const auto w = Weights[index];
+  return gsl::narrow_cast<uint8_t>(((64 - w) * e0 + w * e1 + 32) >> 6u);
+}
+
+Endpoint quantize(const Color& color)
+{
+  Endpoint best;
+  float bestError = std::numeric_limits<float>::max();
+  for(uint8_t parity = 0; parity < 2; ++parity)
+  {
+    Endpoint candidate;
+    candidate.parity = parity;
+    float error = 0;
+    for(size_t c = 0; c < Channels; ++c)
+    {
+      const auto q = std::clamp(std::lround((color[c] - parity) / 2), 0l, 127l);
+      candidate.quantized[c] = gsl::narrow_cast<uint8_t>(q);
+      const auto delta = static_cast<float>(candidate.expand(c)) - color[c];
+      error += delta * delta;
+    }
+    if(error < bestError)
+    {
+      bestError = error;
+      best = candidate;
+    }
+  }
+  return best;
+}
+
+uint32_t findIndices(const Texels& texels, const Endpoint& e0, const Endpoint& e1, Indices& indices)
+{
+  std::array<std::array<int32_t, Channels>, Weights.size()> palette{};
+  for(size_t i = 0; i < Weights.size(); ++i)
+    for(size_t c = 0; c < Channels; ++c)
+      palette[i][c] = interpolate(e0.expand(c), e1.expand(c), gsl::narrow_cast<uint8_t>(i));
+
+  uint32_t totalError = 0;
+  for(size_t t = 0; t < TexelCount; ++t)
+  {
+    auto bestError = std::numeric_limits<uint32_t>::max();
+    for(size_t i = 0; i < palette.size(); ++i)
+    {
+      uint32_t error = 0;
+      for(size_t c = 0; c < Channels; ++c)
+      {
+        const auto delta = palette[i][c] - texels[t * Channels + c];
+        error += static_cast<uint32_t>(delta * delta);
+      }
+      if(error < bestError)
+      {
+        bestError = error;
+        indices[t] = gsl::narrow_cast<uint8_t>(i);
+      }
+    }
+    totalError += bestError;
+  }
+  return totalError;
+}
+
+//! Approximates the endpoints by the extent of the texels along their principal axis.
+std::pair<Color, Color> principalAxisEndpoints(const Texels& texels)
+{
+  Color mean{};
+  for(size_t t = 0; t < TexelCount; ++t)
+    for(size_t c = 0; c < Channels; ++c)
+      mean[c] += texels[t * Channels + c];
+  for(auto& m : mean)
+    m /= TexelCount;
+
+  std::array<Color, Channels> covariance{};
+  for(size_t t = 0; t < TexelCount; ++t)
+  {
+    for(size_t i = 0; i < Channels; ++i)
+    {
+      const auto di = texels[t * Channels + i] - mean[i];
+      for(size_t j = 0; j < Channels; ++j)
+        covariance[i][j] += di * (texels[t * Channels + j] - mean[j]);
+    }
+  }
+
+  Color axis{1, 1, 1, 1};
+  for(int iteration = 0; iteration < 8; ++iteration)
+  {
+    Color next{};
+    for(size_t i = 0; i < Channels; ++i)
+      for(size_t j = 0; j < Channels; ++j)
+        next[i] += covariance[i][j] * axis[j];
+
+    float length = 0;
+    for(const auto& n : next)
+      length += n * n;
+    length = std::sqrt(length);
+    if(length < std::numeric_limits<float>::epsilon())
+      break;
+
+    for(size_t i = 0; i < Channels; ++i)
+      axis[i] = next[i] / length;
+  }
+
+  float tMin = std::numeric_limits<float>::max();
+  float tMax = std::numeric_limits<float>::lowest();
+  for(size_t t = 0; t < TexelCount; ++t)
+  {
+    float projected = 0;
+    for(size_t c = 0; c < Channels; ++c)
+      projected += (texels[t * Channels + c] - mean[c]) * axis[c];
+    tMin = std::min(tMin, projected);
+    tMax = std::max(tMax, projected);
+  }
+
+  Color e0{};
+  Color e1{};
+  for(size_t c = 0; c < Channels; ++c)
+  {
+    e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+    e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+  }
+  return {e0, e1};
+}
+
+//! Least-squares fit of the endpoints for fixed indices.
+bool refineEndpoints(const Texels& texels, const Indices& indices, Color& e0, Color& e1)
+{
+  float a00 = 0;
+  float a01 = 0;
+  float a11 = 0;
+  Color b0{};
+  Color b1{};
+  for(size_t t = 0; t < TexelCount; ++t)
+  {
+    const auto w = static_cast<float>(Weights[indices[t]]) / 64.0f;
+    const auto iw = 1.0f - w;
+    a00 += iw * iw;
+    a01 += iw * w;
+    a11 += w * w;
+    for(size_t c = 0; c < Channels; ++c)
+    {
+      b0[c] += iw * texels[t * Channels + c];
+      b1[c] += w * texels[t * Channels + c];
+    }
+  }
+
+  const auto det = a00 * a11 - a01 * a01;
+  if(std::abs(det) < std::numeric_limits<float>::epsilon())
+    return false;
+
+  for(size_t c = 0; c < Channels; ++c)
+  {
+    e0[c] = std::clamp((a11 * b0[c] - a01 * b1[c]) / det, 0.0f, 255.0f);
+    e1[c] = std::clamp((a00 * b1[c] - a01 * b0[c]) / det, 0.0f, 255.0f);
+  }
+  return true;
+}
+} // namespace
+
+Block encodeBlock(const Texels& texels)
+{
+  auto [c0, c1] = principalAxisEndpoints(texels);
+  auto e0 = quantize(c0);
+  auto e1 = quantize(c1);
+  Indices indices{};
+  auto error = findIndices(texels, e0, e1, indices);
+
+  for(int iteration = 0; iteration < 2 && error > 0; ++iteration)
+  {
+    if(!refineEndpoints(texels, indices, c0, c1))
+      break;
+
+    const auto r0 = quantize(c0);
+    const auto r1 = quantize(c1);
+    Indices refinedIndices{};
+    const auto refinedError = findIndices(texels, r0, r1, refinedIndices);
+    if(refinedError >= error)
+      break;
+
+    e0 = r0;
+    e1 = r1;
+    indices = refinedIndices;
+    error = refinedError;
+  }
+
+  // the most significant bit of the first index is implicitly zero
+  if((indices[0] & 8u) != 0)
+  {
+    std::swap(e0, e1);
+    for(auto& index : indices)
+      index = gsl::narrow_cast<uint8_t>(15 - index);
+  }
+
+  Block block{};
+  BitWriter writer{block};
+  writer.write(Mode6, 7);
+  for(size_t c = 0; c < Channels; ++c)
+  {
+    writer.write(e0.quantized[c], 7);
+    writer.write(e1.quantized[c], 7);
+  }
+  writer.write(e0.parity, 1);
+  writer.write(e1.parity, 1);
+  writer.write(indices[0], 3);
+  for(size_t t = 1; t < TexelCount; ++t)
+    writer.write(indices[t], 4);
+
+  return block;
+}
+
+bool decodeBlock(const Block& block, Texels& texels)
+{
+  BitReader reader{block};
+  if(reader.read(7) != Mode6)
+    return false;
+
+  Endpoint e0;
+  Endpoint e1;
+  for(size_t c = 0; c < Channels; ++c)
+  {
+    e0.quantized[c] = gsl::narrow_cast<uint8_t>(reader.read(7));
+    e1.quantized[c] = gsl::narrow_cast<uint8_t>(reader.read(7));
+  }
+  e0.parity = gsl::narrow_cast<uint8_t>(reader.read(1));
+  e1.parity = gsl::narrow_cast<uint8_t>(reader.read(1));
+
+  for(size_t t = 0; t < TexelCount; ++t)
+  {
+    const auto index = gsl::narrow_cast<uint8_t>(reader.read(t == 0 ? 3 : 4));
+    for(size_t c = 0; c < Channels; ++c)
+      texels[t * Channels + c] = interpolate(e0.expand(c), e1.expand(c), index);
+  }
+  return true;
+}
+
+std::vector<uint8_t> encodeImage(const uint8_t* rgba, size_t width, size_t height)
+{
+  gsl_Expects(width % BlockTexels == 0 && height % BlockTexels == 0);
+
+  const auto blocksX = width / BlockTexels;
+  const auto blocksY = height / BlockTexels;
+  std::vector<uint8_t> result(blocksX * blocksY * BlockSize);
+  parallelFor(blocksY,
+              [rgba, width, blocksX, &result](size_t by)
+              {
+                Texels texels{};
+                for(size_t bx = 0; bx < blocksX; ++bx)
+                {
+                  for(size_t y = 0; y < BlockTexels; ++y)
+                  {
+                    const auto* row = rgba + ((by * BlockTexels + y) * width + bx * BlockTexels) * Channels;
+                    std::copy_n(row, BlockTexels * Channels, texels.begin() + y * BlockTexels * Channels);
+                  }
+
+                  const auto block = encodeBlock(texels);
+                  std::copy(block.begin(), block.end(), result.begin() + (by * blocksX + bx) * BlockSize);
+                }
+              });
+  return result;
+}
+} // namespace util::bc7
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util::bc7
+{
+constexpr size_t BlockSize = 16;
+constexpr size_t BlockTexels = 4;
+
+using Block = std::array<uint8_t, BlockSize>;
+//! 4x4 texels, row-major, 4 channels each.
+using Texels = std::array<uint8_t, BlockTexels * BlockTexels * 4>;
+
+/**
+ * Encodes a single block as a BC7 mode 6 block, i.e. a single RGBA subset with 7-bit endpoints, per-endpoint parity
+ * bits, and 4-bit indices.
+ */
+[[nodiscard]] extern Block encodeBlock(const Texels& texels);
+
+/**
+ * Decodes a BC7 mode 6 block.
+ * @return @c false if the block uses any other mode, in which case @p texels are not touched.
+ */
+[[nodiscard]] extern bool decodeBlock(const Block& block, Texels& texels);
+
+/**
+ * Encodes a tightly packed RGBA8 image whose dimensions are multiples of 4, distributing the block rows over the
+ * available hardware threads.
+ *
+ * @return The blocks in row-major order, as expected by compressed texture uploads.
+ */
+[[nodiscard]] extern std::vector<uint8_t> encodeImage(const uint8_t* rgba, size_t width, size_t height);
+} // namespace util::bc7
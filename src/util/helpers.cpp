@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <glm/gtc/type_ptr.hpp>
 #include <gsl/gsl-lite.hpp>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 
@@ -164,15 +165,23 @@ glm::mat4 mix(const glm::mat4& a, const glm::mat4& b, const float bias)
   return result;
 }
 
+namespace
+{
+RandomStream& getProcessStream()
+{
+  static RandomStream stream{std::random_device{}()};
+  return stream;
+}
+} // namespace
+
 int16_t rand15s()
 {
-  return static_cast<int16_t>(rand15() - Rand15Max / 2);
+  return getProcessStream().rand15s();
 }
 
 int16_t rand15()
 {
-  // NOLINTNEXTLINE(cert-msc50-cpp, concurrency-mt-unsafe)
-  return gsl::narrow_cast<int16_t>(std::rand() % Rand15Max);
+  return getProcessStream().rand15();
 }
 
 std::string toTimeStr(const core::Seconds& t)
@@ -4,6 +4,7 @@
 #include "core/units.h"
 #include "core/vec.h"
 #include "qs/qs.h"
+#include "random.h"
 
 #include <chrono>
 #include <cstdint>
@@ -20,10 +21,10 @@ constexpr auto square(T value)
   return value * value;
 }
 
-constexpr int Rand15Max = 1u << 15u;
-
 /**
- * Random number in range 0..32767.
+ * Random number in range 0..32767 from a process-wide, non-reproducible stream.
+ *
+ * @note Anything affecting the simulation must draw from the world's RandomStreams instead.
  */
 extern int16_t rand15();
 
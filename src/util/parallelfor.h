@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+/**
+ * Calls @p f for every index in [0, n), distributed over the available hardware threads.
+ *
+ * The calling thread takes part in the work. If any call throws, the remaining indices are skipped, and the first
+ * exception is re-thrown after all threads have finished.
+ */
+template<typename F>
+void parallelFor(size_t n, F&& f)
+{
+  const auto threadCount = std::min(static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)), n);
+  if(threadCount <= 1)
+  {
+    for(size_t i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  const auto worker = [n, &f, &next, &error, &errorMutex]()
+  {
+    for(size_t i = next++; i < n; i = next++)
+    {
+      try
+      {
+        f(i);
+      }
+      catch(...)
+      {
+        std::lock_guard lock{errorMutex};
+        if(error == nullptr)
+          error = std::current_exception();
+        next = n;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for(size_t i = 1; i < threadCount; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for(auto& thread : threads)
+    thread.join();
+
+  if(error != nullptr)
+    std::rethrow_exception(error);
+}
+} // namespace util
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "qs/quantity.h"
+#include "serialization/serialization_fwd.h"
+
+#include <cstdint>
+
+namespace util
+{
+constexpr int Rand15Max = 1u << 15u;
+
+/**
+ * A seedable PCG32 random number stream.
+ *
+ * Unlike std::rand(), its whole state is explicit, so it can be stored in savegames, and two streams with the same
+ * seed produce the same numbers on every platform.
+ */
+class RandomStream final
+{
+public:
+  explicit RandomStream(uint64_t seed = 0, uint64_t stream = 0) noexcept
+  {
+    this->seed(seed, stream);
+  }
+
+  void seed(uint64_t seed, uint64_t stream) noexcept
+  {
+    m_state = 0;
+    m_increment = (stream << 1u) | 1u;
+    (void)next();
+    m_state += seed;
+    (void)next();
+  }
+
+  [[nodiscard]] uint32_t next() noexcept
+  {
+    const auto old = m_state;
+    m_state = old * 6364136223846793005ull + m_increment;
+    const auto xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    const auto rotation = static_cast<uint32_t>(old >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+  }
+
+  /**
+   * Random number in range 0..32767.
+   */
+  [[nodiscard]] int16_t rand15() noexcept
+  {
+    return static_cast<int16_t>(next() >> 17u);
+  }
+
+  template<typename T>
+  [[nodiscard]] T rand15(T max) noexcept
+  {
+    return static_cast<T>(static_cast<float>(max) * static_cast<float>(rand15()) / static_cast<float>(Rand15Max));
+  }
+
+  template<typename T, typename U>
+  [[nodiscard]] auto rand15(qs::quantity<T, U> max) noexcept
+  {
+    return (max.template cast<float>() * static_cast<float>(rand15()) / static_cast<float>(Rand15Max))
+      .template cast<U>();
+  }
+
+  /**
+   * Random number in range -16384..16383.
+   */
+  [[nodiscard]] int16_t rand15s() noexcept
+  {
+    return static_cast<int16_t>(rand15() - Rand15Max / 2);
+  }
+
+  /**
+   * Random number in range -max/2..max/2
+   */
+  template<typename T, typename U>
+  [[nodiscard]] auto rand15s(qs::quantity<T, U> max) noexcept
+  {
+    return (max.template cast<float>() * static_cast<float>(rand15s()) / static_cast<float>(Rand15Max))
+      .template cast<U>();
+  }
+
+  template<typename T>
+  [[nodiscard]] T rand15s(T max) noexcept
+  {
+    return static_cast<T>(static_cast<float>(max) * static_cast<float>(rand15s()) / static_cast<float>(Rand15Max));
+  }
+
+  template<typename TContext>
+  void serialize(const serialization::Serializer<TContext>& ser)
+  {
+    ser(S_NV("state", m_state), S_NV("increment", m_increment));
+  }
+
+private:
+  uint64_t m_state = 0;
+  uint64_t m_increment = 0;
+};
+} // namespace util
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <vector>
+
+namespace util
+{
+/**
+ * A set of spheres stored as a structure of arrays, so that ray intersection tests can be vectorized.
+ */
+class SphereSet final
+{
+public:
+  struct Hit
+  {
+    size_t index;
+    float distance;
+  };
+
+  void clear()
+  {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_radiusSq.clear();
+  }
+
+  void reserve(size_t n)
+  {
+    m_x.reserve(n);
+    m_y.reserve(n);
+    m_z.reserve(n);
+    m_radiusSq.reserve(n);
+    m_b.reserve(n);
+    m_discriminants.reserve(n);
+  }
+
+  void add(const glm::vec3& center, float radiusSq)
+  {
+    m_x.emplace_back(center.x);
+    m_y.emplace_back(center.y);
+    m_z.emplace_back(center.z);
+    m_radiusSq.emplace_back(radiusSq);
+  }
+
+  [[nodiscard]] size_t size() const noexcept
+  {
+    return m_x.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return m_x.empty();
+  }
+
+  /**
+   * Finds the sphere whose front intersection with the ray is nearest to the ray's origin.
+   *
+   * The results are identical to testing the spheres one after another with
+   * https://viclw17.github.io/2018/07/16/raytracing-ray-sphere-intersection/ and keeping the first hit and every
+   * later hit that is not farther away, i.e. on ties the last sphere wins. Distances may be negative if the origin
+   * is within or in front of a sphere.
+   */
+  [[nodiscard]] std::optional<Hit> nearestHit(const glm::vec3& origin, const glm::vec3& dir) const
+  {
+    const auto n = size();
+    m_b.resize(n);
+    m_discriminants.resize(n);
+
+    // local copies, so that the compiler knows they're not aliased by the arrays
+    const auto originX = origin.x;
+    const auto originY = origin.y;
+    const auto originZ = origin.z;
+    const auto dirX = dir.x;
+    const auto dirY = dir.y;
+    const auto dirZ = dir.z;
+    // branch-free pass over all spheres, the operations are evaluated in exactly the same order as in the sequential
+    // test to produce identical results
+    for(size_t i = 0; i < n; ++i)
+    {
+      const auto ocX = originX - m_x[i];
+      const auto ocY = originY - m_y[i];
+      const auto ocZ = originZ - m_z[i];
+      const auto b = (ocX * dirX + ocY * dirY + ocZ * dirZ) * 2;
+      const auto c = (ocX * ocX + ocY * ocY + ocZ * ocZ) - m_radiusSq[i];
+      m_b[i] = b;
+      m_discriminants[i] = b * b - 4 * c;
+    }
+
+    std::optional<Hit> best;
+    for(size_t i = 0; i < n; ++i)
+    {
+      if(m_discriminants[i] < 0)
+        continue;
+
+      const auto t = (-m_b[i] - std::sqrt(m_discriminants[i])) / 2;
+      if(best.has_value() && t > best->distance)
+        continue;
+
+      best = Hit{i, t};
+    }
+    return best;
+  }
+
+private:
+  std::vector<float> m_x{};
+  std::vector<float> m_y{};
+  std::vector<float> m_z{};
+  std::vector<float> m_radiusSq{};
+  // scratch buffers, kept to avoid allocations per query
+  mutable std::vector<float> m_b{};
+  mutable std::vector<float> m_discriminants{};
+};
+} // namespace util
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <gsl/gsl-lite.hpp>
+
+namespace util
+{
+/**
+ * Scales the render resolution so that frames fit into a time budget.
+ *
+ * Frame times are averaged over windows of frames. If a window exceeds the budget, the scale is lowered by one step.
+ * As frame times are capped by vsync, a window within the budget can't tell how much headroom there is, so the scale
+ * is raised by one step after a number of windows within the budget to probe for it. If such a probe exceeds the
+ * budget, the scale is lowered again, and the delay until the next probe is doubled so that the scale doesn't keep
+ * oscillating between two steps.
+ */
+class ResolutionController final
+{
+public:
+  using Duration = std::chrono::microseconds;
+
+  //! Assumed if the refresh rate of the display is unknown.
+  static constexpr int DefaultRefreshRate = 60;
+
+  //! The duration of a frame at @p refreshRate Hz, falling back to the default refresh rate if it is not positive.
+  [[nodiscard]] static constexpr Duration getFrameBudget(int refreshRate)
+  {
+    if(refreshRate <= 0)
+      refreshRate = DefaultRefreshRate;
+    return std::chrono::duration_cast<Duration>(std::chrono::seconds{1}) / refreshRate;
+  }
+
+  struct Config
+  {
+    //! Should match the refresh rate of the display, as the measured frame times include waiting for vsync.
+    Duration budget{getFrameBudget(DefaultRefreshRate)};
+    //! Fraction by which the average frame time may exceed the budget.
+    float tolerance = 0.1f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float step = 0.125f;
+    //! Number of frames averaged for a decision.
+    size_t window = 30;
+    //! Number of windows within the budget before the scale is raised.
+    size_t probeDelay = 4;
+    size_t maxProbeDelay = 64;
+    //! Number of frames discarded after a scale change, as they contain the cost of reallocating the render targets.
+    size_t settleFrames = 2;
+  };
+
+  explicit ResolutionController(const Config& config)
+  {
+    configure(config);
+  }
+
+  //! Replaces the configuration, and resets to the maximum scale.
+  void configure(const Config& config)
+  {
+    gsl_Expects(config.minScale > 0 && config.minScale <= config.maxScale);
+    gsl_Expects(config.step > 0);
+    gsl_Expects(config.window > 0);
+    gsl_Expects(config.probeDelay > 0 && config.probeDelay <= config.maxProbeDelay);
+
+    m_config = config;
+    m_maxLevel = static_cast<size_t>(std::ceil((config.maxScale - config.minScale) / config.step - 0.001f));
+    reset();
+  }
+
+  void reset()
+  {
+    m_level = 0;
+    m_probeDelay = m_config.probeDelay;
+    m_windowsInBudget = 0;
+    m_probing = false;
+    restartWindow();
+  }
+
+  //! Feeds the duration of a frame, and returns true if the scale changed.
+  bool update(const Duration& frameTime)
+  {
+    if(m_settleFrames > 0)
+    {
+      --m_settleFrames;
+      return false;
+    }
+
+    m_total += frameTime;
+    if(++m_frames < m_config.window)
+      return false;
+
+    const auto average = static_cast<float>(m_total.count()) / static_cast<float>(m_frames);
+    restartWindow();
+
+    if(average > static_cast<float>(m_config.budget.count()) * (1 + m_config.tolerance))
+    {
+      if(m_probing)
+        m_probeDelay = std::min(2 * m_probeDelay, m_config.maxProbeDelay);
+      m_probing = false;
+      m_windowsInBudget = 0;
+      return setLevel(m_level + 1);
+    }
+
+    if(m_probing)
+    {
+      m_probing = false;
+      m_probeDelay = m_config.probeDelay;
+    }
+
+    if(++m_windowsInBudget < m_probeDelay || m_level == 0)
+      return false;
+
+    m_windowsInBudget = 0;
+    m_probing = true;
+    return setLevel(m_level - 1);
+  }
+
+  [[nodiscard]] float getScale() const
+  {
+    return std::max(m_config.maxScale - static_cast<float>(m_level) * m_config.step, m_config.minScale);
+  }
+
+  [[nodiscard]] const auto& getConfig() const
+  {
+    return m_config;
+  }
+
+private:
+  Config m_config;
+  size_t m_maxLevel = 0;
+  //! Number of steps below the maximum scale.
+  size_t m_level = 0;
+  size_t m_probeDelay = 0;
+  size_t m_windowsInBudget = 0;
+  bool m_probing = false;
+  Duration m_total = Duration::zero();
+  size_t m_frames = 0;
+  size_t m_settleFrames = 0;
+
+  void restartWindow()
+  {
+    m_total = Duration::zero();
+    m_frames = 0;
+  }
+
+  bool setLevel(size_t level)
+  {
+    level = std::min(level, m_maxLevel);
+    if(level == m_level)
+      return false;
+
+    m_level = level;
+    m_settleFrames = m_config.settleFrames;
+    return true;
+  }
+};
+} // namespace util
@@ -1,8 +1,27 @@
 #define BOOST_TEST_MODULE util
 
+#include "bc7.h"
+#include "parallelfor.h"
+#include "random.h"
+#include "raysphere.h"
+#include "resolutioncontroller.h"
 #include "smallcollections.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(util_tests)
 
@@ -114,4 +133,403 @@ BOOST_AUTO_TEST_CASE(test_contains)
   BOOST_CHECK(util::contains(values, 456));
   BOOST_REQUIRE_EQUAL(values.size(), 1);
 }
+
+namespace
+{
+// reference implementation, sequentially testing all spheres
+std::optional<std::pair<size_t, float>> nearestRaySphereHit(const std::vector<std::pair<glm::vec3, float>>& spheres,
+                                                            const glm::vec3& origin,
+                                                            const glm::vec3& dir)
+{
+  std::optional<std::pair<size_t, float>> best;
+  for(size_t i = 0; i < spheres.size(); ++i)
+  {
+    const auto oc = origin - spheres[i].first;
+    const auto b = glm::dot(oc, dir) * 2;
+    const auto c = glm::dot(oc, oc) - spheres[i].second;
+    const auto discriminant = b * b - 4 * c;
+    if(discriminant < 0)
+      continue;
+
+    const auto t = (-b - std::sqrt(discriminant)) / 2;
+    if(best.has_value() && t > best->second)
+      continue;
+
+    best = std::pair{i, t};
+  }
+  return best;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sphere_set_nearest_hit)
+{
+  util::SphereSet set;
+  BOOST_CHECK(!set.nearestHit({0, 0, 0}, {0, 0, 1}).has_value());
+
+  set.add({0, 0, 100}, 10 * 10);
+  set.add({0, 0, 50}, 10 * 10);
+  set.add({0, 100, 50}, 10 * 10);
+  auto hit = set.nearestHit({0, 0, 0}, {0, 0, 1});
+  BOOST_REQUIRE(hit.has_value());
+  BOOST_CHECK_EQUAL(hit->index, 1);
+  BOOST_CHECK_EQUAL(hit->distance, 40.0f);
+
+  // on ties, the last sphere wins
+  set.add({0, 0, 50}, 10 * 10);
+  hit = set.nearestHit({0, 0, 0}, {0, 0, 1});
+  BOOST_REQUIRE(hit.has_value());
+  BOOST_CHECK_EQUAL(hit->index, 3);
+
+  BOOST_CHECK(!set.nearestHit({0, 0, 0}, {1, 0, 0}).has_value());
+
+  set.clear();
+  BOOST_CHECK(set.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_sphere_set_matches_sequential_test)
+{
+  std::mt19937 rng{12345}; // NOLINT(cert-msc32-c, cert-msc51-cpp)
+  std::uniform_real_distribution<float> coordinate{-4096.0f, 4096.0f};
+  std::uniform_int_distribution<int> radius{16, 1024};
+
+  for(int round = 0; round < 1000; ++round)
+  {
+    std::vector<std::pair<glm::vec3, float>> spheres;
+    util::SphereSet set;
+    const auto n = static_cast<size_t>(round % 23);
+    for(size_t i = 0; i < n; ++i)
+    {
+      const glm::vec3 center{coordinate(rng), coordinate(rng), coordinate(rng)};
+      const auto radiusSq = static_cast<float>(radius(rng) * radius(rng));
+      spheres.emplace_back(center, radiusSq);
+      set.add(center, radiusSq);
+    }
+
+    const glm::vec3 origin{coordinate(rng), coordinate(rng), coordinate(rng)};
+    for(const auto& [center, radiusSq] : spheres)
+    {
+      // aim at each sphere to get enough hits
+      const auto dir = glm::normalize(center - origin);
+      const auto expected = nearestRaySphereHit(spheres, origin, dir);
+      const auto actual = set.nearestHit(origin, dir);
+      BOOST_REQUIRE_EQUAL(expected.has_value(), actual.has_value());
+      BOOST_CHECK_EQUAL(expected->first, actual->index);
+      BOOST_CHECK_EQUAL(expected->second, actual->distance);
+    }
+
+    const auto dir = glm::normalize(glm::vec3{coordinate(rng), coordinate(rng), coordinate(rng)});
+    const auto expected = nearestRaySphereHit(spheres, origin, dir);
+    const auto actual = set.nearestHit(origin, dir);
+    BOOST_REQUIRE_EQUAL(expected.has_value(), actual.has_value());
+    if(expected.has_value())
+    {
+      BOOST_CHECK_EQUAL(expected->first, actual->index);
+      BOOST_CHECK_EQUAL(expected->second, actual->distance);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_visits_each_index_once)
+{
+  util::parallelFor(0,
+                    [](size_t)
+                    {
+                      BOOST_FAIL("must not be called");
+                    });
+
+  std::vector<std::atomic<int>> visits(1000);
+  util::parallelFor(visits.size(),
+                    [&visits](size_t i)
+                    {
+                      ++visits[i];
+                    });
+  for(const auto& visit : visits)
+    BOOST_CHECK_EQUAL(visit.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_rethrows)
+{
+  BOOST_CHECK_THROW(util::parallelFor(100,
+                                      [](size_t i)
+                                      {
+                                        if(i == 42)
+                                          throw std::runtime_error{"failure"};
+                                      }),
+                    std::runtime_error);
+}
+
+namespace
+{
+struct Bc7KnownAnswer
+{
+  util::bc7::Block block;
+  util::bc7::Texels texels;
+};
+
+// mode 6 blocks and their texels as decoded by Pillow's BCn decoder, which implements all BC7 modes independently
+// of the encoder
+constexpr std::array<Bc7KnownAnswer, 3> Bc7KnownAnswers{{
+  // random endpoints and indices, parity bits 1 and 0
+  {{{0xc0, 0x5d, 0x9b, 0x66, 0xd1, 0x87, 0x7d, 0xff, 0xb4, 0xd4, 0x6f, 0x9e, 0xa9, 0x26, 0x69, 0xef}},
+   {{
+     133, 96, 238, 143, 192, 60, 208, 220, 145, 89, 231, 159, 204, 53, 201, 236,
+     218, 44, 194, 254, 159, 80, 224, 177, 212, 48, 197, 246, 178, 69, 215, 202,
+     178, 69, 215, 202, 186, 64, 211, 212, 159, 80, 224, 177, 133, 96, 238, 143,
+     178, 69, 215, 202, 159, 80, 224, 177, 218, 44, 194, 254, 212, 48, 197, 246,
+   }}},
+  // random endpoints and indices, parity bits 0 and 1
+  {{{0x40, 0x6c, 0xd2, 0x1d, 0xb2, 0xd5, 0xee, 0x3f, 0x47, 0xa7, 0xc7, 0xa9, 0xb0, 0x66, 0xa6, 0xda}},
+   {{
+     170, 189, 108, 215, 168, 179, 108, 209, 162, 148, 108, 186, 157, 117, 107, 163,
+     162, 148, 108, 186, 153, 98, 107, 150, 159, 129, 107, 172, 157, 117, 107, 163,
+     176, 220, 108, 238, 155, 108, 107, 156, 164, 158, 108, 193, 164, 158, 108, 193,
+     164, 158, 108, 193, 157, 117, 107, 163, 157, 117, 107, 163, 151, 89, 107, 143,
+   }}},
+  // every index once, including the largest anchor index
+  {{{0x40, 0x05, 0x9e, 0x42, 0xf6, 0x40, 0x51, 0x7f, 0xff, 0xde, 0xbc, 0x9a, 0x68, 0x34, 0x12, 0x50}},
+   {{
+     124, 115, 107, 162, 241, 201, 161, 255, 227, 191, 155, 244, 210, 178, 147, 230,
+     196, 168, 140, 219, 182, 158, 134, 209, 168, 148, 128, 198, 151, 136, 120, 184,
+     137, 126, 114, 173, 110, 105, 101, 151, 79, 83, 87, 126, 65, 73, 81, 116,
+     51, 63, 74, 105, 34, 50, 66, 91, 20, 40, 60, 80, 93, 93, 93, 137,
+   }}},
+}};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_bc7_decode_known_answers)
+{
+  for(const auto& knownAnswer : Bc7KnownAnswers)
+  {
+    util::bc7::Texels decoded{};
+    BOOST_REQUIRE(util::bc7::decodeBlock(knownAnswer.block, decoded));
+    BOOST_CHECK_EQUAL_COLLECTIONS(decoded.begin(), decoded.end(), knownAnswer.texels.begin(), knownAnswer.texels.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_bc7_encode_known_answers)
+{
+  // the texels are exactly representable in mode 6, and the decoder is verified against them above
+  for(const auto& knownAnswer : Bc7KnownAnswers)
+  {
+    util::bc7::Texels decoded{};
+    BOOST_REQUIRE(util::bc7::decodeBlock(util::bc7::encodeBlock(knownAnswer.texels), decoded));
+    for(size_t i = 0; i < decoded.size(); ++i)
+      BOOST_CHECK_LE(std::abs(decoded[i] - knownAnswer.texels[i]), 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_bc7_solid_block_is_lossless)
+{
+  util::bc7::Texels texels{};
+  for(size_t i = 0; i < texels.size(); i += 4)
+  {
+    texels[i + 0] = 12;
+    texels[i + 1] = 200;
+    texels[i + 2] = 77;
+    texels[i + 3] = 255;
+  }
+
+  util::bc7::Texels decoded{};
+  BOOST_REQUIRE(util::bc7::decodeBlock(util::bc7::encodeBlock(texels), decoded));
+  for(size_t i = 0; i < texels.size(); ++i)
+    BOOST_CHECK_LE(std::abs(decoded[i] - texels[i]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_bc7_block_error_is_bounded)
+{
+  std::mt19937 rng{1234};
+  std::uniform_int_distribution<int> channel{0, 255};
+  std::uniform_int_distribution<int> noise{-8, 8};
+
+  for(int iteration = 0; iteration < 100; ++iteration)
+  {
+    // a noisy gradient between two random colors, similar to typical texture content
+    std::array<int, 4> from{channel(rng), channel(rng), channel(rng), channel(rng)};
+    std::array<int, 4> to{channel(rng), channel(rng), channel(rng), channel(rng)};
+    util::bc7::Texels texels{};
+    for(size_t t = 0; t < 16; ++t)
+    {
+      for(size_t c = 0; c < 4; ++c)
+      {
+        const auto value = from[c] + (to[c] - from[c]) * static_cast<int>(t) / 15 + noise(rng);
+        texels[t * 4 + c] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+      }
+    }
+
+    util::bc7::Texels decoded{};
+    BOOST_REQUIRE(util::bc7::decodeBlock(util::bc7::encodeBlock(texels), decoded));
+    double squaredError = 0;
+    for(size_t i = 0; i < texels.size(); ++i)
+    {
+      const auto delta = static_cast<double>(decoded[i]) - texels[i];
+      squaredError += delta * delta;
+    }
+    BOOST_CHECK_LT(std::sqrt(squaredError / texels.size()), 8.0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_bc7_image_block_order)
+{
+  // 8x8 image with a different solid color in each 4x4 quadrant
+  static constexpr std::array<std::array<uint8_t, 4>, 4> colors{{
+    {255, 0, 0, 255},
+    {0, 255, 0, 255},
+    {0, 0, 255, 255},
+    {255, 255, 255, 0},
+  }};
+  std::vector<uint8_t> image(8 * 8 * 4);
+  for(size_t y = 0; y < 8; ++y)
+    for(size_t x = 0; x < 8; ++x)
+      std::copy_n(colors[(y / 4) * 2 + x / 4].begin(), 4, image.begin() + (y * 8 + x) * 4);
+
+  const auto blocks = util::bc7::encodeImage(image.data(), 8, 8);
+  BOOST_REQUIRE_EQUAL(blocks.size(), 4 * util::bc7::BlockSize);
+  for(size_t i = 0; i < 4; ++i)
+  {
+    util::bc7::Block block{};
+    std::copy_n(blocks.begin() + i * util::bc7::BlockSize, util::bc7::BlockSize, block.begin());
+    util::bc7::Texels decoded{};
+    BOOST_REQUIRE(util::bc7::decodeBlock(block, decoded));
+    for(size_t c = 0; c < 4; ++c)
+      BOOST_CHECK_LE(std::abs(decoded[c] - colors[i][c]), 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_bc7_decode_rejects_other_modes)
+{
+  util::bc7::Block block{};
+  block[0] = 1; // mode 0
+  util::bc7::Texels decoded{};
+  BOOST_CHECK(!util::bc7::decodeBlock(block, decoded));
+}
+
+BOOST_AUTO_TEST_CASE(test_random_stream_is_reproducible)
+{
+  util::RandomStream a{1234, 1};
+  util::RandomStream b{1234, 1};
+  util::RandomStream otherStream{1234, 2};
+  util::RandomStream otherSeed{4321, 1};
+
+  size_t otherStreamMatches = 0;
+  size_t otherSeedMatches = 0;
+  for(int i = 0; i < 1000; ++i)
+  {
+    const auto value = a.next();
+    BOOST_REQUIRE_EQUAL(value, b.next());
+    if(value == otherStream.next())
+      ++otherStreamMatches;
+    if(value == otherSeed.next())
+      ++otherSeedMatches;
+  }
+  BOOST_CHECK_LT(otherStreamMatches, 5);
+  BOOST_CHECK_LT(otherSeedMatches, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_random_stream_ranges)
+{
+  util::RandomStream stream{42};
+  for(int i = 0; i < 10000; ++i)
+  {
+    const auto value = stream.rand15();
+    BOOST_REQUIRE_GE(value, 0);
+    BOOST_REQUIRE_LT(value, util::Rand15Max);
+
+    const auto signedValue = stream.rand15s();
+    BOOST_REQUIRE_GE(signedValue, -util::Rand15Max / 2);
+    BOOST_REQUIRE_LT(signedValue, util::Rand15Max / 2);
+
+    const auto scaled = stream.rand15(100);
+    BOOST_REQUIRE_GE(scaled, 0);
+    BOOST_REQUIRE_LT(scaled, 100);
+  }
+}
+
+namespace
+{
+//! Feeds whole windows of frames with the same duration, returns the number of scale changes.
+size_t feedWindows(util::ResolutionController& controller, size_t windows, std::chrono::microseconds frameTime)
+{
+  size_t changes = 0;
+  const auto frames = windows * controller.getConfig().window;
+  for(size_t i = 0; i < frames; ++i)
+  {
+    if(controller.update(frameTime))
+    {
+      ++changes;
+      // discard the settle frames, so that the next window starts at a window boundary
+      for(size_t j = 0; j < controller.getConfig().settleFrames; ++j)
+        BOOST_REQUIRE(!controller.update(frameTime));
+    }
+  }
+  return changes;
+}
+
+util::ResolutionController::Config testConfig()
+{
+  util::ResolutionController::Config config;
+  config.budget = std::chrono::microseconds{10000};
+  config.minScale = 0.5f;
+  config.maxScale = 1.0f;
+  config.step = 0.25f;
+  config.window = 10;
+  config.probeDelay = 2;
+  config.maxProbeDelay = 8;
+  return config;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_resolution_controller_lowers_scale_down_to_minimum)
+{
+  util::ResolutionController controller{testConfig()};
+  BOOST_CHECK_EQUAL(controller.getScale(), 1.0f);
+
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10500}), 0);
+  BOOST_CHECK_EQUAL(controller.getScale(), 1.0f);
+
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{20000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 0.75f);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 5, std::chrono::microseconds{20000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolution_controller_keeps_scale_at_refresh_rate)
+{
+  BOOST_CHECK_EQUAL(util::ResolutionController::getFrameBudget(50).count(), 20000);
+  BOOST_CHECK_EQUAL(util::ResolutionController::getFrameBudget(0).count(),
+                    util::ResolutionController::getFrameBudget(util::ResolutionController::DefaultRefreshRate).count());
+
+  // frames blocked by vsync on a 50 Hz display take exactly as long as the budget
+  auto config = testConfig();
+  config.budget = util::ResolutionController::getFrameBudget(50);
+  util::ResolutionController controller{config};
+  BOOST_CHECK_EQUAL(feedWindows(controller, 50, std::chrono::microseconds{20000}), 0);
+  BOOST_CHECK_EQUAL(controller.getScale(), 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_resolution_controller_probes_for_headroom)
+{
+  util::ResolutionController controller{testConfig()};
+  BOOST_REQUIRE_EQUAL(feedWindows(controller, 2, std::chrono::microseconds{20000}), 2);
+  BOOST_REQUIRE_EQUAL(controller.getScale(), 0.5f);
+
+  // the scale is raised after probeDelay windows within the budget
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10000}), 0);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 0.75f);
+
+  // the probe exceeds the budget, so the scale is lowered again and the next probe is delayed twice as long
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{20000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 0.5f);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 3, std::chrono::microseconds{10000}), 0);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 0.75f);
+
+  // a successful probe resets the delay
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10000}), 0);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 1, std::chrono::microseconds{10000}), 1);
+  BOOST_CHECK_EQUAL(controller.getScale(), 1.0f);
+  BOOST_CHECK_EQUAL(feedWindows(controller, 10, std::chrono::microseconds{10000}), 0);
+  BOOST_CHECK_EQUAL(controller.getScale(), 1.0f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()